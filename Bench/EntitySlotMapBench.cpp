@@ -0,0 +1,165 @@
+#include "ECS/AdEntitySlotMap.h"
+#include "ECS/AdEntity.h"
+#include "ECS/AdScene.h"
+#include "Adlog.h"
+
+#define ENTITY_BENCH_COUNT                  1000000
+
+using namespace WuDu;
+
+static double ElapsedMs(std::chrono::steady_clock::time_point startTime) {
+	return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+}
+
+/**
+ * @brief 容器层面：AdEntitySlotMap 与原先 AdScene 使用的 unordered_map<entt::entity, shared_ptr<AdEntity>> 对比
+ *
+ * 同一批 entt 标识依次创建、查询、销毁；销毁后在 entt 中复用索引再创建一批，
+ * 检查旧标识查不到对象、新标识能查到，即槽位的版本检查。
+ */
+static bool RunContainerBench() {
+	entt::registry registry;
+	std::vector<entt::entity> enttEntities(ENTITY_BENCH_COUNT);
+	registry.create(enttEntities.begin(), enttEntities.end());
+	bool bPassed = true;
+
+	{
+		std::unordered_map<entt::entity, std::shared_ptr<AdEntity>> entities;
+		auto startTime = std::chrono::steady_clock::now();
+		for (entt::entity enttEntity : enttEntities) {
+			entities.insert({ enttEntity, std::make_shared<AdEntity>(enttEntity, nullptr) });
+		}
+		double createMs = ElapsedMs(startTime);
+
+		startTime = std::chrono::steady_clock::now();
+		size_t found = 0;
+		for (entt::entity enttEntity : enttEntities) {
+			auto it = entities.find(enttEntity);
+			found += it != entities.end() && it->second->GetEcsEntity() == enttEntity;
+		}
+		double getMs = ElapsedMs(startTime);
+
+		startTime = std::chrono::steady_clock::now();
+		for (entt::entity enttEntity : enttEntities) {
+			entities.erase(enttEntity);
+		}
+		double destroyMs = ElapsedMs(startTime);
+		bPassed &= found == ENTITY_BENCH_COUNT && entities.empty();
+		LOG_I("unordered_map    {0} entities: create {1:8.2f} ms, get {2:8.2f} ms, destroy {3:8.2f} ms",
+			ENTITY_BENCH_COUNT, createMs, getMs, destroyMs);
+	}
+
+	{
+		AdEntitySlotMap entities;
+		std::vector<AdEntity*> created(enttEntities.size());
+		auto startTime = std::chrono::steady_clock::now();
+		for (size_t i = 0; i < enttEntities.size(); i++) {
+			created[i] = entities.Emplace(enttEntities[i], nullptr);
+		}
+		double createMs = ElapsedMs(startTime);
+
+		startTime = std::chrono::steady_clock::now();
+		size_t found = 0;
+		for (size_t i = 0; i < enttEntities.size(); i++) {
+			AdEntity* entity = entities.Get(enttEntities[i]);
+			found += entity && entity == created[i] && entity->GetEcsEntity() == enttEntities[i];
+		}
+		double getMs = ElapsedMs(startTime);
+
+		startTime = std::chrono::steady_clock::now();
+		for (entt::entity enttEntity : enttEntities) {
+			entities.Erase(enttEntity);
+		}
+		double destroyMs = ElapsedMs(startTime);
+		bPassed &= found == ENTITY_BENCH_COUNT && entities.GetSize() == 0;
+		LOG_I("AdEntitySlotMap  {0} entities: create {1:8.2f} ms, get {2:8.2f} ms, destroy {3:8.2f} ms",
+			ENTITY_BENCH_COUNT, createMs, getMs, destroyMs);
+
+		// entt 复用已销毁的索引并提升版本，旧标识必须查不到新对象
+		registry.destroy(enttEntities.begin(), enttEntities.end());
+		std::vector<entt::entity> reused(ENTITY_BENCH_COUNT);
+		registry.create(reused.begin(), reused.end());
+		startTime = std::chrono::steady_clock::now();
+		for (entt::entity enttEntity : reused) {
+			entities.Emplace(enttEntity, nullptr);
+		}
+		double reuseMs = ElapsedMs(startTime);
+		size_t stale = 0;
+		size_t live = 0;
+		for (size_t i = 0; i < enttEntities.size(); i++) {
+			stale += entities.Get(enttEntities[i]) != nullptr;
+			live += entities.Get(reused[i]) != nullptr;
+		}
+		bool bVersionChecked = stale == 0 && live == ENTITY_BENCH_COUNT;
+		bPassed &= bVersionChecked && entities.GetPageCount() == (ENTITY_BENCH_COUNT + AD_ENTITY_SLOT_PAGE_SIZE - 1) / AD_ENTITY_SLOT_PAGE_SIZE;
+		LOG_I("AdEntitySlotMap  {0} entities: re-create on reused slots {1:8.2f} ms, stale handles resolved {2}",
+			ENTITY_BENCH_COUNT, reuseMs, stale);
+	}
+	return bPassed;
+}
+
+/**
+ * @brief 场景层面：逐个 CreateEntity/DestroyEntity 与批量 CreateEntities/DestroyEntities
+ *
+ * 包含 UUID 生成、节点挂接与默认变换组件，即实际创建实体的全部开销。
+ */
+static bool RunSceneBench() {
+	bool bPassed = true;
+	AdScene scene;
+
+	std::vector<AdEntity*> entities(ENTITY_BENCH_COUNT);
+	auto startTime = std::chrono::steady_clock::now();
+	for (uint32_t i = 0; i < ENTITY_BENCH_COUNT; i++) {
+		entities[i] = scene.CreateEntity();
+	}
+	double createMs = ElapsedMs(startTime);
+
+	std::vector<entt::entity> enttEntities(ENTITY_BENCH_COUNT);
+	size_t found = 0;
+	for (uint32_t i = 0; i < ENTITY_BENCH_COUNT; i++) {
+		enttEntities[i] = entities[i]->GetEcsEntity();
+		found += scene.GetEntity(enttEntities[i]) == entities[i];
+	}
+	bPassed &= found == ENTITY_BENCH_COUNT && scene.GetRootNode()->GetChildCount() == ENTITY_BENCH_COUNT;
+
+	startTime = std::chrono::steady_clock::now();
+	for (AdEntity* entity : entities) {
+		scene.DestroyEntity(entity);
+	}
+	double destroyMs = ElapsedMs(startTime);
+	size_t stale = 0;
+	for (entt::entity enttEntity : enttEntities) {
+		stale += scene.GetEntity(enttEntity) != nullptr;
+	}
+	bPassed &= stale == 0 && scene.GetRootNode()->GetChildCount() == 0;
+	LOG_I("AdScene          {0} entities: CreateEntity {1:8.2f} ms, DestroyEntity {2:8.2f} ms",
+		ENTITY_BENCH_COUNT, createMs, destroyMs);
+
+	startTime = std::chrono::steady_clock::now();
+	entities = scene.CreateEntities(ENTITY_BENCH_COUNT);
+	createMs = ElapsedMs(startTime);
+	found = 0;
+	for (AdEntity* entity : entities) {
+		found += entity && scene.GetEntity(entity->GetEcsEntity()) == entity;
+	}
+	bPassed &= found == ENTITY_BENCH_COUNT;
+
+	startTime = std::chrono::steady_clock::now();
+	scene.DestroyEntities(entities);
+	destroyMs = ElapsedMs(startTime);
+	bPassed &= scene.GetRootNode()->GetChildCount() == 0;
+	LOG_I("AdScene          {0} entities: CreateEntities {1:8.2f} ms, DestroyEntities {2:8.2f} ms",
+		ENTITY_BENCH_COUNT, createMs, destroyMs);
+	return bPassed;
+}
+
+int main(int argc, char* argv[]) {
+	Adlog::Init();
+
+	bool bPassed = RunContainerBench();
+	bPassed &= RunSceneBench();
+	if (!bPassed) {
+		LOG_E("Entity slot map check failed");
+	}
+	return bPassed ? 0 : 1;
+}
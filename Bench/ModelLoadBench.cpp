@@ -0,0 +1,91 @@
+#include "Resource/AdModelLoader.h"
+#include "AdFileUtil.h"
+#include "AdThreadPool.h"
+#include "Adlog.h"
+
+#define MODEL_BENCH_DEFAULT_REPEAT          3
+
+using namespace WuDu;
+
+struct ModelBenchResult {
+	double bestMs = std::numeric_limits<double>::max();
+	std::vector<ModelMesh> meshes;
+};
+
+// 不读写烘焙缓存，每次都经过 Assimp 导入，保留最快一次的耗时
+static bool RunLoad(const std::string& filePath, const AdModelImportSettings& settings, ModelBenchResult* outResult) {
+	std::vector<ModelMesh> meshes;
+	std::vector<ModelMaterial> materials;
+	auto startTime = std::chrono::steady_clock::now();
+	if (!AdModelLoader::LoadModel(filePath, meshes, materials, settings)) {
+		LOG_E("Failed to load {0}", filePath);
+		return false;
+	}
+	outResult->bestMs = std::min(outResult->bestMs, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count());
+	outResult->meshes = std::move(meshes);
+	return true;
+}
+
+static bool IsSameMeshes(const std::vector<ModelMesh>& a, const std::vector<ModelMesh>& b) {
+	if (a.size() != b.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < a.size(); i++) {
+		if (a[i].VertexCount != b[i].VertexCount || a[i].Indices != b[i].Indices || a[i].MaterialIndex != b[i].MaterialIndex
+			|| a[i].BoundsMin != b[i].BoundsMin || a[i].BoundsMax != b[i].BoundsMax || a[i].BoundingSphere != b[i].BoundingSphere
+			|| memcmp(a[i].Vertices.data(), b[i].Vertices.data(), a[i].Vertices.size() * sizeof(ModelVertex)) != 0) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief 模型导入中网格转换的串行与并行对比
+ *
+ * 用法：AdBench_ModelLoad [模型文件] [重复次数]，默认加载 Resource/Model/Phainon.fbx。
+ * 对同一模型分别在开启/关闭网格优化时，以 bParallelMeshes 关闭(调用线程串行)与开启(AdThreadPool::ParallelFor)导入，
+ * 比较整次 LoadModel 的耗时，并逐网格比较两条路径的输出，不一致时以非零退出码结束。
+ * 计时前先导入一次预热文件缓存与内存分配器，之后两条路径交替执行，各取最快一次。
+ * Assimp 解析本身是串行的，加速比取决于模型中网格的数量与大小，应在多核机器上用大型多网格模型测量。
+ */
+int main(int argc, char* argv[]) {
+	Adlog::Init();
+	std::string filePath = argc > 1 ? argv[1] : AD_RES_MODEL_DIR"Phainon.fbx";
+	uint32_t repeat = argc > 2 ? std::max(1, std::atoi(argv[2])) : MODEL_BENCH_DEFAULT_REPEAT;
+
+	bool bPassed = true;
+	for (bool bOptimizeMeshes : { false, true }) {
+		AdModelImportSettings settings;
+		settings.bOptimizeMeshes = bOptimizeMeshes;
+		settings.bUseCache = false;
+
+		AdModelImportSettings serialSettings = settings;
+		serialSettings.bParallelMeshes = false;
+		ModelBenchResult warmup;
+		ModelBenchResult serial;
+		ModelBenchResult parallel;
+		if (!RunLoad(filePath, settings, &warmup)) {
+			return 1;
+		}
+		for (uint32_t i = 0; i < repeat; i++) {
+			if (!RunLoad(filePath, serialSettings, &serial) || !RunLoad(filePath, settings, &parallel)) {
+				return 1;
+			}
+		}
+
+		uint64_t vertexCount = 0;
+		uint64_t indexCount = 0;
+		for (const ModelMesh& mesh : serial.meshes) {
+			vertexCount += mesh.VertexCount;
+			indexCount += mesh.IndexCount;
+		}
+		bool bSame = IsSameMeshes(serial.meshes, parallel.meshes);
+		bPassed &= bSame;
+		LOG_I("{0}: {1} meshes, {2} vertices, {3} indices, optimize {4}: serial {5:.2f} ms, parallel {6:.2f} ms ({7} workers), {8:.2f}x, output {9}",
+			filePath, serial.meshes.size(), vertexCount, indexCount, bOptimizeMeshes ? "on" : "off",
+			serial.bestMs, parallel.bestMs, AdThreadPool::GetInstance()->GetWorkerCount(), serial.bestMs / parallel.bestMs,
+			bSame ? "identical" : "MISMATCH");
+	}
+	return bPassed ? 0 : 1;
+}
@@ -0,0 +1,160 @@
+#include "Resource/AdResourceManager.h"
+#include "Adlog.h"
+#include <latch>
+
+#define RESOURCE_STRESS_REQUEST_COUNT       1000
+#define RESOURCE_STRESS_CALLER_COUNT        8
+#define RESOURCE_STRESS_PATH_COUNT          64      // 其中每 8 个路径有 1 个加载失败、1 个加载时抛出异常
+#define RESOURCE_STRESS_LOAD_DELAY_US       500     // 拉长加载耗时，使并发请求落在进行中的加载上
+
+using namespace WuDu;
+
+static std::atomic<uint32_t> sLoadCounts[RESOURCE_STRESS_PATH_COUNT];
+
+static bool IsThrowingPath(uint32_t pathIndex) {
+	return pathIndex % 8 == 3;
+}
+
+static bool IsFailingPath(uint32_t pathIndex) {
+	return pathIndex % 8 == 7 || IsThrowingPath(pathIndex);
+}
+
+static std::string GetStressPath(uint32_t pathIndex) {
+	if (IsThrowingPath(pathIndex)) {
+		return "throw/" + std::to_string(pathIndex);
+	}
+	return (IsFailingPath(pathIndex) ? "missing/" : "stress/") + std::to_string(pathIndex);
+}
+
+// 只记录加载次数的资源，失败路径的 Load 返回 false 或抛出异常，走 RunLoad 的失败分支
+class AdStressResource : public AdResource {
+public:
+	AdStressResource(const std::string& path, uint32_t pathIndex) : AdResource(path), mPathIndex(pathIndex) {}
+
+	bool Load() override {
+		sLoadCounts[mPathIndex].fetch_add(1);
+		std::this_thread::sleep_for(std::chrono::microseconds(RESOURCE_STRESS_LOAD_DELAY_US));
+		if (IsThrowingPath(mPathIndex)) {
+			throw std::runtime_error("stress load exception");
+		}
+		return !IsFailingPath(mPathIndex);
+	}
+	void Unload() override {}
+private:
+	uint32_t mPathIndex;
+};
+
+struct StressRequest {
+	uint32_t pathIndex;
+	AdResourceHandle<AdStressResource> handle;
+	std::shared_ptr<AdStressResource> joined;      // 同一路径的同步 Load 结果
+};
+
+/**
+ * @brief AdResourceManager 并发加载压力测试
+ *
+ * 多个调用线程同时发出 1000 次 LoadAsync，路径集合很小，大部分请求落在已加载或进行中的加载上；
+ * 奇数号请求再用同步 Load 加入同一路径的加载。全部等待结束后检查：
+ * 成功路径只加载一次且所有请求拿到同一个资源对象；失败路径(包括 Load 抛出异常的路径)的所有句柄返回失败、
+ * 资源处于 Failed、不登记到映射表；没有遗留的进行中加载。任一检查失败时以非零退出码结束。
+ * 异常未被处理时，等待抛出异常路径的句柄会一直挂起。
+ */
+int main(int argc, char* argv[]) {
+	Adlog::Init();
+	AdResourceManager* manager = AdResourceManager::GetInstance();
+
+	// 调用线程 c 依次发出第 c、c + N、c + 2N ... 号请求，同一轮的 N 个请求指向同一路径，使各线程同时争用同一路径
+	std::vector<StressRequest> requests(RESOURCE_STRESS_REQUEST_COUNT);
+	for (uint32_t i = 0; i < RESOURCE_STRESS_REQUEST_COUNT; i++) {
+		requests[i].pathIndex = (i / RESOURCE_STRESS_CALLER_COUNT) % RESOURCE_STRESS_PATH_COUNT;
+	}
+
+	// 所有调用线程就绪后同时开始发请求
+	std::latch startLatch(RESOURCE_STRESS_CALLER_COUNT);
+	std::vector<std::thread> callers;
+	auto startTime = std::chrono::steady_clock::now();
+	for (uint32_t caller = 0; caller < RESOURCE_STRESS_CALLER_COUNT; caller++) {
+		callers.emplace_back([&, caller]() {
+			startLatch.arrive_and_wait();
+			for (uint32_t i = caller; i < RESOURCE_STRESS_REQUEST_COUNT; i += RESOURCE_STRESS_CALLER_COUNT) {
+				StressRequest& request = requests[i];
+				request.handle = manager->LoadAsync<AdStressResource>(GetStressPath(request.pathIndex), request.pathIndex);
+				if (i % 2 == 1) {
+					request.joined = manager->Load<AdStressResource>(GetStressPath(request.pathIndex), request.pathIndex);
+				}
+			}
+		});
+	}
+	for (auto& caller : callers) {
+		caller.join();
+	}
+	double submitMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	uint32_t errorCount = 0;
+	std::vector<std::shared_ptr<AdStressResource>> firstResources(RESOURCE_STRESS_PATH_COUNT);
+	for (uint32_t i = 0; i < RESOURCE_STRESS_REQUEST_COUNT; i++) {
+		StressRequest& request = requests[i];
+		const uint32_t pathIndex = request.pathIndex;
+		if (!request.handle.IsValid()) {
+			LOG_E("Request {0}: invalid handle for {1}", i, GetStressPath(pathIndex));
+			errorCount++;
+			continue;
+		}
+		bool bLoaded = request.handle.Wait();
+		std::shared_ptr<AdStressResource> resource = request.handle.Get();
+		if (IsFailingPath(pathIndex)) {
+			// 失败后进行中记录被移除，之后的请求会重新加载，因此只检查结果而不检查对象唯一
+			if (bLoaded || resource->GetState() != ResourceState::Failed || (request.joined && request.joined->IsLoaded())) {
+				LOG_E("Request {0}: {1} should have failed", i, GetStressPath(pathIndex));
+				errorCount++;
+			}
+			continue;
+		}
+		if (!firstResources[pathIndex]) {
+			firstResources[pathIndex] = resource;
+		}
+		if (!bLoaded || !resource->IsLoaded() || resource != firstResources[pathIndex]
+			|| (request.joined && request.joined != resource)) {
+			LOG_E("Request {0}: {1} was not deduplicated", i, GetStressPath(pathIndex));
+			errorCount++;
+		}
+	}
+	double joinMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+
+	uint32_t failedLoads = 0;
+	for (uint32_t pathIndex = 0; pathIndex < RESOURCE_STRESS_PATH_COUNT; pathIndex++) {
+		uint32_t loadCount = sLoadCounts[pathIndex].load();
+		std::shared_ptr<AdStressResource> registered = manager->Get<AdStressResource>(GetStressPath(pathIndex));
+		if (IsFailingPath(pathIndex)) {
+			failedLoads += loadCount;
+			if (loadCount == 0 || registered) {
+				LOG_E("{0}: failed load registered or never attempted ({1} loads)", GetStressPath(pathIndex), loadCount);
+				errorCount++;
+			}
+		} else if (loadCount != 1 || registered != firstResources[pathIndex]) {
+			LOG_E("{0}: loaded {1} times", GetStressPath(pathIndex), loadCount);
+			errorCount++;
+		}
+	}
+
+	// 已加载的路径再次请求时立即就绪，不再加载
+	AdResourceHandle<AdStressResource> readyHandle = manager->LoadAsync<AdStressResource>(GetStressPath(0), 0u);
+	if (!readyHandle.IsReady() || readyHandle.GetResource() != firstResources[0] || sLoadCounts[0].load() != 1) {
+		LOG_E("{0}: loaded path was not returned ready", GetStressPath(0));
+		errorCount++;
+	}
+	if (manager->GetPendingCount() != 0) {
+		LOG_E("{0} loads still pending", manager->GetPendingCount());
+		errorCount++;
+	}
+
+	LOG_I("{0} LoadAsync calls from {1} threads over {2} paths, {3} pool workers: submitted in {4:.2f} ms, all joined in {5:.2f} ms, {6} failing loads, {7} errors",
+		RESOURCE_STRESS_REQUEST_COUNT, RESOURCE_STRESS_CALLER_COUNT, RESOURCE_STRESS_PATH_COUNT,
+		AdThreadPool::GetInstance()->GetWorkerCount(), submitMs, joinMs, failedLoads, errorCount);
+
+	requests.clear();
+	firstResources.clear();
+	readyHandle = {};
+	manager->UnloadAll();
+	return errorCount == 0 ? 0 : 1;
+}
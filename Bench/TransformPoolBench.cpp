@@ -0,0 +1,83 @@
+#include "ECS/AdTransformPool.h"
+#include "ECS/Component/AdTransformComponent.h"
+#include "Adlog.h"
+
+// 每个规模重复测量的次数，取最快一次
+#define TRANSFORM_BENCH_REPEAT              5
+// 与标量结果比较的容差，按矩阵元素绝对值放大
+#define TRANSFORM_BENCH_TOLERANCE           1e-4f
+
+using namespace WuDu;
+
+/**
+ * @brief AdTransformPool 批量组合与逐个 AdTransformComponent::GetTransform() 的对比
+ *
+ * 两条路径使用同一组随机 TRS，先逐元素比较结果再计时；结果不一致时以非零退出码结束。
+ * 组件没有所属实体，GetTransform() 走局部矩阵路径，即变换系统重建局部矩阵时的开销。
+ */
+static bool RunBench(uint32_t count, bool bReport) {
+	std::mt19937 random(count);
+	std::uniform_real_distribution<float> angle(-180.f, 180.f);
+	std::uniform_real_distribution<float> offset(-1000.f, 1000.f);
+	std::uniform_real_distribution<float> scale(0.1f, 4.f);
+
+	std::vector<AdTransformComponent> components(count);
+	AdTransformPool pool;
+	pool.Reserve(count);
+	for (uint32_t i = 0; i < count; i++) {
+		AdTransformComponent& component = components[i];
+		component.position = { offset(random), offset(random), offset(random) };
+		component.rotation = { angle(random), angle(random), angle(random) };
+		component.scale = { scale(random), scale(random), scale(random) };
+		pool.Add(component.position, AdTransformPool::EulerDegreesToQuat(component.rotation), component.scale);
+	}
+
+	std::vector<glm::mat4> scalarMatrices(count);
+	std::vector<glm::mat4> poolMatrices(count);
+	double scalarMs = std::numeric_limits<double>::max();
+	double poolMs = std::numeric_limits<double>::max();
+	for (int repeat = 0; repeat < TRANSFORM_BENCH_REPEAT; repeat++) {
+		auto startTime = std::chrono::steady_clock::now();
+		for (uint32_t i = 0; i < count; i++) {
+			scalarMatrices[i] = components[i].GetTransform();
+		}
+		auto scalarTime = std::chrono::steady_clock::now();
+		pool.ComposeMatrices(poolMatrices.data());
+		auto poolTime = std::chrono::steady_clock::now();
+		scalarMs = std::min(scalarMs, std::chrono::duration<double, std::milli>(scalarTime - startTime).count());
+		poolMs = std::min(poolMs, std::chrono::duration<double, std::milli>(poolTime - scalarTime).count());
+	}
+
+	float maxError = 0.f;
+	for (uint32_t i = 0; i < count; i++) {
+		for (int column = 0; column < 4; column++) {
+			for (int row = 0; row < 4; row++) {
+				float expected = scalarMatrices[i][column][row];
+				float error = std::abs(expected - poolMatrices[i][column][row]) / std::max(1.f, std::abs(expected));
+				maxError = std::max(maxError, error);
+			}
+		}
+	}
+	bool bMatch = maxError <= TRANSFORM_BENCH_TOLERANCE;
+	if (!bMatch) {
+		LOG_E("AdTransformPool {0} transforms: max relative error {1} exceeds {2}", count, maxError, TRANSFORM_BENCH_TOLERANCE);
+	}
+	if (bReport) {
+		LOG_I("{0:>8} transforms: GetTransform {1:8.3f} ms ({2:6.2f} ns/obj), ComposeMatrices {3:8.3f} ms ({4:6.2f} ns/obj), {5:5.2f}x, max error {6:.2e}",
+			count, scalarMs, scalarMs * 1e6 / count, poolMs, poolMs * 1e6 / count, scalarMs / poolMs, maxError);
+	}
+	return bMatch;
+}
+
+int main(int argc, char* argv[]) {
+	Adlog::Init();
+	LOG_I("AdTransformPool SIMD width: {0}", AdTransformPool::GetSimdWidth());
+
+	bool bPassed = true;
+	// 不是 8 的整数倍的规模覆盖 SIMD 之后的标量收尾
+	bPassed &= RunBench(1003, false);
+	for (uint32_t count : { 10000u, 100000u, 1000000u }) {
+		bPassed &= RunBench(count, true);
+	}
+	return bPassed ? 0 : 1;
+}
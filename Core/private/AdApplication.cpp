@@ -1,6 +1,7 @@
 #include "AdApplication.h"
 #include "AdLog.h"
 #include "Render/AdRenderContext.h"
+#include "Graphic/AdVKPipeline.h"
 #include "ECS/AdEntity.h"
 #include "Event/AdInputManager.h"
 
@@ -20,14 +21,18 @@ namespace WuDu {
 
 		// 创建窗口和渲染上下文
 		mWindow = AdWindow::Create(mAppSettings.width, mAppSettings.height, mAppSettings.title);
-		mRenderContext = std::make_shared<AdRenderContext>(mWindow.get());
+		AdVkSettings vkSettings{};
+		vkSettings.framesInFlight = std::max(1u, mAppSettings.framesInFlight);
+		mRenderContext = std::make_shared<AdRenderContext>(mWindow.get(), vkSettings);
 
 		// 设置全局应用上下文
 		sAppContext.app = this;
 		sAppContext.renderCxt = mRenderContext.get();
 
+		mInitTimePoint = std::chrono::steady_clock::now();
 		OnInit(); // 调用初始化回调
 		LoadScene(); // 加载场景
+		mInitTimeMs = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - mInitTimePoint).count();
 
 		mStartTimePoint = std::chrono::steady_clock::now(); // 记录开始时间点
 	}
@@ -45,7 +50,7 @@ namespace WuDu {
 	 */
 	void AdApplication::MainLoop() {
 		mLastTimePoint = std::chrono::steady_clock::now(); // 记录上一帧时间点
-		while (!mWindow->ShouldClose()) { // 循环直到窗口关闭
+		while (!mWindow->ShouldClose() && (mMaxFrames == 0 || mFrameIndex < mMaxFrames)) { // 循环直到窗口关闭或达到指定帧数
 			mWindow->PollEvents(); // 处理窗口事件
 			
 			// 计算帧间隔时间
@@ -56,19 +61,52 @@ namespace WuDu {
 			if (!bPause) { // 如果未暂停，更新游戏逻辑
 				OnUpdate(deltaTime);
 			}
+			if (mScene) { // 更新世界矩阵，暂停时编辑器仍可能修改变换
+				mScene->OnUpdate(deltaTime);
+			}
 			OnRender(); // 执行渲染操作
 
 			mWindow->SwapBuffer(); // 交换窗口显示缓冲
+
+			if (!bStartupLogged) {
+				LogStartupIfReady();
+			}
 		}
 	}
 
 	/**
-	 * @brief 解析命令行参数，当前为未实现
+	 * @brief 启动阶段提交的管线全部编译完成后输出一次启动耗时及管线创建耗时，用于对比管线缓存冷/热启动
+	 *
+	 * 材质系统在工作线程上异步编译管线，OnInit 返回时编译通常尚未结束，因此在主循环中等到注册表没有
+	 * 待编译的管线时再输出；就绪耗时为 OnInit 开始到全部管线编译完成(按帧粒度)的时间。
+	 */
+	void AdApplication::LogStartupIfReady() {
+		AdVKDevice* device = mRenderContext->GetDevice();
+		if (device->GetPipelineRegistry()->GetPendingCount() > 0) {
+			return;
+		}
+		bStartupLogged = true;
+		LOG_I("Startup: init {0} ms, ready in {1} ms, {2} pipelines created in {3} ms ({4} pipeline cache)",
+			mInitTimeMs, std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - mInitTimePoint).count(),
+			device->GetPipelineCreateCount(), device->GetPipelineCreateTimeMs(), device->IsPipelineCacheWarm() ? "warm" : "cold");
+	}
+
+	/**
+	 * @brief 解析命令行参数：保存全部参数供应用查询，并处理引擎自身的 --frames N
 	 * @param argc 命令行参数数量
 	 * @param argv 命令行参数数组
 	 */
 	void AdApplication::ParseArgs(int argc, char** argv) {
+		mArgs.assign(argv + std::min(argc, 1), argv + argc);
+		for (size_t i = 0; i + 1 < mArgs.size(); i++) {
+			if (mArgs[i] == "--frames") {
+				mMaxFrames = std::strtoull(mArgs[i + 1].c_str(), nullptr, 10);
+			}
+		}
+	}
 
+	bool AdApplication::HasArg(const std::string& name) const {
+		return std::find(mArgs.begin(), mArgs.end(), name) != mArgs.end();
 	}
 
 	/**
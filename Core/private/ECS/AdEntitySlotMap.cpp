@@ -0,0 +1,73 @@
+#include "ECS/AdEntitySlotMap.h"
+#include "ECS/AdEntity.h"
+
+namespace WuDu {
+	AdEntitySlotMap::~AdEntitySlotMap() {
+		Clear();
+	}
+
+	/**
+	 * @brief 在实体索引对应的槽位上构造 AdEntity
+	 *
+	 * @param enttEntity entt 实体标识
+	 * @param scene 所属场景
+	 * @return 实体对象，槽位已被占用时返回空
+	 */
+	AdEntity* AdEntitySlotMap::Emplace(entt::entity enttEntity, AdScene* scene) {
+		uint32_t index = static_cast<uint32_t>(entt::to_entity(enttEntity));
+		if (index >= mSlotEntities.size()) {
+			mSlotEntities.resize(index + 1, entt::null);
+		}
+		if (mSlotEntities[index] != entt::null) {
+			return nullptr;
+		}
+		uint32_t pageIndex = index / AD_ENTITY_SLOT_PAGE_SIZE;
+		while (mPages.size() <= pageIndex) {
+			mPages.push_back(std::make_unique_for_overwrite<std::byte[]>(sizeof(AdEntity) * AD_ENTITY_SLOT_PAGE_SIZE));
+		}
+
+		AdEntity* entity = new (GetSlot(index)) AdEntity(enttEntity, scene);
+		mSlotEntities[index] = enttEntity;
+		mSize++;
+		return entity;
+	}
+
+	AdEntity* AdEntitySlotMap::Get(entt::entity enttEntity) const {
+		if (enttEntity == entt::null) {
+			return nullptr;
+		}
+		uint32_t index = static_cast<uint32_t>(entt::to_entity(enttEntity));
+		if (index >= mSlotEntities.size() || mSlotEntities[index] != enttEntity) {
+			return nullptr;
+		}
+		return GetSlot(index);
+	}
+
+	bool AdEntitySlotMap::Erase(entt::entity enttEntity) {
+		AdEntity* entity = Get(enttEntity);
+		if (!entity) {
+			return false;
+		}
+		entity->~AdEntity();
+		mSlotEntities[entt::to_entity(enttEntity)] = entt::null;
+		mSize--;
+		return true;
+	}
+
+	// 析构所有存活的实体，已分配的页保留给之后创建的实体复用
+	void AdEntitySlotMap::Clear() {
+		for (uint32_t index = 0; index < mSlotEntities.size() && mSize > 0; index++) {
+			if (mSlotEntities[index] != entt::null) {
+				GetSlot(index)->~AdEntity();
+				mSlotEntities[index] = entt::null;
+				mSize--;
+			}
+		}
+		mSlotEntities.clear();
+	}
+
+	AdEntity* AdEntitySlotMap::GetSlot(uint32_t index) const {
+		std::byte* page = mPages[index / AD_ENTITY_SLOT_PAGE_SIZE].get();
+		return reinterpret_cast<AdEntity*>(page + sizeof(AdEntity) * (index % AD_ENTITY_SLOT_PAGE_SIZE));
+	}
+}
@@ -1,6 +1,13 @@
 #include "ECS/AdNode.h"
 
 namespace WuDu {
+	AdNode::~AdNode() {
+		if (mParent) {
+			mParent->RemoveChild(this);
+		}
+		RemoveAllChildren();
+	}
+
 	AdUUID AdNode::GetId() const {
 		return mId;
 	}
@@ -17,43 +24,66 @@ namespace WuDu {
 		mName = name;
 	}
 
-	const std::vector<AdNode*>& AdNode::GetChildren() const {
-		return mChildren;
-	}
-
-	bool AdNode::HasParent() {
-		return mParent != nullptr;
-	}
-
-	bool AdNode::HasChildren() {
-		return !mChildren.empty();
-	}
-
 	void AdNode::SetParent(AdNode* node) {
 		node->AddChild(this);
 	}
 
-	AdNode* AdNode::GetParent() const {
-		return mParent;
-	}
-
+	// 挂到子节点链表尾部，已有父节点时先从原父节点摘除
 	void AdNode::AddChild(AdNode* node) {
+		if (!node || node == this || node->mParent == this) {
+			return;
+		}
 		if (node->HasParent()) {
 			node->GetParent()->RemoveChild(node);
 		}
 		node->mParent = this;
-		mChildren.push_back(node);
+		node->mPrevSibling = mLastChild;
+		node->mNextSibling = nullptr;
+		if (mLastChild) {
+			mLastChild->mNextSibling = node;
+		} else {
+			mFirstChild = node;
+		}
+		mLastChild = node;
+		mChildCount++;
+		sHierarchyVersion++;
 	}
 
 	void AdNode::RemoveChild(AdNode* node) {
-		if (!HasChildren()) {
+		if (!node || node->mParent != this) {
+			return;
+		}
+		if (node->mPrevSibling) {
+			node->mPrevSibling->mNextSibling = node->mNextSibling;
+		} else {
+			mFirstChild = node->mNextSibling;
+		}
+		if (node->mNextSibling) {
+			node->mNextSibling->mPrevSibling = node->mPrevSibling;
+		} else {
+			mLastChild = node->mPrevSibling;
+		}
+		node->mParent = nullptr;
+		node->mPrevSibling = nullptr;
+		node->mNextSibling = nullptr;
+		mChildCount--;
+		sHierarchyVersion++;
+	}
+
+	void AdNode::RemoveAllChildren() {
+		if (!mFirstChild) {
 			return;
 		}
-		for (auto it = mChildren.begin(); it != mChildren.end(); ++it) {
-			if (node == *it) {
-				mChildren.erase(it);
-				break;
-			}
+		for (AdNode* child = mFirstChild; child; ) {
+			AdNode* next = child->mNextSibling;
+			child->mParent = nullptr;
+			child->mPrevSibling = nullptr;
+			child->mNextSibling = nullptr;
+			child = next;
 		}
+		mFirstChild = nullptr;
+		mLastChild = nullptr;
+		mChildCount = 0;
+		sHierarchyVersion++;
 	}
-}
\ No newline at end of file
+}
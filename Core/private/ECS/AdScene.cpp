@@ -1,16 +1,17 @@
 #include "ECS/AdScene.h"
 #include "ECS/AdEntity.h"
 #include "ECS/Component/AdTransformComponent.h"
+#include "ECS/System/AdTransformSystem.h"
 
 namespace WuDu {
 	AdScene::AdScene() {
 		mRootNode = std::make_shared<AdNode>();
+		mTransformSystem = std::make_unique<AdTransformSystem>(this);
 	}
 
 	AdScene::~AdScene() {
 		mRootNode.reset();
 		DestroyAllEntity();
-		mEntities.clear();
 	}
 
 	AdEntity* AdScene::CreateEntity(const std::string& name) {
@@ -19,42 +20,132 @@ namespace WuDu {
 
 	AdEntity* AdScene::CreateEntityWithUUID(const AdUUID& id, const std::string& name) {
 		auto enttEntity = mEcsRegistry.create();
-		mEntities.insert({ enttEntity, std::make_shared<AdEntity>(enttEntity, this) });
-		mEntities[enttEntity]->SetParent(mRootNode.get());
-		mEntities[enttEntity]->SetId(id);
-		mEntities[enttEntity]->SetName(name.empty() ? "Entity" : name);
+		AdEntity* entity = mEntities.Emplace(enttEntity, this);
+		entity->SetParent(mRootNode.get());
+		entity->SetId(id);
+		entity->SetName(name.empty() ? "Entity" : name);
 
 		// add default components
-		mEntities[enttEntity]->AddComponent<AdTransformComponent>();
+		entity->AddComponent<AdTransformComponent>();
 
-		return mEntities[enttEntity].get();
+		return entity;
 	}
 
 	void AdScene::DestroyEntity(const AdEntity* entity) {
-		if (entity && entity->IsValid()) {
-			mEcsRegistry.destroy(entity->GetEcsEntity());
+		if (!entity) {
+			return;
+		}
+		// 实体对象随槽位析构，先取出标识
+		entt::entity enttEntity = entity->GetEcsEntity();
+		if (entity->IsValid()) {
+			mEcsRegistry.destroy(enttEntity);
 		}
 
-		auto it = mEntities.find(entity->GetEcsEntity());
-		if (it != mEntities.end()) {
-			AdNode* parent = it->second->GetParent();
+		// 摘除是 O(1) 的；子节点挂回根节点，保持在场景中
+		AdEntity* storedEntity = mEntities.Get(enttEntity);
+		if (storedEntity) {
+			AdNode* parent = storedEntity->GetParent();
 			if (parent) {
-				parent->RemoveChild(it->second.get());
+				parent->RemoveChild(storedEntity);
+			}
+			while (AdNode* child = storedEntity->GetFirstChild()) {
+				mRootNode->AddChild(child);
 			}
-			mEntities.erase(it);
+			mEntities.Erase(enttEntity);
+		}
+	}
+
+	/**
+	 * @brief 批量创建实体
+	 *
+	 * 区间创建 entt 实体并一次插入变换组件，UUID 取一次随机数作为起点顺序分配，
+	 * 父子挂接为 O(1) 的链表追加，变换系统在下一帧只重建一次层级顺序。
+	 *
+	 * @param count 实体数量
+	 * @param prototype 名称、父节点与初始变换
+	 * @return 新建的实体，顺序与创建顺序一致
+	 */
+	std::vector<AdEntity*> AdScene::CreateEntities(uint32_t count, const AdEntityPrototype& prototype) {
+		std::vector<AdEntity*> entities;
+		if (count == 0) {
+			return entities;
+		}
+		std::vector<entt::entity> enttEntities(count);
+		mEcsRegistry.create(enttEntities.begin(), enttEntities.end());
+
+		auto& transformStorage = mEcsRegistry.storage<AdTransformComponent>();
+		transformStorage.reserve(transformStorage.size() + count);
+		AdTransformComponent transform;
+		transform.position = prototype.position;
+		transform.rotation = prototype.rotation;
+		transform.scale = prototype.scale;
+		mEcsRegistry.insert<AdTransformComponent>(enttEntities.begin(), enttEntities.end(), transform);
+
+		AdNode* parent = prototype.parent ? prototype.parent : mRootNode.get();
+		uint32_t baseId = AdUUID();
+		entities.reserve(count);
+		for (uint32_t i = 0; i < count; i++) {
+			AdEntity* entity = mEntities.Emplace(enttEntities[i], this);
+			uint32_t id = baseId + i;
+			entity->SetId(AdUUID(id != 0 ? id : 1));
+			entity->SetName(prototype.name);
+			parent->AddChild(entity);
+			transformStorage.get(enttEntities[i]).SetOwner(entity);
+			entities.push_back(entity);
+		}
+		return entities;
+	}
+
+	/**
+	 * @brief 批量销毁实体：先摘除全部层级关系，再区间销毁 entt 实体，最后析构实体对象
+	 *
+	 * @param entities 待销毁的实体，可以互为父子
+	 */
+	void AdScene::DestroyEntities(std::span<AdEntity* const> entities) {
+		std::vector<entt::entity> enttEntities;
+		enttEntities.reserve(entities.size());
+		// 按实体索引标记已收集的实体，重复传入的实体只销毁一次
+		std::vector<bool> collected(mEntities.GetSlotCount(), false);
+		for (AdEntity* entity : entities) {
+			if (!entity || mEntities.Get(entity->GetEcsEntity()) != entity) {
+				continue;
+			}
+			uint32_t index = static_cast<uint32_t>(entt::to_entity(entity->GetEcsEntity()));
+			if (collected[index]) {
+				continue;
+			}
+			collected[index] = true;
+			// 子实体挂回根节点；若它也在本批中，轮到它时会再被摘除
+			if (AdNode* parent = entity->GetParent()) {
+				parent->RemoveChild(entity);
+			}
+			while (AdNode* child = entity->GetFirstChild()) {
+				mRootNode->AddChild(child);
+			}
+			enttEntities.push_back(entity->GetEcsEntity());
+		}
+
+		mEcsRegistry.destroy(enttEntities.begin(), enttEntities.end());
+		for (entt::entity enttEntity : enttEntities) {
+			mEntities.Erase(enttEntity);
 		}
 	}
 
 	void AdScene::DestroyAllEntity() {
+		// 槽位会被之后创建的实体复用，根节点不能保留指向已析构实体的指针
+		if (mRootNode) {
+			mRootNode->RemoveAllChildren();
+		}
 		mEcsRegistry.clear();
-		mEntities.clear();
+		mEntities.Clear();
+	}
+
+	void AdScene::OnUpdate(float deltaTime) {
+		mTransformSystem->OnUpdate(deltaTime);
 	}
 
 	AdEntity* AdScene::GetEntity(entt::entity enttEntity) {
-		if (mEntities.find(enttEntity) != mEntities.end()) {
-			return mEntities.at(enttEntity).get();
-		}
-		return nullptr;
+		return mEntities.Get(enttEntity);
 	}
 
 }
\ No newline at end of file
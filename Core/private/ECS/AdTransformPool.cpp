@@ -0,0 +1,180 @@
+#include "ECS/AdTransformPool.h"
+
+#if defined(__AVX2__)
+#define AD_TRANSFORM_POOL_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define AD_TRANSFORM_POOL_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace WuDu {
+	uint32_t AdTransformPool::Add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+		mPosX.push_back(position.x);
+		mPosY.push_back(position.y);
+		mPosZ.push_back(position.z);
+		mRotX.push_back(rotation.x);
+		mRotY.push_back(rotation.y);
+		mRotZ.push_back(rotation.z);
+		mRotW.push_back(rotation.w);
+		mScaleX.push_back(scale.x);
+		mScaleY.push_back(scale.y);
+		mScaleZ.push_back(scale.z);
+		return mSize++;
+	}
+
+	void AdTransformPool::Set(uint32_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale) {
+		SetPosition(index, position);
+		SetRotation(index, rotation);
+		SetScale(index, scale);
+	}
+
+	void AdTransformPool::SetPosition(uint32_t index, const glm::vec3& position) {
+		mPosX[index] = position.x;
+		mPosY[index] = position.y;
+		mPosZ[index] = position.z;
+	}
+
+	void AdTransformPool::SetRotation(uint32_t index, const glm::quat& rotation) {
+		mRotX[index] = rotation.x;
+		mRotY[index] = rotation.y;
+		mRotZ[index] = rotation.z;
+		mRotW[index] = rotation.w;
+	}
+
+	void AdTransformPool::SetScale(uint32_t index, const glm::vec3& scale) {
+		mScaleX[index] = scale.x;
+		mScaleY[index] = scale.y;
+		mScaleZ[index] = scale.z;
+	}
+
+	void AdTransformPool::Reserve(uint32_t capacity) {
+		for (auto* values : { &mPosX, &mPosY, &mPosZ, &mRotX, &mRotY, &mRotZ, &mRotW, &mScaleX, &mScaleY, &mScaleZ }) {
+			values->reserve(capacity);
+		}
+	}
+
+	void AdTransformPool::Clear() {
+		for (auto* values : { &mPosX, &mPosY, &mPosZ, &mRotX, &mRotY, &mRotZ, &mRotW, &mScaleX, &mScaleY, &mScaleZ }) {
+			values->clear();
+		}
+		mSize = 0;
+	}
+
+	glm::quat AdTransformPool::EulerDegreesToQuat(const glm::vec3& rotation) {
+		return glm::angleAxis(glm::radians(rotation.x), glm::vec3{ 1, 0, 0 })
+			* glm::angleAxis(glm::radians(rotation.y), glm::vec3{ 0, 1, 0 })
+			* glm::angleAxis(glm::radians(rotation.z), glm::vec3{ 0, 0, 1 });
+	}
+
+	uint32_t AdTransformPool::GetSimdWidth() {
+#if defined(AD_TRANSFORM_POOL_AVX2)
+		return 8;
+#elif defined(AD_TRANSFORM_POOL_SSE)
+		return 4;
+#else
+		return 1;
+#endif
+	}
+
+#ifdef AD_TRANSFORM_POOL_SSE
+	// 4 个对象的同一列按分量存放在 x/y/z/w 四个寄存器中，转置后每个寄存器即为一个对象的该列
+	static inline void StoreColumns(__m128 x, __m128 y, __m128 z, __m128 w, glm::mat4* outMatrices, int column) {
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		_mm_storeu_ps(&outMatrices[0][column][0], x);
+		_mm_storeu_ps(&outMatrices[1][column][0], y);
+		_mm_storeu_ps(&outMatrices[2][column][0], z);
+		_mm_storeu_ps(&outMatrices[3][column][0], w);
+	}
+#endif
+
+	/**
+	 * @brief 组合模型矩阵 T * R * S
+	 *
+	 * 单位四元数 (x, y, z, w) 的旋转矩阵各列乘以对应轴的缩放：
+	 * 列0 = sx * (1 - 2(yy + zz), 2(xy + wz), 2(xz - wy))
+	 * 列1 = sy * (2(xy - wz), 1 - 2(xx + zz), 2(yz + wx))
+	 * 列2 = sz * (2(xz + wy), 2(yz - wx), 1 - 2(xx + yy))
+	 * 列3 = (px, py, pz, 1)
+	 *
+	 * @param outMatrices 输出矩阵数组
+	 */
+	void AdTransformPool::ComposeMatrices(glm::mat4* outMatrices) const {
+		uint32_t index = 0;
+#ifdef AD_TRANSFORM_POOL_AVX2
+		const __m256 one8 = _mm256_set1_ps(1.f);
+		const __m256 two8 = _mm256_set1_ps(2.f);
+		for (; index + 8 <= mSize; index += 8) {
+			__m256 qx = _mm256_loadu_ps(&mRotX[index]);
+			__m256 qy = _mm256_loadu_ps(&mRotY[index]);
+			__m256 qz = _mm256_loadu_ps(&mRotZ[index]);
+			__m256 qw = _mm256_loadu_ps(&mRotW[index]);
+			__m256 sx = _mm256_loadu_ps(&mScaleX[index]);
+			__m256 sy = _mm256_loadu_ps(&mScaleY[index]);
+			__m256 sz = _mm256_loadu_ps(&mScaleZ[index]);
+
+			__m256 x2 = _mm256_mul_ps(qx, two8), y2 = _mm256_mul_ps(qy, two8), z2 = _mm256_mul_ps(qz, two8);
+			__m256 xx = _mm256_mul_ps(qx, x2), yy = _mm256_mul_ps(qy, y2), zz = _mm256_mul_ps(qz, z2);
+			__m256 xy = _mm256_mul_ps(qx, y2), xz = _mm256_mul_ps(qx, z2), yz = _mm256_mul_ps(qy, z2);
+			__m256 wx = _mm256_mul_ps(qw, x2), wy = _mm256_mul_ps(qw, y2), wz = _mm256_mul_ps(qw, z2);
+
+			__m256 m[4][4] = {
+				{ _mm256_mul_ps(sx, _mm256_sub_ps(one8, _mm256_add_ps(yy, zz))), _mm256_mul_ps(sx, _mm256_add_ps(xy, wz)), _mm256_mul_ps(sx, _mm256_sub_ps(xz, wy)), _mm256_setzero_ps() },
+				{ _mm256_mul_ps(sy, _mm256_sub_ps(xy, wz)), _mm256_mul_ps(sy, _mm256_sub_ps(one8, _mm256_add_ps(xx, zz))), _mm256_mul_ps(sy, _mm256_add_ps(yz, wx)), _mm256_setzero_ps() },
+				{ _mm256_mul_ps(sz, _mm256_add_ps(xz, wy)), _mm256_mul_ps(sz, _mm256_sub_ps(yz, wx)), _mm256_mul_ps(sz, _mm256_sub_ps(one8, _mm256_add_ps(xx, yy))), _mm256_setzero_ps() },
+				{ _mm256_loadu_ps(&mPosX[index]), _mm256_loadu_ps(&mPosY[index]), _mm256_loadu_ps(&mPosZ[index]), one8 }
+			};
+			// 高低两半各 4 个对象，分别转置写出
+			for (int column = 0; column < 4; column++) {
+				StoreColumns(_mm256_castps256_ps128(m[column][0]), _mm256_castps256_ps128(m[column][1]),
+					_mm256_castps256_ps128(m[column][2]), _mm256_castps256_ps128(m[column][3]), outMatrices + index, column);
+				StoreColumns(_mm256_extractf128_ps(m[column][0], 1), _mm256_extractf128_ps(m[column][1], 1),
+					_mm256_extractf128_ps(m[column][2], 1), _mm256_extractf128_ps(m[column][3], 1), outMatrices + index + 4, column);
+			}
+		}
+#endif
+#ifdef AD_TRANSFORM_POOL_SSE
+		const __m128 one = _mm_set1_ps(1.f);
+		const __m128 two = _mm_set1_ps(2.f);
+		for (; index + 4 <= mSize; index += 4) {
+			__m128 qx = _mm_loadu_ps(&mRotX[index]);
+			__m128 qy = _mm_loadu_ps(&mRotY[index]);
+			__m128 qz = _mm_loadu_ps(&mRotZ[index]);
+			__m128 qw = _mm_loadu_ps(&mRotW[index]);
+			__m128 sx = _mm_loadu_ps(&mScaleX[index]);
+			__m128 sy = _mm_loadu_ps(&mScaleY[index]);
+			__m128 sz = _mm_loadu_ps(&mScaleZ[index]);
+
+			__m128 x2 = _mm_mul_ps(qx, two), y2 = _mm_mul_ps(qy, two), z2 = _mm_mul_ps(qz, two);
+			__m128 xx = _mm_mul_ps(qx, x2), yy = _mm_mul_ps(qy, y2), zz = _mm_mul_ps(qz, z2);
+			__m128 xy = _mm_mul_ps(qx, y2), xz = _mm_mul_ps(qx, z2), yz = _mm_mul_ps(qy, z2);
+			__m128 wx = _mm_mul_ps(qw, x2), wy = _mm_mul_ps(qw, y2), wz = _mm_mul_ps(qw, z2);
+
+			StoreColumns(_mm_mul_ps(sx, _mm_sub_ps(one, _mm_add_ps(yy, zz))), _mm_mul_ps(sx, _mm_add_ps(xy, wz)),
+				_mm_mul_ps(sx, _mm_sub_ps(xz, wy)), _mm_setzero_ps(), outMatrices + index, 0);
+			StoreColumns(_mm_mul_ps(sy, _mm_sub_ps(xy, wz)), _mm_mul_ps(sy, _mm_sub_ps(one, _mm_add_ps(xx, zz))),
+				_mm_mul_ps(sy, _mm_add_ps(yz, wx)), _mm_setzero_ps(), outMatrices + index, 1);
+			StoreColumns(_mm_mul_ps(sz, _mm_add_ps(xz, wy)), _mm_mul_ps(sz, _mm_sub_ps(yz, wx)),
+				_mm_mul_ps(sz, _mm_sub_ps(one, _mm_add_ps(xx, yy))), _mm_setzero_ps(), outMatrices + index, 2);
+			StoreColumns(_mm_loadu_ps(&mPosX[index]), _mm_loadu_ps(&mPosY[index]), _mm_loadu_ps(&mPosZ[index]), one, outMatrices + index, 3);
+		}
+#endif
+		ComposeScalar(index, mSize, outMatrices);
+	}
+
+	void AdTransformPool::ComposeScalar(uint32_t begin, uint32_t end, glm::mat4* outMatrices) const {
+		for (uint32_t i = begin; i < end; i++) {
+			float x = mRotX[i], y = mRotY[i], z = mRotZ[i], w = mRotW[i];
+			float xx = 2.f * x * x, yy = 2.f * y * y, zz = 2.f * z * z;
+			float xy = 2.f * x * y, xz = 2.f * x * z, yz = 2.f * y * z;
+			float wx = 2.f * w * x, wy = 2.f * w * y, wz = 2.f * w * z;
+
+			glm::mat4& m = outMatrices[i];
+			m[0] = glm::vec4(mScaleX[i] * (1.f - yy - zz), mScaleX[i] * (xy + wz), mScaleX[i] * (xz - wy), 0.f);
+			m[1] = glm::vec4(mScaleY[i] * (xy - wz), mScaleY[i] * (1.f - xx - zz), mScaleY[i] * (yz + wx), 0.f);
+			m[2] = glm::vec4(mScaleZ[i] * (xz + wy), mScaleZ[i] * (yz - wx), mScaleZ[i] * (1.f - xx - yy), 0.f);
+			m[3] = glm::vec4(mPosX[i], mPosY[i], mPosZ[i], 1.f);
+		}
+	}
+}
@@ -0,0 +1,12 @@
+#include "ECS/Component/AdTransformComponent.h"
+#include "ECS/System/AdTransformSystem.h"
+
+namespace WuDu {
+	glm::mat4 AdTransformComponent::GetTransform() const {
+		AdEntity* owner = GetOwner();
+		if (owner && owner->GetScene()) {
+			return owner->GetScene()->GetTransformSystem()->GetWorldMatrix(*this);
+		}
+		return ComputeLocalTransform();
+	}
+}
@@ -11,6 +11,7 @@
 
 #include "ECS/AdEntity.h"
 #include "ECS/Component/AdLookAtCameraComponent.h"
+#include "ECS/System/AdTransformSystem.h"
 
 namespace WuDu {
 	/**
@@ -101,8 +102,8 @@ namespace WuDu {
 
 		mPipeline->SetSubPassIndex(0);
 
-		// 最终创建图形管线
-		mPipeline->Create();
+		// 最终创建图形管线，在工作线程上编译，完成前跳过绘制
+		mPipeline->CreateAsync();
 	}
 
 	/**
@@ -131,8 +132,10 @@ namespace WuDu {
 			return;
 		}
 
-		// 绑定当前渲染管线
-		mPipeline->Bind(cmdBuffer);
+		// 绑定当前渲染管线，管线仍在编译时跳过本帧绘制
+		if (!mPipeline->Bind(cmdBuffer)) {
+			return;
+		}
 
 		// 设置视口和裁剪区域
 		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
@@ -157,7 +160,8 @@ namespace WuDu {
 		glm::mat4 viewMat = GetViewMat(renderTarget);
 
 		// 遍历所有符合条件的实体并进行渲染
-		view.each([this, &cmdBuffer, &projMat, &viewMat](const auto& e, const AdTransformComponent& transComp, const AdBaseMaterialComponent& materialComp) {
+		AdTransformSystem* transformSystem = scene->GetTransformSystem();
+		view.each([this, &cmdBuffer, &projMat, &viewMat, transformSystem](const auto& e, const AdTransformComponent& transComp, const AdBaseMaterialComponent& materialComp) {
 			// 获取该组件中的网格材质映射
 			auto meshMaterials = materialComp.GetMeshMaterials();
 
@@ -173,7 +177,7 @@ namespace WuDu {
 
 				// 构造并设置 Push Constants 数据
 				PushConstants pushConstants{
-				    .matrix = projMat * viewMat * transComp.GetTransform(),
+				    .matrix = projMat * viewMat * transformSystem->GetWorldMatrix(transComp),
 				    .colorType = static_cast<uint32_t>(material->colorType)
 				};
 				vkCmdPushConstants(cmdBuffer, mPipelineLayout->GetHandle(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(pushConstants), &pushConstants);
@@ -181,7 +185,8 @@ namespace WuDu {
 				// 遍历与当前材质关联的所有网格索引，并执行绘制
 				for (const auto& meshIndex : entry.second) {
 					AdMesh* mesh = materialComp.GetMesh(meshIndex);
-					if (mesh) {
+					// 管线只有 AdVertex 顶点输入，模型与量化网格由无光照或GPU驱动材质系统绘制
+					if (mesh && mesh->GetVertexFormat() == AdVertexFormat::Float) {
 						mesh->Draw(cmdBuffer);
 					}
 				}
@@ -0,0 +1,605 @@
+#include "ECS/System/AdGpuDrivenMaterialSystem.h"
+
+#include "AdFileUtil.h"
+#include "AdApplication.h"
+#include "Graphic/AdVKPipeline.h"
+#include "Graphic/AdVKComputePipeline.h"
+#include "Graphic/AdVKDescriptorSet.h"
+#include "Graphic/AdVKFrameBuffer.h"
+#include "Graphic/AdVKRingBuffer.h"
+#include "Graphic/AdVKBindlessTable.h"
+#include "Graphic/AdVKGraphicContext.h"
+
+#include "Render/AdRenderTarget.h"
+#include "Render/AdMesh.h"
+#include "Render/AdFrustumCuller.h"
+
+#include "ECS/Component/AdTransformComponent.h"
+#include "ECS/System/AdTransformSystem.h"
+
+namespace WuDu {
+	/**
+	 * @brief 初始化GPU驱动材质系统：剔除计算管线、图形管线、环形缓冲区与每帧的间接绘制缓冲。
+	 *
+	 * @param renderPass Vulkan 渲染通道对象，用于图形管线创建。
+	 */
+	void AdGpuDrivenMaterialSystem::OnInit(AdVKRenderPass* renderPass) {
+		AdVKDevice* device = GetDevice();
+		bSupported = device->IsBindlessSupported() && device->IsMultiDrawIndirectSupported();
+		if (!bSupported) {
+			LOG_W("GPU driven material system requires bindless textures and multi draw indirect, disabled.");
+			return;
+		}
+		bDrawIndirectCount = device->IsDrawIndirectCountSupported();
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(device->GetContext()->GetPhyDevice(), &props);
+		mMaxDrawIndirectCount = props.limits.maxDrawIndirectCount;
+
+		// 绘制描述符集布局：帧UBO、实例数据（顶点着色器按 gl_InstanceIndex 读取）、材质数据
+		{
+			const std::vector<VkDescriptorSetLayoutBinding> bindings = {
+				{
+					.binding = 0,
+					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+					.descriptorCount = 1,
+					.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT
+				},
+				{
+					.binding = 1,
+					.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.descriptorCount = 1,
+					.stageFlags = VK_SHADER_STAGE_VERTEX_BIT
+				},
+				{
+					.binding = 2,
+					.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.descriptorCount = 1,
+					.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+				}
+			};
+			mDrawDescSetLayout = std::make_shared<AdVKDescriptorSetLayout>(device, bindings);
+		}
+
+		// 剔除描述符集布局：实例数据、网格表、间接绘制命令、绘制数量
+		{
+			std::vector<VkDescriptorSetLayoutBinding> bindings;
+			for (uint32_t i = 0; i < 4; i++) {
+				bindings.push_back({
+					.binding = i,
+					.descriptorType = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+					.descriptorCount = 1,
+					.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT
+				});
+			}
+			mCullDescSetLayout = std::make_shared<AdVKDescriptorSetLayout>(device, bindings);
+		}
+
+		// 剔除计算管线
+		{
+			VkPushConstantRange cullPC = {
+				.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT,
+				.offset = 0,
+				.size = sizeof(GpuCullPC)
+			};
+			ShaderLayout shaderLayout = {
+				.descriptorSetLayouts = { mCullDescSetLayout->GetHandle() },
+				.pushConstants = { cullPC }
+			};
+			mCullPipeline = std::make_shared<AdVKComputePipeline>(device, AD_RES_SHADER_DIR"05_gpu_cull.comp", shaderLayout);
+		}
+
+		// 图形管线：模型矩阵与材质索引都来自实例SSBO，只需要逐顶点输入
+		// 每种顶点布局一条管线(布局见 AdMesh::GetVertexInputState)，Float 与 Model 的着色器输入相同，共用同一管线布局
+		ShaderLayout shaderLayout = {
+			.descriptorSetLayouts = { mDrawDescSetLayout->GetHandle(), device->GetBindlessTable()->GetDescriptorSetLayout()->GetHandle() }
+		};
+		mPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
+			AD_RES_SHADER_DIR"05_gpu_driven.vert",
+			AD_RES_SHADER_DIR"05_gpu_driven.frag",
+			shaderLayout);
+		mPackedPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
+			AD_RES_SHADER_DIR"05_gpu_driven_packed.vert",
+			AD_RES_SHADER_DIR"05_gpu_driven.frag",
+			shaderLayout);
+
+		for (uint32_t i = 0; i < AD_VERTEX_FORMAT_COUNT; i++) {
+			AdVertexFormat format = static_cast<AdVertexFormat>(i);
+			std::vector<VkVertexInputBindingDescription> vertexBindings(1);
+			std::vector<VkVertexInputAttributeDescription> vertexAttrs;
+			AdMesh::GetVertexInputState(format, &vertexBindings[0], vertexAttrs);
+
+			AdVKPipelineLayout* pipelineLayout = format == AdVertexFormat::Packed ? mPackedPipelineLayout.get() : mPipelineLayout.get();
+			mPipelines[i] = std::make_shared<AdVKPipeline>(device, renderPass, pipelineLayout);
+			mPipelines[i]->SetVertexInputState(vertexBindings, vertexAttrs);
+			mPipelines[i]->EnableDepthTest();
+			mPipelines[i]->SetDynamicState({ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR });
+			mPipelines[i]->SetMultisampleState(VK_SAMPLE_COUNT_4_BIT, VK_FALSE);
+			mPipelines[i]->SetSubPassIndex(0);
+			// 管线在工作线程上编译，完成前跳过对应布局的绘制组
+			mPipelines[i]->CreateAsync();
+		}
+
+		// 每帧数据的环形缓冲区与间接绘制缓冲
+		uint32_t framesInFlight = GetFramesInFlight();
+		mUniformRing = std::make_shared<AdVKRingBuffer>(device, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			sizeof(FrameUbo) + NUM_GPU_DRIVEN_MATERIAL_BATCH * sizeof(UnlitMaterialGpuData), framesInFlight);
+		mInstanceRing = std::make_shared<AdVKRingBuffer>(device, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			NUM_GPU_DRIVEN_INSTANCE_BATCH * sizeof(GpuInstanceData), framesInFlight);
+		mMeshRing = std::make_shared<AdVKRingBuffer>(device, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+			NUM_GPU_DRIVEN_MESH_BATCH * sizeof(GpuMeshData), framesInFlight);
+		mFrameResources.resize(framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++) {
+			EnsureFrameResources(i, NUM_GPU_DRIVEN_INSTANCE_BATCH, 1);
+		}
+
+		AdVKDescriptorAllocator* descAllocator = device->GetDescriptorAllocator();
+		mDrawDescSets = descAllocator->Allocate(mDrawDescSetLayout.get(), framesInFlight);
+		mCullDescSets = descAllocator->Allocate(mCullDescSetLayout.get(), framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++) {
+			UpdateFrameDescSets(i);
+		}
+
+		// 默认纹理与采样器，代替缺失或仍在上传中的材质纹理
+		std::unique_ptr<RGBAColor> whitePixel = std::make_unique<RGBAColor>(255, 255, 255, 255);
+		mDefaultTexture = std::make_shared<AdTexture>(1, 1, whitePixel.get());
+		mDefaultTexture->WaitReady();
+		mDefaultSampler = std::make_shared<AdSampler>();
+	}
+
+	/**
+	 * @brief 渲染通道开始前：写入本帧实例数据与网格表，录制视锥体剔除并生成间接绘制命令。
+	 *
+	 * @param cmdBuffer Vulkan 命令缓冲区。
+	 * @param renderTarget 渲染目标对象，提供相机矩阵。
+	 */
+	void AdGpuDrivenMaterialSystem::OnPrepare(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) {
+		bFrameRecorded = false;
+		mDrawGroupCount = 0;
+		if (!bSupported || !GetScene()) {
+			return;
+		}
+		uint32_t frameIndex = GetCurrentFrameIndex();
+		// 当前槽位的围栏已触发，上一次在该槽位提交的剔除结果可以读取
+		ReadbackVisibleCount(frameIndex);
+
+		uint32_t materialCount = AdMaterialFactory::GetInstance()->GetMaterialSize<AdUnlitMaterial>();
+		if (materialCount == 0) {
+			return;
+		}
+		uint32_t allFramesMask = (1u << GetFramesInFlight()) - 1;
+		if (mMaterialDirtyFrames.size() < materialCount) {
+			mMaterialDirtyFrames.resize(materialCount, allFramesMask);
+			mMaterialVisitStamps.resize(materialCount, 0);
+		}
+
+		// 帧UBO之后是位置固定的材质区，槽位缓冲区重建后该槽位上的材质都要重新写入
+		bool bDescDirty = false;
+		VkDeviceSize uniformSize = mUniformRing->GetAlignedSize(sizeof(FrameUbo)) + materialCount * sizeof(UnlitMaterialGpuData);
+		if (mUniformRing->BeginFrame(frameIndex, uniformSize)) {
+			for (auto& mask : mMaterialDirtyFrames) {
+				mask |= 1u << frameIndex;
+			}
+			bDescDirty = true;
+		}
+
+		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
+		glm::mat4 projMat = GetProjMat(renderTarget);
+		glm::mat4 viewMat = GetViewMat(renderTarget);
+		FrameUbo frameUbo = {
+			.projMat = projMat,
+			.viewMat = viewMat,
+			.resolution = { frameBuffer->GetWidth(), frameBuffer->GetHeight() },
+			.frameId = static_cast<uint32_t>(GetApp()->GetFrameIndex()),
+			.time = GetApp()->GetStartTimeSecond()
+		};
+		uint32_t materialOffset = 0;
+		void* materialData = nullptr;
+		if (!mUniformRing->Push(frameUbo, &mFrameUboOffset)
+			|| !mUniformRing->Allocate(materialCount * sizeof(UnlitMaterialGpuData), &materialOffset, &materialData)) {
+			return;
+		}
+
+		// 收集实例并按顶点/索引区块分组
+		GatherInstances(materialData, frameIndex);
+		if (mDrawGroupCount == 0) {
+			return;
+		}
+
+		// 各绘制组的实例连续写入实例SSBO，命令缓冲中每组占用与实例数相同的区间
+		uint32_t instanceCount = 0;
+		for (uint32_t i = 0; i < mDrawGroupCount; i++) {
+			mDrawGroups[i].instanceBase = instanceCount;
+			instanceCount += static_cast<uint32_t>(mDrawGroups[i].instances.size());
+		}
+		VkDeviceSize instanceDataSize = instanceCount * sizeof(GpuInstanceData);
+		VkDeviceSize meshDataSize = mMeshData.size() * sizeof(GpuMeshData);
+		bDescDirty |= mInstanceRing->BeginFrame(frameIndex, instanceDataSize);
+		bDescDirty |= mMeshRing->BeginFrame(frameIndex, meshDataSize);
+		bDescDirty |= EnsureFrameResources(frameIndex, instanceCount, mDrawGroupCount);
+		if (bDescDirty) {
+			UpdateFrameDescSets(frameIndex);
+		}
+
+		uint32_t instanceOffset = 0;
+		void* instanceData = nullptr;
+		uint32_t meshOffset = 0;
+		void* meshData = nullptr;
+		if (!mInstanceRing->Allocate(instanceDataSize, &instanceOffset, &instanceData)
+			|| !mMeshRing->Allocate(meshDataSize, &meshOffset, &meshData)) {
+			mDrawGroupCount = 0;
+			return;
+		}
+		for (uint32_t i = 0; i < mDrawGroupCount; i++) {
+			const DrawGroup& group = mDrawGroups[i];
+			memcpy(static_cast<GpuInstanceData*>(instanceData) + group.instanceBase, group.instances.data(), group.instances.size() * sizeof(GpuInstanceData));
+		}
+		memcpy(meshData, mMeshData.data(), meshDataSize);
+
+		// 清零绘制数量；没有 drawIndirectCount 时按最大数量绘制，未写入的命令需清零为空绘制
+		FrameResources& res = mFrameResources[frameIndex];
+		VkBuffer commandBuffer = res.commandBuffer->GetHandle();
+		VkBuffer countBuffer = res.countBuffer->GetHandle();
+		vkCmdFillBuffer(cmdBuffer, countBuffer, 0, mDrawGroupCount * sizeof(uint32_t), 0);
+		if (!bDrawIndirectCount) {
+			vkCmdFillBuffer(cmdBuffer, commandBuffer, 0, instanceCount * sizeof(VkDrawIndexedIndirectCommand), 0);
+		}
+		VkMemoryBarrier clearBarrier = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT
+		};
+		vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+			0, 1, &clearBarrier, 0, nullptr, 0, nullptr);
+
+		// 每个绘制组一次调度，每个线程剔除一个实例
+		mCullPipeline->Bind(cmdBuffer);
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mCullPipeline->GetLayout(),
+			0, 1, &mCullDescSets[frameIndex], 0, nullptr);
+		GpuCullPC cullPC = {};
+		AdFrustum frustum = AdFrustum::FromViewProj(projMat * viewMat);
+		memcpy(cullPC.frustumPlanes, frustum.planes, sizeof(cullPC.frustumPlanes));
+		for (uint32_t i = 0; i < mDrawGroupCount; i++) {
+			const DrawGroup& group = mDrawGroups[i];
+			cullPC.instanceBase = group.instanceBase;
+			cullPC.instanceCount = static_cast<uint32_t>(group.instances.size());
+			cullPC.commandBase = group.instanceBase;
+			cullPC.countIndex = i;
+			vkCmdPushConstants(cmdBuffer, mCullPipeline->GetLayout(), VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(cullPC), &cullPC);
+			vkCmdDispatch(cmdBuffer, (cullPC.instanceCount + GPU_CULL_WORKGROUP_SIZE - 1) / GPU_CULL_WORKGROUP_SIZE, 1, 1);
+		}
+
+		// 剔除结果供间接绘制读取，同时复制绘制数量到主机可见缓冲用于统计
+		VkMemoryBarrier cullBarrier = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_TRANSFER_READ_BIT
+		};
+		vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, 1, &cullBarrier, 0, nullptr, 0, nullptr);
+		VkBufferCopy countCopy = {
+			.srcOffset = 0,
+			.dstOffset = 0,
+			.size = mDrawGroupCount * sizeof(uint32_t)
+		};
+		vkCmdCopyBuffer(cmdBuffer, countBuffer, res.readbackBuffer->GetHandle(), 1, &countCopy);
+		VkMemoryBarrier readbackBarrier = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_HOST_READ_BIT
+		};
+		vkCmdPipelineBarrier(cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_HOST_BIT,
+			0, 1, &readbackBarrier, 0, nullptr, 0, nullptr);
+
+		res.submittedGroupCount = mDrawGroupCount;
+		res.submittedInstanceCount = instanceCount;
+		res.bPendingReadback = true;
+		bFrameRecorded = true;
+	}
+
+	/**
+	 * @brief 录制间接绘制：每个绘制组绑定一次顶点/索引区块，绘制数量由剔除结果决定。
+	 *
+	 * @param cmdBuffer Vulkan 命令缓冲区。
+	 * @param renderTarget 渲染目标对象，包含帧缓冲等信息。
+	 */
+	void AdGpuDrivenMaterialSystem::OnRender(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) {
+		if (!bFrameRecorded) {
+			return;
+		}
+		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
+		VkViewport viewport = {
+			.x = 0,
+			.y = 0,
+			.width = static_cast<float>(frameBuffer->GetWidth()),
+			.height = static_cast<float>(frameBuffer->GetHeight()),
+			.minDepth = 0.f,
+			.maxDepth = 1.f
+		};
+		vkCmdSetViewport(cmdBuffer, 0, 1, &viewport);
+		VkRect2D scissor = {
+			.offset = { 0, 0 },
+			.extent = { frameBuffer->GetWidth(), frameBuffer->GetHeight() }
+		};
+		vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
+
+		uint32_t frameIndex = GetCurrentFrameIndex();
+		VkDescriptorSet descriptorSets[] = { mDrawDescSets[frameIndex], GetDevice()->GetBindlessTable()->GetDescriptorSet() };
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout->GetHandle(),
+			0, ARRAY_SIZE(descriptorSets), descriptorSets, 1, &mFrameUboOffset);
+
+		// 各布局的管线布局兼容，切换管线后描述符集保持有效；管线仍在编译时跳过该布局的绘制组
+		const FrameResources& res = mFrameResources[frameIndex];
+		VkBuffer commandBuffer = res.commandBuffer->GetHandle();
+		VkBuffer countBuffer = res.countBuffer->GetHandle();
+		AdVKPipeline* boundPipeline = nullptr;
+		for (uint32_t i = 0; i < mDrawGroupCount; i++) {
+			const DrawGroup& group = mDrawGroups[i];
+			AdVKPipeline* pipeline = mPipelines[static_cast<uint32_t>(group.format)].get();
+			if (pipeline != boundPipeline) {
+				if (!pipeline->Bind(cmdBuffer)) {
+					continue;
+				}
+				boundPipeline = pipeline;
+			}
+			VkDeviceSize vertexOffset = 0;
+			vkCmdBindVertexBuffers(cmdBuffer, 0, 1, &group.vertexBuffer, &vertexOffset);
+			vkCmdBindIndexBuffer(cmdBuffer, group.indexBuffer, 0, VK_INDEX_TYPE_UINT32);
+
+			uint32_t maxDrawCount = std::min(static_cast<uint32_t>(group.instances.size()), mMaxDrawIndirectCount);
+			VkDeviceSize commandOffset = group.instanceBase * sizeof(VkDrawIndexedIndirectCommand);
+			if (bDrawIndirectCount) {
+				vkCmdDrawIndexedIndirectCount(cmdBuffer, commandBuffer, commandOffset, countBuffer, i * sizeof(uint32_t),
+					maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
+			} else {
+				vkCmdDrawIndexedIndirect(cmdBuffer, commandBuffer, commandOffset, maxDrawCount, sizeof(VkDrawIndexedIndirectCommand));
+			}
+		}
+	}
+
+	/**
+	 * @brief 销毁GPU驱动材质系统资源。
+	 */
+	void AdGpuDrivenMaterialSystem::OnDestroy() {
+		if (!bSupported) {
+			return;
+		}
+		// 销毁前设备已空闲，描述符集归还给共享分配器供其它系统复用
+		AdVKDescriptorAllocator* descAllocator = GetDevice()->GetDescriptorAllocator();
+		descAllocator->Free(mDrawDescSetLayout.get(), mDrawDescSets);
+		descAllocator->Free(mCullDescSetLayout.get(), mCullDescSets);
+		mDrawDescSets.clear();
+		mCullDescSets.clear();
+
+		mFrameResources.clear();
+		mUniformRing.reset();
+		mInstanceRing.reset();
+		mMeshRing.reset();
+		mCullPipeline.reset();
+		for (auto& pipeline : mPipelines) {
+			pipeline.reset();
+		}
+		mPackedPipelineLayout.reset();
+		mPipelineLayout.reset();
+	}
+
+	/**
+	 * @brief 遍历实体收集实例：按网格所在的顶点/索引区块分组，建立本帧网格表，并写入变化的材质数据。
+	 *
+	 * @param materialData 当前帧槽位环形缓冲区中材质区的映射地址，材质i位于 i * sizeof(UnlitMaterialGpuData)。
+	 * @param frameIndex 当前帧槽位索引。
+	 */
+	void AdGpuDrivenMaterialSystem::GatherInstances(void* materialData, uint32_t frameIndex) {
+		entt::registry& reg = GetScene()->GetEcsRegistry();
+		auto view = reg.view<AdTransformComponent, AdUnlitMaterialComponent>();
+
+		uint32_t allFramesMask = (1u << GetFramesInFlight()) - 1;
+		uint32_t frameBit = 1u << frameIndex;
+		mVisitStamp++;
+		mMeshData.clear();
+		mMeshIndices.clear();
+
+		AdTransformSystem* transformSystem = GetScene()->GetTransformSystem();
+		view.each([&](AdTransformComponent& transComp, AdUnlitMaterialComponent& materialComp) {
+			glm::mat4 transform = transformSystem->GetWorldMatrix(transComp);
+			for (const auto& entry : materialComp.GetMeshMaterials()) {
+				AdUnlitMaterial* material = entry.first;
+				if (!material || material->GetIndex() < 0) {
+					continue;
+				}
+				uint32_t materialIndex = material->GetIndex();
+
+				// 每个材质每帧只检查一次：变化时标记所有帧槽位，当前槽位仍为脏时写入
+				if (mMaterialVisitStamps[materialIndex] != mVisitStamp) {
+					mMaterialVisitStamps[materialIndex] = mVisitStamp;
+					if (material->ShouldFlushResource()) {
+						mMaterialDirtyFrames[materialIndex] |= allFramesMask;
+						material->FinishFlushResource();
+					}
+					if (material->ShouldFlushParams()) {
+						mMaterialDirtyFrames[materialIndex] |= allFramesMask;
+						material->FinishFlushParams();
+					}
+					if (mMaterialDirtyFrames[materialIndex] & frameBit) {
+						void* dst = static_cast<uint8_t*>(materialData) + materialIndex * sizeof(UnlitMaterialGpuData);
+						if (WriteMaterialGpuData(material, dst)) {
+							mMaterialDirtyFrames[materialIndex] &= ~frameBit;
+						}
+					}
+				}
+
+				for (const auto& meshIndex : entry.second) {
+					// 间接绘制只支持有索引的网格；几何数据仍在上传时跳过
+					AdMesh* mesh = materialComp.GetMesh(meshIndex);
+					if (!mesh || !mesh->IsReady() || mesh->GetAllocation().indexCount == 0) {
+						continue;
+					}
+					// 量化网格的解量化变换并入实例矩阵，包围球相应换算到量化空间，剔除结果不变
+					AdVertexFormat format = mesh->GetVertexFormat();
+					bool bPacked = format == AdVertexFormat::Packed;
+					auto [it, bInserted] = mMeshIndices.try_emplace(mesh, static_cast<uint32_t>(mMeshData.size()));
+					if (bInserted) {
+						const AdMeshAllocation& allocation = mesh->GetAllocation();
+						glm::vec4 boundingSphere = mesh->GetBoundingSphere();
+						if (bPacked) {
+							const glm::vec4& dequantize = mesh->GetDequantize();
+							boundingSphere = glm::vec4((glm::vec3(boundingSphere) - glm::vec3(dequantize)) / dequantize.w, boundingSphere.w / dequantize.w);
+						}
+						mMeshData.push_back({
+							.boundingSphere = boundingSphere,
+							.indexCount = allocation.indexCount,
+							.firstIndex = allocation.firstIndex,
+							.vertexOffset = static_cast<int32_t>(allocation.vertexOffset)
+						});
+					}
+					DrawGroup* group = FindDrawGroup(mesh->GetVertexBuffer(), mesh->GetIndexBuffer(), format);
+					group->instances.push_back({
+						.modelMat = bPacked ? transform * mesh->GetDequantizeTransform() : transform,
+						.meshIndex = it->second,
+						.materialIndex = materialIndex
+					});
+				}
+			}
+		});
+	}
+
+	AdGpuDrivenMaterialSystem::DrawGroup* AdGpuDrivenMaterialSystem::FindDrawGroup(VkBuffer vertexBuffer, VkBuffer indexBuffer, AdVertexFormat format) {
+		// AdVertex 与 ModelVertex 步长相同，可能位于同一区块，绘制组还需按顶点布局区分
+		for (uint32_t i = 0; i < mDrawGroupCount; i++) {
+			if (mDrawGroups[i].vertexBuffer == vertexBuffer && mDrawGroups[i].indexBuffer == indexBuffer && mDrawGroups[i].format == format) {
+				return &mDrawGroups[i];
+			}
+		}
+		// 复用上一帧的绘制组以保留其实例数组容量
+		if (mDrawGroupCount == mDrawGroups.size()) {
+			mDrawGroups.emplace_back();
+		}
+		DrawGroup* group = &mDrawGroups[mDrawGroupCount++];
+		group->vertexBuffer = vertexBuffer;
+		group->indexBuffer = indexBuffer;
+		group->format = format;
+		group->instanceBase = 0;
+		group->instances.clear();
+		return group;
+	}
+
+	/**
+	 * @brief 保证帧槽位的间接命令与绘制数量缓冲足够容纳本帧的实例与绘制组，不足时按倍数扩容。
+	 *
+	 * 调用时该槽位的围栏已被等待，旧缓冲区不再被GPU使用。
+	 *
+	 * @return 是否重建了缓冲区（需要重写该槽位的描述符集）。
+	 */
+	bool AdGpuDrivenMaterialSystem::EnsureFrameResources(uint32_t frameIndex, uint32_t instanceCount, uint32_t groupCount) {
+		AdVKDevice* device = GetDevice();
+		FrameResources& res = mFrameResources[frameIndex];
+		bool bRecreated = false;
+		if (instanceCount > res.commandCapacity) {
+			uint32_t capacity = std::max(res.commandCapacity, static_cast<uint32_t>(NUM_GPU_DRIVEN_INSTANCE_BATCH));
+			while (capacity < instanceCount) {
+				capacity *= 2;
+			}
+			res.commandBuffer = std::make_shared<AdVKBuffer>(device, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+				capacity * sizeof(VkDrawIndexedIndirectCommand));
+			res.commandCapacity = capacity;
+			bRecreated = true;
+		}
+		if (groupCount > res.groupCapacity) {
+			uint32_t capacity = std::max(res.groupCapacity, 8u);
+			while (capacity < groupCount) {
+				capacity *= 2;
+			}
+			res.countBuffer = std::make_shared<AdVKBuffer>(device, VK_BUFFER_USAGE_STORAGE_BUFFER_BIT | VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+				capacity * sizeof(uint32_t));
+			res.readbackBuffer = std::make_shared<AdVKBuffer>(device, VK_BUFFER_USAGE_TRANSFER_DST_BIT, capacity * sizeof(uint32_t), nullptr, true);
+			res.groupCapacity = capacity;
+			bRecreated = true;
+		}
+		return bRecreated;
+	}
+
+	/**
+	 * @brief 将指定帧槽位的绘制与剔除描述符集指向该槽位的环形缓冲区与间接绘制缓冲。
+	 *
+	 * 只在初始化和缓冲区重建时调用。
+	 */
+	void AdGpuDrivenMaterialSystem::UpdateFrameDescSets(uint32_t frameIndex) {
+		const FrameResources& res = mFrameResources[frameIndex];
+		VkBuffer uniformBuffer = mUniformRing->GetHandle(frameIndex);
+		VkDescriptorBufferInfo frameInfo = DescriptorSetWriter::BuildBufferInfo(uniformBuffer, 0, sizeof(FrameUbo));
+		VkDescriptorBufferInfo materialInfo = DescriptorSetWriter::BuildBufferInfo(uniformBuffer, mUniformRing->GetAlignedSize(sizeof(FrameUbo)), VK_WHOLE_SIZE);
+		VkDescriptorBufferInfo instanceInfo = DescriptorSetWriter::BuildBufferInfo(mInstanceRing->GetHandle(frameIndex), 0, VK_WHOLE_SIZE);
+		VkDescriptorBufferInfo meshInfo = DescriptorSetWriter::BuildBufferInfo(mMeshRing->GetHandle(frameIndex), 0, VK_WHOLE_SIZE);
+		VkDescriptorBufferInfo commandInfo = DescriptorSetWriter::BuildBufferInfo(res.commandBuffer->GetHandle(), 0, VK_WHOLE_SIZE);
+		VkDescriptorBufferInfo countInfo = DescriptorSetWriter::BuildBufferInfo(res.countBuffer->GetHandle(), 0, VK_WHOLE_SIZE);
+
+		VkDescriptorSet drawDescSet = mDrawDescSets[frameIndex];
+		VkDescriptorSet cullDescSet = mCullDescSets[frameIndex];
+		DescriptorSetWriter::UpdateDescriptorSets(GetDevice()->GetHandle(), {
+			DescriptorSetWriter::WriteBuffer(drawDescSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, &frameInfo),
+			DescriptorSetWriter::WriteBuffer(drawDescSet, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &instanceInfo),
+			DescriptorSetWriter::WriteBuffer(drawDescSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &materialInfo),
+			DescriptorSetWriter::WriteBuffer(cullDescSet, 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &instanceInfo),
+			DescriptorSetWriter::WriteBuffer(cullDescSet, 1, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &meshInfo),
+			DescriptorSetWriter::WriteBuffer(cullDescSet, 2, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &commandInfo),
+			DescriptorSetWriter::WriteBuffer(cullDescSet, 3, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &countInfo)
+		});
+	}
+
+	/**
+	 * @brief 读取该帧槽位上一次提交的剔除结果：各绘制组的可见实例数之和。
+	 */
+	void AdGpuDrivenMaterialSystem::ReadbackVisibleCount(uint32_t frameIndex) {
+		FrameResources& res = mFrameResources[frameIndex];
+		if (!res.bPendingReadback) {
+			return;
+		}
+		const uint32_t* counts = static_cast<const uint32_t*>(res.readbackBuffer->GetMappedData());
+		uint32_t visibleCount = 0;
+		for (uint32_t i = 0; i < res.submittedGroupCount; i++) {
+			visibleCount += counts[i];
+		}
+		mCompletedTotalCount = res.submittedInstanceCount;
+		mCompletedVisibleCount = visibleCount;
+		res.bPendingReadback = false;
+	}
+
+	/**
+	 * @brief 写入材质的GPU数据（参数与无绑定纹理索引）到材质区中该材质的固定位置。
+	 *
+	 * @return 材质的纹理是否都已就绪；返回false表示有纹理暂时以默认纹理代替，之后需要再次写入。
+	 */
+	bool AdGpuDrivenMaterialSystem::WriteMaterialGpuData(AdUnlitMaterial* material, void* dst) {
+		UnlitMaterialGpuData data = {};
+		data.params = material->GetParams();
+
+		bool bPending = false;
+		const std::pair<UnlitMaterialTexture, TextureParam*> textureParams[] = {
+			{ UNLIT_MAT_BASE_COLOR_0, &data.params.textureParam0 },
+			{ UNLIT_MAT_BASE_COLOR_1, &data.params.textureParam1 }
+		};
+		for (uint32_t i = 0; i < ARRAY_SIZE(textureParams); i++) {
+			uint32_t textureIndex = mDefaultTexture->GetBindlessIndex();
+			uint32_t samplerIndex = mDefaultSampler->GetBindlessIndex();
+			const TextureView* texture = material->GetTextureView(textureParams[i].first);
+			if (texture) {
+				AdMaterial::UpdateTextureParams(texture, textureParams[i].second);
+				if (texture->texture && texture->sampler) {
+					if (texture->texture->IsReady()) {
+						textureIndex = texture->texture->GetBindlessIndex();
+						samplerIndex = texture->sampler->GetBindlessIndex();
+					} else {
+						bPending = true;
+					}
+				}
+			}
+			data.textureIndices[i * 2] = textureIndex;
+			data.textureIndices[i * 2 + 1] = samplerIndex;
+		}
+
+		memcpy(dst, &data, sizeof(data));
+		return !bPending;
+	}
+}
@@ -54,6 +54,36 @@ namespace WuDu {
 		return nullptr;
 	}
 
+	/**
+	 * @brief 获取帧并行深度
+	 *
+	 * 材质系统中每帧会被GPU读取的资源（帧UBO、材质UBO、描述符集）需按此数量分配多份。
+	 *
+	 * @return uint32_t 帧并行数量，若渲染上下文无效则返回1
+	 */
+	uint32_t AdMaterialSystem::GetFramesInFlight() const {
+		AdAppContext* appContext = AdApplication::GetAppContext();
+		if (appContext && appContext->renderCxt) {
+			return appContext->renderCxt->GetFramesInFlight();
+		}
+		return 1;
+	}
+
+	/**
+	 * @brief 获取当前帧槽位索引
+	 *
+	 * 由AdRenderer::Begin在等待对应帧围栏后设置，此时该槽位的资源已不再被GPU使用，可以安全写入。
+	 *
+	 * @return uint32_t 当前帧槽位索引，范围[0, GetFramesInFlight())
+	 */
+	uint32_t AdMaterialSystem::GetCurrentFrameIndex() const {
+		AdAppContext* appContext = AdApplication::GetAppContext();
+		if (appContext && appContext->renderCxt) {
+			return appContext->renderCxt->GetCurrentFrameIndex();
+		}
+		return 0;
+	}
+
 	/**
 	 * @brief 获取指定渲染目标的投影矩阵
 	 *
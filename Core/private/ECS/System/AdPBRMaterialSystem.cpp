@@ -6,6 +6,7 @@
 #include "Graphic/AdVKDescriptorSet.h"
 #include "Graphic/AdVKImageView.h"
 #include "Graphic/AdVKFrameBuffer.h"
+#include "Graphic/AdVKRingBuffer.h"
 
 #include "Render/AdRenderTarget.h"
 
@@ -21,7 +22,7 @@ namespace WuDu {
 			const std::vector<VkDescriptorSetLayoutBinding> bindings = {
 				{
 					.binding = 0,
-					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 					.descriptorCount = 1,
 					.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
 				}
@@ -32,7 +33,7 @@ namespace WuDu {
 			const std::vector<VkDescriptorSetLayoutBinding> bindings = {
 				{
 					.binding = 0,
-					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 					.descriptorCount = 1,
 					.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
 				}
@@ -127,26 +128,31 @@ namespace WuDu {
 		mPipeline->SetDynamicState({ VK_DYNAMIC_STATE_VIEWPORT,VK_DYNAMIC_STATE_SCISSOR });
 		mPipeline->SetMultisampleState(VK_SAMPLE_COUNT_4_BIT, VK_FALSE);
 		mPipeline->SetSubPassIndex(0);
-		mPipeline->Create();
+		//管线在工作线程上编译，完成前跳过绘制
+		mPipeline->CreateAsync();
 
-		//创建渲染管线的每帧UBO相关资源
-		std::vector<VkDescriptorPoolSize> poolSizes = {
-			{
-				.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-				.descriptorCount = 1
-			}
-		};
-		mDescriptorPool = std::make_shared<AdVKDescriptorPool>(device, 1, poolSizes);
-		mFrameUboDescSet = mDescriptorPool->AllocateDescriptorSet(mFrameUboDescSetLayout.get(), 1)[0];
-		mFrameUboBuffer = std::make_shared<AdVKBuffer>(device, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(FrameUbo), nullptr, true);
+		//创建每帧的环形Uniform缓冲区，帧UBO与材质参数以动态偏移绑定
+		uint32_t framesInFlight = GetFramesInFlight();
+		mUniformRing = std::make_shared<AdVKRingBuffer>(device, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
+			sizeof(FrameUbo) + NUM_MATERIAL_BATCH * 256, framesInFlight);
+
+		//从共享的描述符分配器中为每个帧槽位分配动态描述符集
+		AdVKDescriptorAllocator* descAllocator = device->GetDescriptorAllocator();
+		mFrameUboDescSets = descAllocator->Allocate(mFrameUboDescSetLayout.get(), framesInFlight);
+		mMaterialParamDescSets = descAllocator->Allocate(mMaterialParamDescSetLayout.get(), framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++) {
+			UpdateUniformDescSets(i);
+		}
 
-		//初始化材质描述符池
-		ReCreateMaterialDescPool(NUM_MATERIAL_BATCH);
+		//初始分配一批材质描述符集
+		GrowMaterialDescSets(NUM_MATERIAL_BATCH);
 
 		//创建默认纹理
 		//std::unique_ptr<RGBAColor> whitePixel = std::make_unique<RGBAColor>(255, 255, 255, 255);
 		RGBAColor pixel { 255, 255, 255, 255 };
 		mDefaultTexture = std::make_shared<AdTexture>(1, 1, & pixel);
+		//默认纹理作为未就绪纹理的替代，必须立即可用
+		mDefaultTexture->WaitReady();
 
 		//创建默认采样器
 
@@ -167,8 +173,10 @@ namespace WuDu {
 			return;
 		}
 
-		//将图形渲染管线绑定到命令缓冲区
-		mPipeline->Bind(cmdBuffer);
+		//将图形渲染管线绑定到命令缓冲区，管线仍在编译时跳过本帧绘制
+		if(!mPipeline->Bind(cmdBuffer)){
+			return;
+		}
 		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
 		VkViewport viewport = {
 			.x = 0,
@@ -186,23 +194,86 @@ namespace WuDu {
 		};
 		vkCmdSetScissor(cmdBuffer,0,1,&scissor);
 
-		//更新每帧UBO描述符集
-		UpdateFrameUboDescSet(renderTarget);
-
-		//检查是否需要重建材质描述符池
-		bool bShouldForceUpdateMaterial = false;
+		//材质数量超过已分配的描述符集时追加分配，已有的描述符集不受影响
 		uint32_t materialCount = AdMaterialFactory::GetInstance()->GetMaterialSize<AdPBRMaterial>();
 		if(materialCount > mLastDescriptorSetCount){
-			ReCreateMaterialDescPool(materialCount);
-			bShouldForceUpdateMaterial = true;
+			GrowMaterialDescSets(materialCount);
 		}
 
-		//按材质实体批次渲染
-		std::vector<bool> updateFlags(materialCount);
-		view.each([this, &updateFlags, &bShouldForceUpdateMaterial, &cmdBuffer](AdTransformComponent& transComp,AdPBRMaterialComponent& materialComp){
-			for(const auto& entry : materialComp.GetMeshMaterials()){
-				AdPBRMaterial* material = entry.first;
-			}
-		});
+		//开始当前帧槽位的环形缓冲区并写入每帧UBO；PBR 着色器尚未接入，本系统暂不绘制，也不写入材质参数
+		uint32_t frameIndex = GetCurrentFrameIndex();
+		if (mUniformRing->BeginFrame(frameIndex, mUniformRing->GetAlignedSize(sizeof(FrameUbo)))) {
+			UpdateUniformDescSets(frameIndex);
+		}
+		uint32_t frameUboOffset = PushFrameUbo(renderTarget);
+		VkDescriptorSet frameUboDescSet = mFrameUboDescSets[frameIndex];
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout->GetHandle(),
+			0, 1, &frameUboDescSet, 1, &frameUboOffset);
+	}
+
+	//销毁PBR材质系统资源，设备已空闲，描述符集归还给共享分配器
+	void AdPBRMaterialSystem::OnDestroy() {
+		AdVKDescriptorAllocator* descAllocator = GetDevice()->GetDescriptorAllocator();
+		descAllocator->Free(mFrameUboDescSetLayout.get(), mFrameUboDescSets);
+		descAllocator->Free(mMaterialParamDescSetLayout.get(), mMaterialParamDescSets);
+		for (const auto& descSets : mMaterialResourceDescSets) {
+			descAllocator->Free(mMaterialResourceDescSetLayout.get(), descSets);
+		}
+		mFrameUboDescSets.clear();
+		mMaterialParamDescSets.clear();
+		mMaterialResourceDescSets.clear();
+		mLastDescriptorSetCount = 0;
+
+		mPipeline.reset();
+		mPipelineLayout.reset();
+	}
+
+	//从共享的描述符分配器中为每个帧槽位追加材质资源描述符集，已有的描述符集保持有效
+	void AdPBRMaterialSystem::GrowMaterialDescSets(uint32_t materialCount) {
+		AdVKDescriptorAllocator* descAllocator = GetDevice()->GetDescriptorAllocator();
+
+		uint32_t newDescriptorSetCount = (materialCount + NUM_MATERIAL_BATCH - 1) / NUM_MATERIAL_BATCH * NUM_MATERIAL_BATCH;
+		LOG_D("{0}: {1} -> {2}", __FUNCTION__, mLastDescriptorSetCount, newDescriptorSetCount);
+
+		uint32_t framesInFlight = GetFramesInFlight();
+		mMaterialResourceDescSets.resize(framesInFlight);
+		for (uint32_t frame = 0; frame < framesInFlight; frame++) {
+			std::vector<VkDescriptorSet> descSets = descAllocator->Allocate(mMaterialResourceDescSetLayout.get(), newDescriptorSetCount - mLastDescriptorSetCount);
+			assert(descSets.size() == newDescriptorSetCount - mLastDescriptorSetCount && "Failed to AllocateDescriptorSet");
+			mMaterialResourceDescSets[frame].insert(mMaterialResourceDescSets[frame].end(), descSets.begin(), descSets.end());
+		}
+		mLastDescriptorSetCount = newDescriptorSetCount;
+	}
+
+	//当前帧槽位的环形缓冲区重建后，重写引用它的Uniform描述符集
+	void AdPBRMaterialSystem::UpdateUniformDescSets(uint32_t frameIndex) {
+		AdVKDevice* device = GetDevice();
+		VkBuffer ringBuffer = mUniformRing->GetHandle(frameIndex);
+
+		VkDescriptorBufferInfo frameBufferInfo = DescriptorSetWriter::BuildBufferInfo(ringBuffer, 0, sizeof(FrameUbo));
+		VkDescriptorBufferInfo paramsBufferInfo = DescriptorSetWriter::BuildBufferInfo(ringBuffer, 0, sizeof(PBRMaterialUbo));
+		VkWriteDescriptorSet frameWrite = DescriptorSetWriter::WriteBuffer(mFrameUboDescSets[frameIndex], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, &frameBufferInfo);
+		VkWriteDescriptorSet paramsWrite = DescriptorSetWriter::WriteBuffer(mMaterialParamDescSets[frameIndex], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, &paramsBufferInfo);
+		DescriptorSetWriter::UpdateDescriptorSets(device->GetHandle(), { frameWrite, paramsWrite });
+	}
+
+	//写入帧UBO到环形缓冲区，返回动态偏移
+	uint32_t AdPBRMaterialSystem::PushFrameUbo(AdRenderTarget* renderTarget) {
+		AdApplication* app = GetApp();
+
+		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
+		glm::ivec2 resolution = { frameBuffer->GetWidth(), frameBuffer->GetHeight() };
+
+		FrameUbo frameUbo = {
+			.projMat = GetProjMat(renderTarget),
+			.viewMat = GetViewMat(renderTarget),
+			.resolution = resolution,
+			.frameId = static_cast<uint32_t>(app->GetFrameIndex()),
+			.time = app->GetStartTimeSecond()
+		};
+
+		uint32_t offset = 0;
+		mUniformRing->Push(frameUbo, &offset);
+		return offset;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,80 @@
+#include "ECS/System/AdTransformSystem.h"
+#include "ECS/AdScene.h"
+#include "ECS/AdEntity.h"
+
+namespace WuDu {
+	AdTransformSystem::AdTransformSystem(AdScene* scene) : mScene(scene) {
+	}
+
+	/**
+	 * @brief 更新世界矩阵：按父节点在前的顺序遍历，自身局部变换或父节点世界矩阵变化时才重算
+	 *
+	 * @param deltaTime 帧间隔（未使用）
+	 */
+	void AdTransformSystem::OnUpdate(float deltaTime) {
+		bool bOrderRebuilt = false;
+		if (mHierarchyVersion != AdNode::GetHierarchyVersion()) {
+			RebuildOrder();
+			bOrderRebuilt = true;
+		}
+
+		entt::registry& reg = mScene->GetEcsRegistry();
+		mUpdatedCount = 0;
+		for (uint32_t i = 0; i < mNodes.size(); i++) {
+			const TransformNode& node = mNodes[i];
+			AdTransformComponent* transComp = reg.try_get<AdTransformComponent>(node.entity);
+			bool bLocalChanged = transComp && transComp->UpdateLocalTransform();
+			bool bParentChanged = node.parent != AD_TRANSFORM_INVALID_INDEX && mWorldChanged[node.parent];
+			if (!bOrderRebuilt && !bLocalChanged && !bParentChanged) {
+				mWorldChanged[i] = 0;
+				continue;
+			}
+
+			// 没有变换组件的节点视为单位局部变换，直接继承父节点
+			glm::mat4 localMat = transComp ? transComp->GetLocalTransform() : glm::mat4(1.f);
+			mWorldMatrices[i] = node.parent != AD_TRANSFORM_INVALID_INDEX ? mWorldMatrices[node.parent] * localMat : localMat;
+			mWorldChanged[i] = 1;
+			mUpdatedCount++;
+		}
+	}
+
+	/**
+	 * @brief 从场景根节点深度优先展开节点树，保证父节点总在子节点之前，并为变换组件分配世界矩阵索引
+	 */
+	void AdTransformSystem::RebuildOrder() {
+		mHierarchyVersion = AdNode::GetHierarchyVersion();
+		entt::registry& reg = mScene->GetEcsRegistry();
+		// 已不在节点树中的实体不再持有有效索引
+		reg.view<AdTransformComponent>().each([](AdTransformComponent& transComp) {
+			transComp.mWorldIndex = AD_TRANSFORM_INVALID_INDEX;
+			});
+
+		mNodes.clear();
+		// 子节点逆序入栈，出栈顺序即为深度优先的先序
+		std::vector<std::pair<AdNode*, uint32_t>> stack;
+		for (AdNode* child = mScene->GetRootNode()->GetLastChild(); child; child = child->GetPrevSibling()) {
+			stack.emplace_back(child, AD_TRANSFORM_INVALID_INDEX);
+		}
+		while (!stack.empty()) {
+			auto [node, parent] = stack.back();
+			stack.pop_back();
+
+			// 非实体节点不占位置，其子节点直接挂到最近的实体祖先下
+			uint32_t childParent = parent;
+			AdEntity* entity = dynamic_cast<AdEntity*>(node);
+			if (entity && entity->IsValid()) {
+				childParent = static_cast<uint32_t>(mNodes.size());
+				mNodes.push_back({ entity->GetEcsEntity(), parent });
+				if (AdTransformComponent* transComp = reg.try_get<AdTransformComponent>(entity->GetEcsEntity())) {
+					transComp->mWorldIndex = childParent;
+				}
+			}
+			for (AdNode* child = node->GetLastChild(); child; child = child->GetPrevSibling()) {
+				stack.emplace_back(child, childParent);
+			}
+		}
+
+		mWorldMatrices.resize(mNodes.size(), glm::mat4(1.f));
+		mWorldChanged.resize(mNodes.size(), 0);
+	}
+}
@@ -6,10 +6,15 @@
 #include "Graphic/AdVKDescriptorSet.h"
 #include "Graphic/AdVKImageView.h"
 #include "Graphic/AdVKFrameBuffer.h"
+#include "Graphic/AdVKRingBuffer.h"
+#include "Graphic/AdVKBindlessTable.h"
 
 #include "Render/AdRenderTarget.h"
+#include "Render/AdRenderQueue.h"
+#include "Render/AdFrustumCuller.h"
 
 #include "ECS/Component/AdTransformComponent.h"
+#include "ECS/System/AdTransformSystem.h"
 
 namespace WuDu {
 	/**
@@ -19,13 +24,15 @@ namespace WuDu {
  */
 	void AdUnlitMaterialSystem::OnInit(AdVKRenderPass* renderPass) {
 		AdVKDevice* device = GetDevice();
+		// 设备支持 descriptor indexing 时走无绑定路径：材质参数放入SSBO，纹理通过全局无绑定表按索引访问
+		bBindless = device->IsBindlessSupported();
 
 		// 创建帧UBO描述符集布局：用于传递投影矩阵、视图矩阵等每帧不变的数据
 		{
 			const std::vector<VkDescriptorSetLayoutBinding> bindings = {
 				{
 					.binding = 0,
-					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+					.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 					.descriptorCount = 1,
 					.stageFlags = VK_SHADER_STAGE_VERTEX_BIT | VK_SHADER_STAGE_FRAGMENT_BIT,
 				}
@@ -34,11 +41,12 @@ namespace WuDu {
 		}
 
 		// 创建材质参数描述符集布局：用于传递材质参数（如颜色、纹理参数等）
+		// 无绑定路径下为所有材质参数组成的SSBO，否则为按材质动态偏移的UBO
 		{
 			const std::vector<VkDescriptorSetLayoutBinding> bindings = {
 			    {
 				.binding = 0,
-				.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
+				.descriptorType = bBindless ? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
 				.descriptorCount = 1,
 				.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
 			    }
@@ -46,8 +54,8 @@ namespace WuDu {
 			mMaterialParamDescSetLayout = std::make_shared<AdVKDescriptorSetLayout>(device, bindings);
 		}
 
-		// 创建材质资源描述符集布局：用于传递纹理采样器和图像视图
-		{
+		// 创建材质资源描述符集布局：用于传递纹理采样器和图像视图（无绑定路径不需要）
+		if (!bBindless) {
 			const std::vector<VkDescriptorSetLayoutBinding> bindings = {
 				{
 					.binding = 0,
@@ -65,90 +73,106 @@ namespace WuDu {
 			mMaterialResourceDescSetLayout = std::make_shared<AdVKDescriptorSetLayout>(device, bindings);
 		}
 
-		// 定义推送常量：用于传递模型变换矩阵
-		VkPushConstantRange modelPC = {
-		    .stageFlags = VK_SHADER_STAGE_VERTEX_BIT,
-		    .offset = 0,
-		    .size = sizeof(ModelPC)
-		};
-
 		// 构建着色器布局并创建管线布局
-		ShaderLayout shaderLayout = {
-		    .descriptorSetLayouts = { mFrameUboDescSetLayout->GetHandle(), mMaterialParamDescSetLayout->GetHandle(), mMaterialResourceDescSetLayout->GetHandle() },
-		    .pushConstants = { modelPC }
-		};
-		mPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
-			AD_RES_SHADER_DIR"03_unlit_material.vert",
-			AD_RES_SHADER_DIR"03_unlit_material.frag",
-			shaderLayout);
-
-		// 配置顶点输入格式：位置、纹理坐标、法线
-		std::vector<VkVertexInputBindingDescription> vertexBindings = {
-			{
-				.binding = 0,
-				.stride = sizeof(AdVertex),
-				.inputRate = VK_VERTEX_INPUT_RATE_VERTEX
-			}
-		};
-		std::vector<VkVertexInputAttributeDescription> vertexAttrs = {
-			{
-				.location = 0,                         // 属性位置 0：顶点位置
-				.binding = 0,                          // 来自绑定 0
-				.format = VK_FORMAT_R32G32B32_SFLOAT,  // 3个32位浮点数
-				.offset = offsetof(AdVertex, Position)      // 在 AdVertex 中的偏移
-			},
-			{
-				.location = 1,                         // 属性位置 1：纹理坐标
-				.binding = 0,
-				.format = VK_FORMAT_R32G32_SFLOAT,     // 2个32位浮点数
-				.offset = offsetof(AdVertex, TexCoord)
-			},
-			{
-				.location = 2,                     //法线    
-				.binding = 0,
-				.format = VK_FORMAT_R32G32B32_SFLOAT,  // 3个32位浮点数
-				.offset = offsetof(AdVertex, Normal)
-			},
-			{
-				.location = 3,                         
-				.binding = 0,
-				.format = VK_FORMAT_R32G32B32_SFLOAT,  // 3个32位浮点数
-				.offset = offsetof(AdVertex, Tangent)
-			},
-			{
-				.location = 4,                         
-				.binding = 0,
-				.format = VK_FORMAT_R32G32B32_SFLOAT,  // 3个32位浮点数
-				.offset = offsetof(AdVertex, Bitangent)
+		if (bBindless) {
+			// 推送常量：材质索引，片段着色器按索引读取材质SSBO
+			VkPushConstantRange materialPC = {
+			    .stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT,
+			    .offset = 0,
+			    .size = sizeof(BindlessMaterialPC)
+			};
+			ShaderLayout shaderLayout = {
+			    .descriptorSetLayouts = { mFrameUboDescSetLayout->GetHandle(), mMaterialParamDescSetLayout->GetHandle(), device->GetBindlessTable()->GetDescriptorSetLayout()->GetHandle() },
+			    .pushConstants = { materialPC }
+			};
+			mPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
+				AD_RES_SHADER_DIR"03_unlit_material_bindless.vert",
+				AD_RES_SHADER_DIR"03_unlit_material_bindless.frag",
+				shaderLayout);
+			mPackedPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
+				AD_RES_SHADER_DIR"03_unlit_material_packed.vert",
+				AD_RES_SHADER_DIR"03_unlit_material_bindless.frag",
+				shaderLayout);
+		} else {
+			// 模型变换矩阵来自实例数据，不再使用推送常量
+			ShaderLayout shaderLayout = {
+			    .descriptorSetLayouts = { mFrameUboDescSetLayout->GetHandle(), mMaterialParamDescSetLayout->GetHandle(), mMaterialResourceDescSetLayout->GetHandle() }
+			};
+			mPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
+				AD_RES_SHADER_DIR"03_unlit_material.vert",
+				AD_RES_SHADER_DIR"03_unlit_material.frag",
+				shaderLayout);
+			mPackedPipelineLayout = std::make_shared<AdVKPipelineLayout>(device,
+				AD_RES_SHADER_DIR"03_unlit_material_packed.vert",
+				AD_RES_SHADER_DIR"03_unlit_material.frag",
+				shaderLayout);
+		}
+
+		// 每种顶点布局一条管线：绑定0为逐顶点数据(布局见 AdMesh::GetVertexInputState)，绑定1为逐实例的模型矩阵
+		// 各管线只有顶点输入与顶点着色器不同，Float 与 Model 布局的着色器输入相同，共用同一管线布局
+		for (uint32_t i = 0; i < AD_VERTEX_FORMAT_COUNT; i++) {
+			AdVertexFormat format = static_cast<AdVertexFormat>(i);
+			std::vector<VkVertexInputBindingDescription> vertexBindings(2);
+			std::vector<VkVertexInputAttributeDescription> vertexAttrs;
+			AdMesh::GetVertexInputState(format, &vertexBindings[0], vertexAttrs);
+			vertexBindings[1] = {
+				.binding = 1,
+				.stride = sizeof(glm::mat4),
+				.inputRate = VK_VERTEX_INPUT_RATE_INSTANCE
+			};
+			// 模型矩阵按列占用位置 5~8
+			for (uint32_t column = 0; column < 4; column++) {
+				vertexAttrs.push_back({
+					.location = 5 + column,
+					.binding = 1,
+					.format = VK_FORMAT_R32G32B32A32_SFLOAT,
+					.offset = static_cast<uint32_t>(column * sizeof(glm::vec4))
+				});
 			}
-		};
 
-		// 创建图形管线并设置相关状态
-		mPipeline = std::make_shared<AdVKPipeline>(device, renderPass, mPipelineLayout.get());
-		mPipeline->SetVertexInputState(vertexBindings, vertexAttrs);
-		mPipeline->EnableDepthTest();
-		mPipeline->SetDynamicState({ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR });
-		mPipeline->SetMultisampleState(VK_SAMPLE_COUNT_4_BIT, VK_FALSE);
-		mPipeline->SetSubPassIndex(0);
-		mPipeline->Create();
-
-		// 创建描述符池并分配帧UBO描述符集
-		std::vector<VkDescriptorPoolSize> poolSizes = {
-		    {
-			.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-			.descriptorCount = 1
-		    }
-		};
-		mDescriptorPool = std::make_shared<AdVKDescriptorPool>(device, 1, poolSizes);
-		mFrameUboDescSet = mDescriptorPool->AllocateDescriptorSet(mFrameUboDescSetLayout.get(), 1)[0];
-		mFrameUboBuffer = std::make_shared<WuDu::AdVKBuffer>(device, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(FrameUbo), nullptr, true);
+			AdVKPipelineLayout* pipelineLayout = format == AdVertexFormat::Packed ? mPackedPipelineLayout.get() : mPipelineLayout.get();
+			mPipelines[i] = std::make_shared<AdVKPipeline>(device, renderPass, pipelineLayout);
+			mPipelines[i]->SetVertexInputState(vertexBindings, vertexAttrs);
+			mPipelines[i]->EnableDepthTest();
+			mPipelines[i]->SetDynamicState({ VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR });
+			mPipelines[i]->SetMultisampleState(VK_SAMPLE_COUNT_4_BIT, VK_FALSE);
+			mPipelines[i]->SetSubPassIndex(0);
+			// 管线在工作线程上编译，完成前跳过绘制
+			mPipelines[i]->CreateAsync();
+		}
 
-		// 初始化材质描述符池
-		ReCreateMaterialDescPool(NUM_MATERIAL_BATCH);
+		// 创建每帧的环形Uniform缓冲区，初始容量为帧UBO加一批材质参数
+		// 无绑定路径下材质参数区同时作为SSBO，紧密排列；否则每个材质按动态偏移对齐
+		uint32_t framesInFlight = GetFramesInFlight();
+		VkBufferUsageFlags ringUsage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | (bBindless ? VK_BUFFER_USAGE_STORAGE_BUFFER_BIT : 0);
+		mUniformRing = std::make_shared<AdVKRingBuffer>(device, ringUsage,
+			sizeof(FrameUbo) + NUM_MATERIAL_BATCH * 256, framesInFlight);
+		mMaterialParamStride = bBindless ? sizeof(UnlitMaterialGpuData) : mUniformRing->GetAlignedSize(sizeof(UnlitMaterialUbo));
+
+		// 创建每帧的实例数据环形缓冲区，存放按批次连续排列的模型矩阵
+		mInstanceRing = std::make_shared<AdVKRingBuffer>(device, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT,
+			NUM_INSTANCE_BATCH * sizeof(glm::mat4), framesInFlight);
+		mRenderQueue = std::make_shared<AdRenderQueue>();
+		mCuller = std::make_shared<AdFrustumCuller>();
+
+		// 从共享的描述符分配器中为每个帧槽位分配帧UBO和材质参数的动态描述符集
+		AdVKDescriptorAllocator* descAllocator = device->GetDescriptorAllocator();
+		mFrameUboDescSets = descAllocator->Allocate(mFrameUboDescSetLayout.get(), framesInFlight);
+		mMaterialParamDescSets = descAllocator->Allocate(mMaterialParamDescSetLayout.get(), framesInFlight);
+		for (uint32_t i = 0; i < framesInFlight; i++) {
+			UpdateUniformDescSets(i);
+		}
+
+		// 初始分配一批材质描述符集
+		if (!bBindless) {
+			GrowMaterialDescSets(NUM_MATERIAL_BATCH);
+		}
 
 		// 创建默认纹理（白色像素）
 		std::unique_ptr<RGBAColor> whitePixel = std::make_unique<RGBAColor>(255,255,255,255);
 		mDefaultTexture = std::make_shared<AdTexture>(1, 1, whitePixel.get());
+		// 默认纹理作为未就绪纹理的替代，必须立即可用
+		mDefaultTexture->WaitReady();
 
 		// 创建默认采样器
 	       
@@ -174,8 +198,10 @@ namespace WuDu {
 			return;
 		}
 
-		// 绑定图形管线并设置视口和裁剪区域
-		mPipeline->Bind(cmdBuffer);
+		// 绑定图形管线并设置视口和裁剪区域，管线仍在编译时跳过本帧绘制
+		if (!mPipelines[static_cast<uint32_t>(AdVertexFormat::Float)]->Bind(cmdBuffer)) {
+			return;
+		}
 		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
 		VkViewport viewport = {
 		    .x = 0,
@@ -192,132 +218,273 @@ namespace WuDu {
 		};
 		vkCmdSetScissor(cmdBuffer, 0, 1, &scissor);
 
-		// 更新帧UBO描述符集
-		UpdateFrameUboDescSet(renderTarget);
-
-		// 检查是否需要重新创建材质描述符池
-		bool bShouldForceUpdateMaterial = false;
+		// 材质数量超过已分配的描述符集时追加分配（无绑定路径没有逐材质的描述符集）
 		uint32_t materialCount = AdMaterialFactory::GetInstance()->GetMaterialSize<AdUnlitMaterial>();
-		if (materialCount > mLastDescriptorSetCount) {
-			ReCreateMaterialDescPool(materialCount);
-			bShouldForceUpdateMaterial = true;
+		if (!bBindless && materialCount > mLastDescriptorSetCount) {
+			GrowMaterialDescSets(materialCount);
 		}
 
-		// 遍历所有实体并渲染
-		std::vector<bool> updateFlags(materialCount);
-		view.each([this, &updateFlags, &bShouldForceUpdateMaterial, &cmdBuffer](AdTransformComponent& transComp, AdUnlitMaterialComponent& materialComp) {
+		// 新增的材质在所有帧槽位上都还没有写入过
+		uint32_t allFramesMask = (1u << GetFramesInFlight()) - 1;
+		if (mMaterialParamsDirtyFrames.size() < materialCount) {
+			mMaterialParamsDirtyFrames.resize(materialCount, allFramesMask);
+		}
+		if (mMaterialResourceDirtyFrames.size() < materialCount) {
+			mMaterialResourceDirtyFrames.resize(materialCount, allFramesMask);
+		}
+
+		// 开始当前帧槽位的环形缓冲区，容量不足时扩容并重写该槽位指向它的描述符集
+		// 扩容后的缓冲区内容为空，该槽位上所有材质参数都需要重新写入
+		uint32_t frameIndex = GetCurrentFrameIndex();
+		uint32_t frameBit = 1u << frameIndex;
+		VkDeviceSize requiredSize = mUniformRing->GetAlignedSize(sizeof(FrameUbo)) + materialCount * mMaterialParamStride;
+		if (mUniformRing->BeginFrame(frameIndex, requiredSize)) {
+			UpdateUniformDescSets(frameIndex);
+			MarkMaterialsDirty(mMaterialParamsDirtyFrames, frameBit);
+		}
+
+		// 写入帧UBO并绑定，整帧只绑定一次
+		uint32_t frameUboOffset = PushFrameUbo(renderTarget);
+		VkDescriptorSet frameUboDescSet = mFrameUboDescSets[frameIndex];
+		vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout->GetHandle(),
+			0, 1, &frameUboDescSet, 1, &frameUboOffset);
+
+		// 紧随帧UBO分出整块材质参数区，材质i固定位于 base + i * mMaterialParamStride
+		uint32_t materialParamBase = 0;
+		void* materialParamData = nullptr;
+		if (!mUniformRing->Allocate(materialCount * mMaterialParamStride, &materialParamBase, &materialParamData)) {
+			return;
+		}
+
+		// 无绑定路径：材质SSBO与无绑定表每帧各绑定一次，之后每次绘制只推送材质索引
+		VkDescriptorSet paramsDescSet = mMaterialParamDescSets[frameIndex];
+		if (bBindless) {
+			VkDescriptorSet descriptorSets[] = { paramsDescSet, GetDevice()->GetBindlessTable()->GetDescriptorSet() };
+			vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout->GetHandle(),
+				1, ARRAY_SIZE(descriptorSets), descriptorSets, 0, nullptr);
+		}
+
+		// 收集所有绘制包并提交各网格的包围盒，排序键依次为 (阶段, 管线, 材质, 网格, 深度)
+		// 管线字段使用注册表分配的排序编号，各顶点布局的管线必然不同，同布局的批次保持相邻
+		uint32_t pipelineIds[AD_VERTEX_FORMAT_COUNT];
+		for (uint32_t i = 0; i < AD_VERTEX_FORMAT_COUNT; i++) {
+			pipelineIds[i] = mPipelines[i]->GetSortId();
+		}
+		glm::mat4 viewMat = GetViewMat(renderTarget);
+		mCuller->Begin(GetProjMat(renderTarget) * viewMat);
+		mCullCandidates.clear();
+		AdTransformSystem* transformSystem = scene->GetTransformSystem();
+		view.each([this, &pipelineIds, &viewMat, transformSystem](AdTransformComponent& transComp, AdUnlitMaterialComponent& materialComp) {
+			glm::mat4 transform = transformSystem->GetWorldMatrix(transComp);
+			float viewDepth = -(viewMat * transform[3]).z;
 			for (const auto& entry : materialComp.GetMeshMaterials()) {
 				AdUnlitMaterial* material = entry.first;
 				if (!material || material->GetIndex() < 0) {
 					LOG_W("TODO: default material or error material ?");
 					continue;
 				}
-
-				uint32_t materialIndex = material->GetIndex();
-				VkDescriptorSet paramsDescSet = mMaterialDescSets[materialIndex];
-				VkDescriptorSet resourceDescSet = mMaterialResourceDescSets[materialIndex];
-
-				// 更新材质参数和资源描述符集
-				// 修复：确保首次使用时一定更新描述符集
-				if (!updateFlags[materialIndex] || bShouldForceUpdateMaterial) {
-					// 移除 ShouldFlush 检查，或者确保新材质的 flush 标志正确设置
-					UpdateMaterialParamsDescSet(paramsDescSet, material);
-					UpdateMaterialResourceDescSet(resourceDescSet, material);
-					updateFlags[materialIndex] = true;
+				for (const auto& meshIndex : entry.second) {
+					AdMesh* mesh = materialComp.GetMesh(meshIndex);
+					if (mesh) {
+						// 剔除使用模型空间包围盒；量化网格的解量化变换并入实例矩阵，由顶点着色器一次完成
+						AdVertexFormat format = mesh->GetVertexFormat();
+						bool bPacked = format == AdVertexFormat::Packed;
+						uint64_t sortKey = AdRenderQueue::MakeSortKey(AD_RENDER_PASS_OPAQUE, pipelineIds[static_cast<uint32_t>(format)], material->GetIndex(), mesh->GetSortId(), viewDepth);
+						mCuller->Add(mesh->GetBoundsMin(), mesh->GetBoundsMax(), transform);
+						mCullCandidates.push_back({ sortKey, material, mesh, bPacked ? transform * mesh->GetDequantizeTransform() : transform });
+					}
 				}
+			}
+			});
 
-				// 绑定描述符集并推送模型变换矩阵
-				VkDescriptorSet descriptorSets[] = { mFrameUboDescSet, paramsDescSet, resourceDescSet };
-				vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout->GetHandle(),
-					0, ARRAY_SIZE(descriptorSets), descriptorSets, 0, nullptr);
+		// 只有通过视锥体剔除的包进入渲染队列，排序后状态相同的相邻包合并为实例化批次
+		mCuller->Cull();
+		mRenderQueue->Clear();
+		for (uint32_t i = 0; i < mCullCandidates.size(); i++) {
+			if (mCuller->IsVisible(i)) {
+				const CullCandidate& candidate = mCullCandidates[i];
+				mRenderQueue->Push(candidate.sortKey, candidate.material, candidate.mesh, candidate.transform);
+			}
+		}
+		mRenderQueue->Build();
+		if (mRenderQueue->IsEmpty()) {
+			return;
+		}
 
-				ModelPC pc = { transComp.GetTransform() };
-				vkCmdPushConstants(cmdBuffer, mPipelineLayout->GetHandle(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(pc), &pc);
+		// 写入本帧的实例数据并绑定到顶点绑定点1，各批次以 firstInstance 定位自己的实例
+		const std::vector<glm::mat4>& instanceTransforms = mRenderQueue->GetInstanceTransforms();
+		VkDeviceSize instanceDataSize = instanceTransforms.size() * sizeof(glm::mat4);
+		mInstanceRing->BeginFrame(frameIndex, instanceDataSize);
+		uint32_t instanceOffset = 0;
+		void* instanceData = nullptr;
+		if (!mInstanceRing->Allocate(instanceDataSize, &instanceOffset, &instanceData)) {
+			return;
+		}
+		memcpy(instanceData, instanceTransforms.data(), instanceDataSize);
+		VkBuffer instanceBuffer = mInstanceRing->GetHandle(frameIndex);
+		VkDeviceSize instanceBufferOffset = instanceOffset;
+		vkCmdBindVertexBuffers(cmdBuffer, 1, 1, &instanceBuffer, &instanceBufferOffset);
+
+		// 每个批次一次实例化绘制，队列只在材质或网格变化时回调绑定
+		// 两条管线的布局兼容，顶点格式切换时只重新绑定管线，已绑定的描述符集与推送常量保持有效
+		auto bindVertexFormat = [&](AdVertexFormat format) {
+			return mPipelines[static_cast<uint32_t>(format)]->Bind(cmdBuffer);
+		};
+		mRenderQueue->Record(cmdBuffer, [&](AdMaterial* boundMaterial) {
+			AdUnlitMaterial* material = static_cast<AdUnlitMaterial*>(boundMaterial);
+			uint32_t materialIndex = material->GetIndex();
+			void* paramData = static_cast<uint8_t*>(materialParamData) + materialIndex * mMaterialParamStride;
+
+			// 材质变化时标记所有帧槽位待更新；纹理变化会影响纹理参数，参数也一并更新
+			if (material->ShouldFlushResource()) {
+				mMaterialResourceDirtyFrames[materialIndex] |= allFramesMask;
+				mMaterialParamsDirtyFrames[materialIndex] |= allFramesMask;
+				material->FinishFlushResource();
+			}
+			if (material->ShouldFlushParams()) {
+				mMaterialParamsDirtyFrames[materialIndex] |= allFramesMask;
+				material->FinishFlushParams();
+			}
 
-				// 绘制网格
-				for (const auto& meshIndex : entry.second) {
-					materialComp.GetMesh(meshIndex)->Draw(cmdBuffer);
+			if (bBindless) {
+				// 纹理索引随参数一起写入SSBO，纹理仍在上传时保持脏标记，待就绪后再写入一次
+				if (mMaterialParamsDirtyFrames[materialIndex] & frameBit) {
+					if (WriteBindlessMaterialParams(material, paramData)) {
+						mMaterialParamsDirtyFrames[materialIndex] &= ~frameBit;
+					}
 				}
+
+				BindlessMaterialPC pc = { materialIndex };
+				vkCmdPushConstants(cmdBuffer, mPipelineLayout->GetHandle(), VK_SHADER_STAGE_FRAGMENT_BIT, 0, sizeof(pc), &pc);
+			} else {
+				VkDescriptorSet resourceDescSet = mMaterialResourceDescSets[frameIndex][materialIndex];
+
+				// 只在当前帧槽位仍为脏时写入，其它槽位轮到自己时再写，避免改写在途帧的数据
+				if (mMaterialParamsDirtyFrames[materialIndex] & frameBit) {
+					WriteMaterialParams(material, paramData);
+					mMaterialParamsDirtyFrames[materialIndex] &= ~frameBit;
+				}
+				// 纹理仍在上传时以默认纹理代替，保持脏标记，待纹理就绪后再写入一次
+				if (mMaterialResourceDirtyFrames[materialIndex] & frameBit) {
+					if (UpdateMaterialResourceDescSet(resourceDescSet, material)) {
+						mMaterialResourceDirtyFrames[materialIndex] &= ~frameBit;
+					}
+				}
+
+				// 绑定材质描述符集（参数使用动态偏移）
+				VkDescriptorSet descriptorSets[] = { paramsDescSet, resourceDescSet };
+				uint32_t dynamicOffset = materialParamBase + materialIndex * static_cast<uint32_t>(mMaterialParamStride);
+				vkCmdBindDescriptorSets(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mPipelineLayout->GetHandle(),
+					1, ARRAY_SIZE(descriptorSets), descriptorSets, 1, &dynamicOffset);
 			}
-			});
+			}, bindVertexFormat);
+	}
+
+	const AdRenderQueueStats& AdUnlitMaterialSystem::GetRenderStats() const {
+		return mRenderQueue->GetStats();
+	}
+
+	const AdCullStats& AdUnlitMaterialSystem::GetCullStats() const {
+		return mCuller->GetStats();
 	}
 
 	/**
 	 * @brief 销毁无光照材质系统资源。
 	 */
 	void AdUnlitMaterialSystem::OnDestroy() {
-		mPipeline.reset();
+		// 销毁前设备已空闲，描述符集归还给共享分配器供其它系统复用
+		AdVKDescriptorAllocator* descAllocator = GetDevice()->GetDescriptorAllocator();
+		descAllocator->Free(mFrameUboDescSetLayout.get(), mFrameUboDescSets);
+		descAllocator->Free(mMaterialParamDescSetLayout.get(), mMaterialParamDescSets);
+		if (mMaterialResourceDescSetLayout) {
+			for (const auto& descSets : mMaterialResourceDescSets) {
+				descAllocator->Free(mMaterialResourceDescSetLayout.get(), descSets);
+			}
+		}
+		mFrameUboDescSets.clear();
+		mMaterialParamDescSets.clear();
+		mMaterialResourceDescSets.clear();
+		mLastDescriptorSetCount = 0;
+
+		for (auto& pipeline : mPipelines) {
+			pipeline.reset();
+		}
+		mPackedPipelineLayout.reset();
 		mPipelineLayout.reset();
 	}
 
 	/**
-	 * @brief 重新创建材质描述符池，以适应更多材质的需求。
+	 * @brief 扩充每个帧槽位的材质资源描述符集，以适应更多材质的需求。
+	 *
+	 * 新的描述符集从设备共享的描述符分配器中追加分配，已有的描述符集保持有效且无需重写，
+	 * 因此不需要等待设备空闲，材质数量也没有上限。
 	 *
 	 * @param materialCount 当前需要支持的材质数量。
 	 */
-	void AdUnlitMaterialSystem::ReCreateMaterialDescPool(uint32_t materialCount) {
-		AdVKDevice* device = GetDevice();
-
-		// 计算新的描述符集数量
-		uint32_t newDescriptorSetCount = mLastDescriptorSetCount;
-		if (mLastDescriptorSetCount == 0) {
-			newDescriptorSetCount = NUM_MATERIAL_BATCH;
+	void AdUnlitMaterialSystem::GrowMaterialDescSets(uint32_t materialCount) {
+		AdVKDescriptorAllocator* descAllocator = GetDevice()->GetDescriptorAllocator();
+
+		// 按批次对齐，避免每新增一个材质就分配一次
+		uint32_t newDescriptorSetCount = (materialCount + NUM_MATERIAL_BATCH - 1) / NUM_MATERIAL_BATCH * NUM_MATERIAL_BATCH;
+		LOG_D("{0}: {1} -> {2}", __FUNCTION__, mLastDescriptorSetCount, newDescriptorSetCount);
+
+		uint32_t framesInFlight = GetFramesInFlight();
+		mMaterialResourceDescSets.resize(framesInFlight);
+		for (uint32_t frame = 0; frame < framesInFlight; frame++) {
+			std::vector<VkDescriptorSet> descSets = descAllocator->Allocate(mMaterialResourceDescSetLayout.get(), newDescriptorSetCount - mLastDescriptorSetCount);
+			assert(descSets.size() == newDescriptorSetCount - mLastDescriptorSetCount && "Failed to AllocateDescriptorSet");
+			mMaterialResourceDescSets[frame].insert(mMaterialResourceDescSets[frame].end(), descSets.begin(), descSets.end());
 		}
+		mLastDescriptorSetCount = newDescriptorSetCount;
+	}
 
-		while (newDescriptorSetCount < materialCount) {
-			newDescriptorSetCount *= 2;
-		}
-
-		if (newDescriptorSetCount > NUM_MATERIAL_BATCH_MAX) {
-			LOG_E("Descriptor Set max count is : {0}, but request : {1}", NUM_MATERIAL_BATCH_MAX, newDescriptorSetCount);
-			return;
-		}
-
-		LOG_W("{0}: {1} -> {2} S.", __FUNCTION__, mLastDescriptorSetCount, newDescriptorSetCount);
-
-		// 销毁旧的描述符池和相关资源
-		mMaterialDescSets.clear();
-		mMaterialResourceDescSets.clear();
-		if (mMaterialDescriptorPool) {
-			mMaterialDescriptorPool.reset();
+	/**
+	 * @brief 将所有已知材质在指定帧槽位上标记为待更新。
+	 *
+	 * @param dirtyFrames 参数或纹理描述符的脏标记数组。
+	 * @param frameMask 需要标记的帧槽位位掩码。
+	 */
+	void AdUnlitMaterialSystem::MarkMaterialsDirty(std::vector<uint32_t>& dirtyFrames, uint32_t frameMask) {
+		for (auto& mask : dirtyFrames) {
+			mask |= frameMask;
 		}
+	}
 
-		// 创建新的描述符池
-		std::vector<VkDescriptorPoolSize> poolSizes = {
-		    {
-			.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-			.descriptorCount = newDescriptorSetCount
-		    },
-		    {
-			.type = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER,
-			.descriptorCount = newDescriptorSetCount * 2
-		    }
-		};
-		mMaterialDescriptorPool = std::make_shared<WuDu::AdVKDescriptorPool>(device, newDescriptorSetCount * 2, poolSizes);
-
-		// 分配新的描述符集
-		mMaterialDescSets = mMaterialDescriptorPool->AllocateDescriptorSet(mMaterialParamDescSetLayout.get(), newDescriptorSetCount);
-		mMaterialResourceDescSets = mMaterialDescriptorPool->AllocateDescriptorSet(mMaterialResourceDescSetLayout.get(), newDescriptorSetCount);
-		assert(mMaterialDescSets.size() == newDescriptorSetCount && "Failed to AllocateDescriptorSet");
-		assert(mMaterialResourceDescSets.size() == newDescriptorSetCount && "Failed to AllocateDescriptorSet");
-
-		// 创建新的材质缓冲区
-		uint32_t diffCount = newDescriptorSetCount - mLastDescriptorSetCount;
-		for (int i = 0; i < diffCount; i++) {
-			mMaterialBuffers.push_back(std::make_shared<AdVKBuffer>(device, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT, sizeof(UnlitMaterialUbo), nullptr, true));
+	/**
+	 * @brief 将指定帧槽位的帧UBO与材质参数动态描述符集指向该槽位的环形缓冲区。
+	 *
+	 * 只在初始化和环形缓冲区扩容时调用，每帧的数据通过动态偏移区分，无需重写描述符。
+	 *
+	 * @param frameIndex 帧槽位索引。
+	 */
+	void AdUnlitMaterialSystem::UpdateUniformDescSets(uint32_t frameIndex) {
+		AdVKDevice* device = GetDevice();
+		VkBuffer ringBuffer = mUniformRing->GetHandle(frameIndex);
+
+		VkDescriptorBufferInfo frameBufferInfo = DescriptorSetWriter::BuildBufferInfo(ringBuffer, 0, sizeof(FrameUbo));
+		VkWriteDescriptorSet frameWrite = DescriptorSetWriter::WriteBuffer(mFrameUboDescSets[frameIndex], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, &frameBufferInfo);
+
+		// 无绑定路径下材质参数区紧跟帧UBO且起始偏移固定，以普通SSBO覆盖到缓冲区末尾
+		VkDescriptorBufferInfo paramsBufferInfo;
+		VkWriteDescriptorSet paramsWrite;
+		if (bBindless) {
+			paramsBufferInfo = DescriptorSetWriter::BuildBufferInfo(ringBuffer, mUniformRing->GetAlignedSize(sizeof(FrameUbo)), VK_WHOLE_SIZE);
+			paramsWrite = DescriptorSetWriter::WriteBuffer(mMaterialParamDescSets[frameIndex], 0, VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, &paramsBufferInfo);
+		} else {
+			paramsBufferInfo = DescriptorSetWriter::BuildBufferInfo(ringBuffer, 0, sizeof(UnlitMaterialUbo));
+			paramsWrite = DescriptorSetWriter::WriteBuffer(mMaterialParamDescSets[frameIndex], 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, &paramsBufferInfo);
 		}
-		LOG_W("{0}: {1} -> {2} E.", __FUNCTION__, mLastDescriptorSetCount, newDescriptorSetCount);
-		mLastDescriptorSetCount = newDescriptorSetCount;
+		DescriptorSetWriter::UpdateDescriptorSets(device->GetHandle(), { frameWrite, paramsWrite });
 	}
 
 	/**
-	 * @brief 更新帧UBO描述符集，传递投影矩阵、视图矩阵等每帧数据。
+	 * @brief 写入帧UBO（投影矩阵、视图矩阵等每帧数据）到环形缓冲区。
 	 *
 	 * @param renderTarget 渲染目标对象，用于获取帧缓冲信息。
+	 * @return uint32_t 帧UBO在当前帧槽位环形缓冲区中的动态偏移。
 	 */
-	void AdUnlitMaterialSystem::UpdateFrameUboDescSet(AdRenderTarget* renderTarget) {
+	uint32_t AdUnlitMaterialSystem::PushFrameUbo(AdRenderTarget* renderTarget) {
 		AdApplication* app = GetApp();
-		AdVKDevice* device = GetDevice();
 
 		AdVKFrameBuffer* frameBuffer = renderTarget->GetFrameBuffer();
 		glm::ivec2 resolution = { frameBuffer->GetWidth(), frameBuffer->GetHeight() };
@@ -331,24 +498,18 @@ namespace WuDu {
 		    .time = app->GetStartTimeSecond()
 		};
 
-		// 写入缓冲区并更新描述符集
-		mFrameUboBuffer->WriteData(&frameUbo);
-		VkDescriptorBufferInfo bufferInfo = DescriptorSetWriter::BuildBufferInfo(mFrameUboBuffer->GetHandle(), 0, sizeof(frameUbo));
-		VkWriteDescriptorSet bufferWrite = DescriptorSetWriter::WriteBuffer(mFrameUboDescSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, &bufferInfo);
-		DescriptorSetWriter::UpdateDescriptorSets(device->GetHandle(), { bufferWrite });
+		uint32_t offset = 0;
+		mUniformRing->Push(frameUbo, &offset);
+		return offset;
 	}
 
 	/**
-	 * @brief 更新材质参数描述符集，传递材质参数（如颜色、纹理参数等）。
+	 * @brief 写入材质参数（如颜色、纹理参数等）到环形缓冲区中该材质的固定位置。
 	 *
-	 * @param descSet 材质参数描述符集句柄。
 	 * @param material 无光照材质对象，包含参数数据。
+	 * @param dst 当前帧槽位环形缓冲区中该材质参数的映射地址。
 	 */
-	void AdUnlitMaterialSystem::UpdateMaterialParamsDescSet(VkDescriptorSet descSet, AdUnlitMaterial* material) {
-		AdVKDevice* device = GetDevice();
-
-		AdVKBuffer* materialBuffer = mMaterialBuffers[material->GetIndex()].get();
-
+	void AdUnlitMaterialSystem::WriteMaterialParams(AdUnlitMaterial* material, void* dst) {
 		// 获取材质参数并更新纹理参数
 		UnlitMaterialUbo params = material->GetParams();
 
@@ -362,11 +523,47 @@ namespace WuDu {
 			AdMaterial::UpdateTextureParams(texture1, &params.textureParam1);
 		}
 
-		// 写入缓冲区并更新描述符集
-		materialBuffer->WriteData(&params);
-		VkDescriptorBufferInfo bufferInfo = DescriptorSetWriter::BuildBufferInfo(materialBuffer->GetHandle(), 0, sizeof(params));
-		VkWriteDescriptorSet bufferWrite = DescriptorSetWriter::WriteBuffer(descSet, 0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, &bufferInfo);
-		DescriptorSetWriter::UpdateDescriptorSets(device->GetHandle(), { bufferWrite });
+		memcpy(dst, &params, sizeof(params));
+	}
+
+	/**
+	 * @brief 无绑定路径：写入材质参数及其纹理在无绑定表中的索引到材质SSBO中该材质的位置。
+	 *
+	 * @param material 无光照材质对象。
+	 * @param dst 当前帧槽位材质SSBO中该材质元素的映射地址。
+	 * @return bool 材质的纹理是否都已就绪；返回false表示有纹理暂时以默认纹理代替，之后需要再次写入。
+	 */
+	bool AdUnlitMaterialSystem::WriteBindlessMaterialParams(AdUnlitMaterial* material, void* dst) {
+		UnlitMaterialGpuData data = {};
+		data.params = material->GetParams();
+
+		bool bPending = false;
+		const std::pair<UnlitMaterialTexture, TextureParam*> textureParams[] = {
+			{ UNLIT_MAT_BASE_COLOR_0, &data.params.textureParam0 },
+			{ UNLIT_MAT_BASE_COLOR_1, &data.params.textureParam1 }
+		};
+		for (uint32_t i = 0; i < ARRAY_SIZE(textureParams); i++) {
+			// 没有纹理、纹理无效或仍在上传时使用默认纹理的索引
+			uint32_t textureIndex = mDefaultTexture->GetBindlessIndex();
+			uint32_t samplerIndex = mDefaultSampler->GetBindlessIndex();
+			const TextureView* texture = material->GetTextureView(textureParams[i].first);
+			if (texture) {
+				AdMaterial::UpdateTextureParams(texture, textureParams[i].second);
+				if (texture->texture && texture->sampler) {
+					if (texture->texture->IsReady()) {
+						textureIndex = texture->texture->GetBindlessIndex();
+						samplerIndex = texture->sampler->GetBindlessIndex();
+					} else {
+						bPending = true;
+					}
+				}
+			}
+			data.textureIndices[i * 2] = textureIndex;
+			data.textureIndices[i * 2 + 1] = samplerIndex;
+		}
+
+		memcpy(dst, &data, sizeof(data));
+		return !bPending;
 	}
 
 	/**
@@ -374,8 +571,9 @@ namespace WuDu {
 	 *
 	 * @param descSet 材质资源描述符集句柄。
 	 * @param material 无光照材质对象，包含纹理资源。
+	 * @return bool 材质的纹理是否都已就绪；返回false表示有纹理暂时以默认纹理代替，之后需要再次更新。
 	 */
-	void AdUnlitMaterialSystem::UpdateMaterialResourceDescSet(VkDescriptorSet descSet, AdUnlitMaterial* material) {
+	bool AdUnlitMaterialSystem::UpdateMaterialResourceDescSet(VkDescriptorSet descSet, AdUnlitMaterial* material) {
 		AdVKDevice* device = GetDevice();
 
 		// 获取纹理资源
@@ -391,12 +589,19 @@ namespace WuDu {
 		if (!texture0) texture0 = &defaultView;
 		if (!texture1) texture1 = &defaultView;
 
-		// 确保纹理和采样器都有效
+		// 确保纹理和采样器都有效，仍在上传中的纹理暂时使用默认纹理
+		bool bPending = false;
 		if (!texture0->texture || !texture0->sampler) {
 			texture0 = &defaultView;
+		} else if (!texture0->texture->IsReady()) {
+			texture0 = &defaultView;
+			bPending = true;
 		}
 		if (!texture1->texture || !texture1->sampler) {
 			texture1 = &defaultView;
+		} else if (!texture1->texture->IsReady()) {
+			texture1 = &defaultView;
+			bPending = true;
 		}
 
 		// 构建图像信息
@@ -418,5 +623,6 @@ namespace WuDu {
 		);
 
 		DescriptorSetWriter::UpdateDescriptorSets(device->GetHandle(), { textureWrite0, textureWrite1 });
+		return !bPending;
 	}
 }
\ No newline at end of file
@@ -24,102 +24,73 @@ namespace WuDu {
 		CreateGUIRenderPass();
 	}
 
-	void AdGuiRenderer::OnRender() {
+	/**
+	 * @brief 录制ImGui绘制命令
+	 *
+	 * GUI不再拥有独立的AdRenderer，而是作为场景命令缓冲区中的一个额外渲染通道，
+	 * 在场景渲染通道结束后执行。这样每帧只有一次图像获取、一次提交和一次呈现。
+	 *
+	 * @param cmdBuffer 场景命令缓冲区，调用时必须处于录制状态且不在任何渲染通道内
+	 */
+	void AdGuiRenderer::OnRender(VkCommandBuffer cmdBuffer) {
 		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
-		WuDu::AdVKDevice* device = renderCxt->GetDevice();
 		WuDu::AdVKSwapchain* swapchain = renderCxt->GetSwapchain();
 		ImDrawData* draw_data = ImGui::GetDrawData();
 
-		// 检查窗口大小是否变化，如果变化了就重建资源
+		// 检查窗口大小是否变化，如果变化了就同步显示尺寸和渲染目标
 		ImGuiIO& io = ImGui::GetIO();
 		if (io.DisplaySize.x != static_cast<float>(swapchain->GetWidth()) ||
 			io.DisplaySize.y != static_cast<float>(swapchain->GetHeight())) {
 			RebuildResources();
-			return; // 资源重建后，等待下一帧再渲染
 		}
 
-		// 获取当前的交换链图像索引
-		int32_t imageIndex;
-		bool swapchainRebuilt = mGUIRenderer->Begin(&imageIndex);
+		// 场景渲染通道与GUI渲染通道写同一交换链图像，两者之间需要颜色附件写后写/读的依赖
+		VkMemoryBarrier barrier = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT,
+			.dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT | VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT
+		};
+		vkCmdPipelineBarrier(cmdBuffer,
+			VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+			0, 1, &barrier, 0, nullptr, 0, nullptr);
 
-		// 如果交换链被重建，我们需要重建所有GUI资源
-		if (swapchainRebuilt) {
-			RebuildResources();
-			return; // 资源重建后，等待下一帧再渲染
-		}
+		// 使用GUI专用的渲染目标进行渲染
+		mGUIRenderTarget->Begin(cmdBuffer);
 
-		// 确保命令缓冲区数组足够大（安全检查）
-		if (imageIndex < 0 || imageIndex >= static_cast<int32_t>(mGUICmdBuffers.size())) {
-			// 索引无效，重建资源
-			RebuildResources();
-			return;
+		// 渲染ImGui
+		if (draw_data && draw_data->CmdListsCount > 0) {
+			ImGui_ImplVulkan_RenderDrawData(draw_data, cmdBuffer);
 		}
 
-		try {
-			VkCommandBuffer cmdBuffer = mGUICmdBuffers[imageIndex];
-			WuDu::AdVKCommandPool::BeginCommandBuffer(cmdBuffer);
-
-			// 使用GUI专用的渲染目标进行渲染
-			mGUIRenderTarget->Begin(cmdBuffer);
-
-			// 渲染ImGui
-			if (draw_data && draw_data->CmdListsCount > 0) {
-				ImGui_ImplVulkan_RenderDrawData(draw_data, cmdBuffer);
-			}
-
-			mGUIRenderTarget->End(cmdBuffer);
-
-			WuDu::AdVKCommandPool::EndCommandBuffer(cmdBuffer);
-
-			// 提交GUI渲染命令
-			if (mGUIRenderer->End(imageIndex, { cmdBuffer })) {
-				// 如果在End过程中交换链被重建，记录下来但不立即处理
-				// 下一帧的Begin()会检测到并处理
-			}
-		}
-		catch (const std::exception& e) {
-			// 捕获任何异常，避免程序崩溃
-			RebuildResources(); // 发生异常时重建资源
-			return;
-		}
+		mGUIRenderTarget->End(cmdBuffer);
 	}
 
 	void AdGuiRenderer::OnDestroy() {
 		// 清理Vulkan资源
 		mImGuiDescriptorPool.reset();
-		mGUIRenderer.reset();
 		mGUIRenderTarget.reset();
 		mGUIRenderPass.reset();
-
-		// 清理命令缓冲区
-		if (!mGUICmdBuffers.empty()) {
-			mGUICmdBuffers.clear();
-		}
 	}
 
+	/**
+	 * @brief 窗口大小变化时同步GUI资源
+	 *
+	 * 交换链重建时主渲染器已经等待过设备空闲，这里只需更新ImGui显示尺寸并标记渲染目标重建帧缓冲，
+	 * 渲染通道与ImGui管线保持不变。
+	 */
 	void AdGuiRenderer::RebuildResources() {
 		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
-		auto device = renderCxt->GetDevice();
 		auto swapchain = renderCxt->GetSwapchain();
 
-		// 等待所有命令执行完成，确保安全释放资源
-		vkDeviceWaitIdle(device->GetHandle());
-
 		// 更新ImGui的DisplaySize以匹配新的窗口大小
 		ImGuiIO& io = ImGui::GetIO();
 		io.DisplaySize = ImVec2(static_cast<float>(swapchain->GetWidth()), static_cast<float>(swapchain->GetHeight()));
 
-		// 销毁旧的GUI资源
-		mGUICmdBuffers.clear();
-
-		// 重新创建渲染通道、渲染目标和命令缓冲区
-		// 先重置旧的资源
-		mGUIRenderTarget.reset();
-		mGUIRenderPass.reset();
-		mGUIRenderer.reset(); // 也重置渲染器，确保与新的渲染目标兼容
-
-		// 重新创建所有资源
-		CreateGUIRenderPass();
+		// 帧缓冲在下一次Begin时按新尺寸重建
+		if (mGUIRenderTarget) {
+			mGUIRenderTarget->SetExtent({ swapchain->GetWidth(), swapchain->GetHeight() });
+		}
 	}
 
 	void AdGuiRenderer::CreateGUIRenderPass() {
@@ -156,13 +127,7 @@ namespace WuDu {
 		// 使用GUI专用渲染通道创建渲染目标
 		mGUIRenderTarget = std::make_shared<WuDu::AdRenderTarget>(mGUIRenderPass.get());
 
-		// 创建渲染器
-		mGUIRenderer = std::make_shared<WuDu::AdRenderer>();
-
 		// 设置清除值 - 使用透明清除以便在3D场景上叠加GUI
 		mGUIRenderTarget->SetColorClearValue({ 0.0f, 0.0f, 0.0f, 0.0f });
-
-		// 分配命令缓冲区
-		mGUICmdBuffers = device->GetDefaultCmdPool()->AllocateCommandBuffer(swapchain->GetImages().size());
 	}
 }
\ No newline at end of file
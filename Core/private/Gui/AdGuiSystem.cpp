@@ -37,12 +37,12 @@ namespace WuDu {
 		ImGui_ImplVulkan_Init(&init_info);
 
 		// 等待初始化完成
-		vkDeviceWaitIdle(device->GetHandle());
+		device->WaitIdle();
 	}
 
-	void AdGuiSystem::OnRender() {
-		// 渲染GUI
-		mRenderer.OnRender();
+	void AdGuiSystem::OnRender(VkCommandBuffer cmdBuffer) {
+		// 渲染GUI，与场景共用同一命令缓冲区
+		mRenderer.OnRender(cmdBuffer);
 
 		// 处理多视口
 		ImGuiIO& io = ImGui::GetIO();
@@ -61,7 +61,7 @@ namespace WuDu {
 		ImGui_ImplVulkan_Shutdown();
 
 		// 等待ImGui资源释放完成
-		vkDeviceWaitIdle(device->GetHandle());
+		device->WaitIdle();
 
 		// 然后按顺序清理各个组件
 		mEventHandler.OnDestroy();
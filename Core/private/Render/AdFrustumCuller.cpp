@@ -0,0 +1,140 @@
+#include "Render/AdFrustumCuller.h"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#define AD_FRUSTUM_CULL_SSE
+#include <xmmintrin.h>
+#endif
+
+namespace WuDu {
+	/**
+	 * @brief 从观察投影矩阵提取视锥体平面（Gribb-Hartmann）
+	 *
+	 * 近平面取 w + z，在 [0, 1] 深度范围下比实际近平面更靠后，只会多保留对象，不会误剔除。
+	 *
+	 * @param viewProj 投影矩阵 * 观察矩阵
+	 */
+	AdFrustum AdFrustum::FromViewProj(const glm::mat4& viewProj) {
+		glm::vec4 rows[4];
+		for (int i = 0; i < 4; i++) {
+			rows[i] = glm::vec4(viewProj[0][i], viewProj[1][i], viewProj[2][i], viewProj[3][i]);
+		}
+		AdFrustum frustum;
+		frustum.planes[0] = rows[3] + rows[0];      // 左
+		frustum.planes[1] = rows[3] - rows[0];      // 右
+		frustum.planes[2] = rows[3] + rows[1];      // 下
+		frustum.planes[3] = rows[3] - rows[1];      // 上
+		frustum.planes[4] = rows[3] + rows[2];      // 近
+		frustum.planes[5] = rows[3] - rows[2];      // 远
+		for (auto& plane : frustum.planes) {
+			plane /= glm::length(glm::vec3(plane));
+		}
+		return frustum;
+	}
+
+	void AdFrustumCuller::Begin(const glm::mat4& viewProj) {
+		mFrustum = AdFrustum::FromViewProj(viewProj);
+		mObjectCount = 0;
+		mCenterX.clear();
+		mCenterY.clear();
+		mCenterZ.clear();
+		mExtentX.clear();
+		mExtentY.clear();
+		mExtentZ.clear();
+		mStats = {};
+	}
+
+	/**
+	 * @brief 提交一个对象，模型空间包围盒经模型矩阵变换为世界空间包围盒（Arvo 方法）
+	 *
+	 * @param boundsMin 模型空间包围盒最小点
+	 * @param boundsMax 模型空间包围盒最大点
+	 * @param transform 模型矩阵
+	 * @return 对象索引
+	 */
+	uint32_t AdFrustumCuller::Add(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& transform) {
+		glm::vec3 center = glm::vec3(transform * glm::vec4((boundsMin + boundsMax) * 0.5f, 1.f));
+		glm::vec3 halfSize = (boundsMax - boundsMin) * 0.5f;
+		glm::vec3 extent = glm::abs(glm::vec3(transform[0])) * halfSize.x
+			+ glm::abs(glm::vec3(transform[1])) * halfSize.y
+			+ glm::abs(glm::vec3(transform[2])) * halfSize.z;
+
+		mCenterX.push_back(center.x);
+		mCenterY.push_back(center.y);
+		mCenterZ.push_back(center.z);
+		mExtentX.push_back(extent.x);
+		mExtentY.push_back(extent.y);
+		mExtentZ.push_back(extent.z);
+		return mObjectCount++;
+	}
+
+	/**
+	 * @brief 测试所有已提交的包围盒：中心到平面的有向距离小于包围盒在平面法线上的投影半径的负值时在平面外侧
+	 */
+	void AdFrustumCuller::Cull() {
+		// 补齐到 SIMD 宽度，补齐部分的结果不会被读取
+		uint32_t paddedCount = (mObjectCount + AD_FRUSTUM_CULL_SIMD_WIDTH - 1) / AD_FRUSTUM_CULL_SIMD_WIDTH * AD_FRUSTUM_CULL_SIMD_WIDTH;
+		for (auto* values : { &mCenterX, &mCenterY, &mCenterZ, &mExtentX, &mExtentY, &mExtentZ }) {
+			values->resize(paddedCount, 0.f);
+		}
+		mVisibility.resize(paddedCount);
+
+		uint32_t scalarBegin = 0;
+#ifdef AD_FRUSTUM_CULL_SSE
+		__m128 planeX[AD_FRUSTUM_PLANE_COUNT], planeY[AD_FRUSTUM_PLANE_COUNT], planeZ[AD_FRUSTUM_PLANE_COUNT], planeD[AD_FRUSTUM_PLANE_COUNT];
+		__m128 absX[AD_FRUSTUM_PLANE_COUNT], absY[AD_FRUSTUM_PLANE_COUNT], absZ[AD_FRUSTUM_PLANE_COUNT];
+		for (int i = 0; i < AD_FRUSTUM_PLANE_COUNT; i++) {
+			const glm::vec4& plane = mFrustum.planes[i];
+			planeX[i] = _mm_set1_ps(plane.x);
+			planeY[i] = _mm_set1_ps(plane.y);
+			planeZ[i] = _mm_set1_ps(plane.z);
+			planeD[i] = _mm_set1_ps(plane.w);
+			absX[i] = _mm_set1_ps(std::abs(plane.x));
+			absY[i] = _mm_set1_ps(std::abs(plane.y));
+			absZ[i] = _mm_set1_ps(std::abs(plane.z));
+		}
+		for (uint32_t base = 0; base < paddedCount; base += AD_FRUSTUM_CULL_SIMD_WIDTH) {
+			__m128 cx = _mm_loadu_ps(&mCenterX[base]);
+			__m128 cy = _mm_loadu_ps(&mCenterY[base]);
+			__m128 cz = _mm_loadu_ps(&mCenterZ[base]);
+			__m128 ex = _mm_loadu_ps(&mExtentX[base]);
+			__m128 ey = _mm_loadu_ps(&mExtentY[base]);
+			__m128 ez = _mm_loadu_ps(&mExtentZ[base]);
+			__m128 inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+			for (int i = 0; i < AD_FRUSTUM_PLANE_COUNT; i++) {
+				__m128 dist = _mm_add_ps(_mm_add_ps(_mm_mul_ps(planeX[i], cx), _mm_mul_ps(planeY[i], cy)),
+					_mm_add_ps(_mm_mul_ps(planeZ[i], cz), planeD[i]));
+				__m128 radius = _mm_add_ps(_mm_add_ps(_mm_mul_ps(absX[i], ex), _mm_mul_ps(absY[i], ey)), _mm_mul_ps(absZ[i], ez));
+				// dist + radius >= 0 表示包围盒至少有一部分在平面内侧
+				inside = _mm_and_ps(inside, _mm_cmpge_ps(_mm_add_ps(dist, radius), _mm_setzero_ps()));
+			}
+			int mask = _mm_movemask_ps(inside);
+			for (uint32_t lane = 0; lane < AD_FRUSTUM_CULL_SIMD_WIDTH; lane++) {
+				mVisibility[base + lane] = static_cast<uint8_t>((mask >> lane) & 1);
+			}
+		}
+		scalarBegin = paddedCount;
+#endif
+		CullScalar(scalarBegin, paddedCount);
+
+		mStats.objectCount = mObjectCount;
+		mStats.visibleCount = 0;
+		for (uint32_t i = 0; i < mObjectCount; i++) {
+			mStats.visibleCount += mVisibility[i];
+		}
+	}
+
+	void AdFrustumCuller::CullScalar(uint32_t begin, uint32_t end) {
+		for (uint32_t index = begin; index < end; index++) {
+			bool bInside = true;
+			for (const auto& plane : mFrustum.planes) {
+				float dist = plane.x * mCenterX[index] + plane.y * mCenterY[index] + plane.z * mCenterZ[index] + plane.w;
+				float radius = std::abs(plane.x) * mExtentX[index] + std::abs(plane.y) * mExtentY[index] + std::abs(plane.z) * mExtentZ[index];
+				if (dist + radius < 0.f) {
+					bInside = false;
+					break;
+				}
+			}
+			mVisibility[index] = bInside ? 1 : 0;
+		}
+	}
+}
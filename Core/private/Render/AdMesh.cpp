@@ -4,50 +4,129 @@
 
 namespace WuDu {
 	AdMesh::AdMesh(const std::vector<WuDu::AdVertex>& vertices, const std::vector<uint32_t>& indices) {
-		if (vertices.empty()) {
+		Create(sizeof(vertices[0]), vertices.data(), static_cast<uint32_t>(vertices.size()), indices);
+	}
+
+	AdMesh::AdMesh(const std::vector<WuDu::ModelVertex>& vertices, const std::vector<uint32_t>& indices) : mVertexFormat(AdVertexFormat::Model) {
+		Create(sizeof(vertices[0]), vertices.data(), static_cast<uint32_t>(vertices.size()), indices);
+	}
+
+	AdMesh::AdMesh(const WuDu::ModelMesh& modelMesh, AdVertexFormat format) : mBoundsMin(modelMesh.BoundsMin), mBoundsMax(modelMesh.BoundsMax), mBoundingSphere(modelMesh.BoundingSphere), mVertexFormat(format) {
+		if (format == AdVertexFormat::Packed) {
+			// 包围体仍为模型空间，剔除不受量化影响
+			std::vector<AdPackedVertex> packedVertices;
+			mDequantize = AdGeometryUtil::PackVertices(modelMesh.Vertices, packedVertices);
+			Create(sizeof(AdPackedVertex), packedVertices.data(), static_cast<uint32_t>(packedVertices.size()), modelMesh.Indices, false);
 			return;
 		}
-		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
-		WuDu::AdVKDevice* device = renderCxt->GetDevice();
+		mVertexFormat = AdVertexFormat::Model;
+		Create(sizeof(ModelVertex), modelMesh.Vertices.data(), static_cast<uint32_t>(modelMesh.Vertices.size()), modelMesh.Indices, false);
+	}
+
+	void AdMesh::GetVertexInputState(AdVertexFormat format, VkVertexInputBindingDescription* outBinding,
+		std::vector<VkVertexInputAttributeDescription>& outAttrs) {
+		outBinding->binding = 0;
+		outBinding->inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
+		outAttrs.clear();
+		switch (format) {
+		case AdVertexFormat::Packed:
+			outBinding->stride = sizeof(AdPackedVertex);
+			outAttrs = {
+				{ 0, 0, VK_FORMAT_R16G16B16A16_SNORM, offsetof(AdPackedVertex, Position) },
+				{ 1, 0, VK_FORMAT_R16G16_SFLOAT, offsetof(AdPackedVertex, TexCoord) },
+				{ 2, 0, VK_FORMAT_R16G16_SNORM, offsetof(AdPackedVertex, Normal) },
+				{ 3, 0, VK_FORMAT_R16G16_SNORM, offsetof(AdPackedVertex, Tangent) }
+			};
+			break;
+		case AdVertexFormat::Model:
+			outBinding->stride = sizeof(ModelVertex);
+			outAttrs = {
+				{ 0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(ModelVertex, Position) },
+				{ 1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(ModelVertex, TexCoord) },
+				{ 2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(ModelVertex, Normal) },
+				{ 3, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(ModelVertex, Tangent) },
+				{ 4, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(ModelVertex, Bitangent) }
+			};
+			break;
+		default:
+			outBinding->stride = sizeof(AdVertex);
+			outAttrs = {
+				{ 0, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(AdVertex, Position) },
+				{ 1, 0, VK_FORMAT_R32G32_SFLOAT, offsetof(AdVertex, TexCoord) },
+				{ 2, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(AdVertex, Normal) },
+				{ 3, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(AdVertex, Tangent) },
+				{ 4, 0, VK_FORMAT_R32G32B32_SFLOAT, offsetof(AdVertex, Bitangent) }
+			};
+			break;
+		}
+	}
 
-		mVertexCount = vertices.size();
-		mIndexCount = indices.size();
-		mVertexBuffer = std::make_shared<WuDu::AdVKBuffer>(device, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, sizeof(vertices[0]) * vertices.size(), (void*)vertices.data());
-		if (mIndexCount > 0) {
-			mIndexBuffer = std::make_shared<WuDu::AdVKBuffer>(device, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, sizeof(indices[0]) * indices.size(), (void*)indices.data());
+	AdMesh::~AdMesh() {
+		if (mPool) {
+			mPool->Free(mAllocation);
 		}
 	}
 
-	AdMesh::AdMesh(const std::vector<WuDu::ModelVertex>& vertices, const std::vector<uint32_t>& indices) {
-		if (vertices.empty()) {
+	// 顶点与索引从网格数据池的共享区块中子分配，数据进入上传批次
+	void AdMesh::Create(uint32_t vertexStride, const void* vertices, uint32_t vertexCount, const std::vector<uint32_t>& indices, bool bComputeBounds) {
+		if (vertexCount == 0) {
 			return;
 		}
-		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
-		WuDu::AdVKDevice* device = renderCxt->GetDevice();
 
-		mVertexCount = vertices.size();
-		mIndexCount = indices.size();
-		mVertexBuffer = std::make_shared<WuDu::AdVKBuffer>(device, VK_BUFFER_USAGE_VERTEX_BUFFER_BIT, sizeof(vertices[0]) * vertices.size(), (void*)vertices.data());
-		if (mIndexCount > 0) {
-			mIndexBuffer = std::make_shared<WuDu::AdVKBuffer>(device, VK_BUFFER_USAGE_INDEX_BUFFER_BIT, sizeof(indices[0]) * indices.size(), (void*)indices.data());
+		// 包围球取包围盒中心，半径为到最远顶点的距离；各顶点格式的第一个成员均为 Position
+		if (bComputeBounds) {
+			AdGeometryUtil::ComputeBounds(vertices, vertexStride, vertexCount, mBoundsMin, mBoundsMax, mBoundingSphere);
 		}
+
+		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
+		AdMeshPool* pool = renderCxt->GetMeshPool();
+		if (!pool->Allocate(vertexStride, vertices, vertexCount, indices.data(), static_cast<uint32_t>(indices.size()), &mAllocation)) {
+			LOG_E("Failed to allocate mesh: {0} vertices, {1} indices", vertexCount, indices.size());
+			return;
+		}
+		mPool = pool;
 	}
 
-	AdMesh::~AdMesh() {
+	glm::mat4 AdMesh::GetDequantizeTransform() const {
+		return glm::scale(glm::translate(glm::mat4(1.f), glm::vec3(mDequantize)), glm::vec3(mDequantize.w));
+	}
+
+	bool AdMesh::IsReady() const {
+		return mPool && mPool->IsReady(mAllocation);
+	}
+
+	VkBuffer AdMesh::GetVertexBuffer() const {
+		return mAllocation.vertexBuffer ? mAllocation.vertexBuffer->GetHandle() : VK_NULL_HANDLE;
+	}
 
+	VkBuffer AdMesh::GetIndexBuffer() const {
+		return mAllocation.indexBuffer ? mAllocation.indexBuffer->GetHandle() : VK_NULL_HANDLE;
 	}
 
 	void AdMesh::Draw(VkCommandBuffer cmdBuffer) {
-		VkBuffer vertexBuffers[] = { mVertexBuffer->GetHandle() };
+		// 顶点/索引数据仍在上传中时跳过本帧绘制
+		if (!IsReady()) {
+			return;
+		}
+		Bind(cmdBuffer);
+		DrawInstanced(cmdBuffer, 1, 0);
+	}
+
+	void AdMesh::Bind(VkCommandBuffer cmdBuffer) {
+		VkBuffer vertexBuffers[] = { GetVertexBuffer() };
 		VkDeviceSize offsets[] = { 0 };
 		vkCmdBindVertexBuffers(cmdBuffer, 0, 1, vertexBuffers, offsets);
+		if (mAllocation.indexCount > 0) {
+			vkCmdBindIndexBuffer(cmdBuffer, GetIndexBuffer(), 0, VK_INDEX_TYPE_UINT32);
+		}
+	}
 
-		if (mIndexCount > 0) {
-			vkCmdBindIndexBuffer(cmdBuffer, mIndexBuffer->GetHandle(), 0, VK_INDEX_TYPE_UINT32);
-			vkCmdDrawIndexed(cmdBuffer, mIndexCount, 1, 0, 0, 0);
+	void AdMesh::DrawInstanced(VkCommandBuffer cmdBuffer, uint32_t instanceCount, uint32_t firstInstance) {
+		if (mAllocation.indexCount > 0) {
+			vkCmdDrawIndexed(cmdBuffer, mAllocation.indexCount, instanceCount, mAllocation.firstIndex, static_cast<int32_t>(mAllocation.vertexOffset), firstInstance);
 		}
 		else {
-			vkCmdDraw(cmdBuffer, mVertexCount, 1, 0, 0);
+			vkCmdDraw(cmdBuffer, mAllocation.vertexCount, instanceCount, mAllocation.vertexOffset, firstInstance);
 		}
 	}
 }
\ No newline at end of file
@@ -0,0 +1,217 @@
+#include "Render/AdMeshPool.h"
+#include "Graphic/AdVKDevice.h"
+#include "Graphic/AdVKBuffer.h"
+#include "Graphic/AdVKUploadContext.h"
+
+namespace WuDu {
+	/**
+	 * @brief 构造网格数据池，区块在首次分配时按需创建
+	 *
+	 * @param device 逻辑设备
+	 * @param framesInFlight 帧并行数量，决定释放的区间延迟多少帧后复用
+	 */
+	AdMeshPool::AdMeshPool(AdVKDevice* device, uint32_t framesInFlight) : mDevice(device), mFramesInFlight(framesInFlight) {
+		mIndexArena.elementSize = sizeof(uint32_t);
+		mIndexArena.usage = VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+		mIndexArena.blockSize = AD_MESH_POOL_INDEX_BLOCK_SIZE;
+	}
+
+	AdMeshPool::~AdMeshPool() {
+		mPendingFrees.clear();
+		mVertexArenas.clear();
+		mIndexArena.blocks.clear();
+	}
+
+	/**
+	 * @brief 为一个网格分配顶点与索引区间，并把数据提交到上传批次
+	 *
+	 * @param vertexStride 顶点步长，相同步长的网格共用顶点区块
+	 * @param vertices 顶点数据
+	 * @param vertexCount 顶点数量
+	 * @param indices 索引数据，可为空
+	 * @param indexCount 索引数量
+	 * @param outAllocation 返回网格在共享缓冲区中的位置
+	 * @return 是否分配成功
+	 */
+	bool AdMeshPool::Allocate(uint32_t vertexStride, const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, AdMeshAllocation* outAllocation) {
+		if (vertexStride == 0 || vertexCount == 0) {
+			return false;
+		}
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		auto& vertexArena = mVertexArenas[vertexStride];
+		if (!vertexArena) {
+			vertexArena = std::make_unique<Arena>();
+			vertexArena->elementSize = vertexStride;
+			vertexArena->usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT;
+			vertexArena->blockSize = AD_MESH_POOL_VERTEX_BLOCK_SIZE;
+		}
+
+		AdMeshAllocation allocation = { .vertexStride = vertexStride, .vertexCount = vertexCount, .indexCount = indexCount };
+		Block* vertexBlock = AllocateRange(vertexArena.get(), vertexCount, &allocation.vertexOffset);
+		if (!vertexBlock) {
+			return false;
+		}
+		allocation.vertexBuffer = vertexBlock->buffer.get();
+
+		AdVKUploadContext* uploadCxt = mDevice->GetUploadContext();
+		allocation.uploadTicket = uploadCxt->UploadBuffer(vertexBlock->buffer->GetHandle(), vertices,
+			static_cast<VkDeviceSize>(vertexCount) * vertexStride, static_cast<VkDeviceSize>(allocation.vertexOffset) * vertexStride);
+
+		if (indexCount > 0) {
+			Block* indexBlock = AllocateRange(&mIndexArena, indexCount, &allocation.firstIndex);
+			if (!indexBlock) {
+				FreeRange(vertexBlock, allocation.vertexOffset, vertexCount);
+				return false;
+			}
+			allocation.indexBuffer = indexBlock->buffer.get();
+			uint64_t indexTicket = uploadCxt->UploadBuffer(indexBlock->buffer->GetHandle(), indices,
+				static_cast<VkDeviceSize>(indexCount) * sizeof(uint32_t), static_cast<VkDeviceSize>(allocation.firstIndex) * sizeof(uint32_t));
+			allocation.uploadTicket = std::max(allocation.uploadTicket, indexTicket);
+		}
+
+		*outAllocation = allocation;
+		return true;
+	}
+
+	/**
+	 * @brief 释放网格占用的区间，区间在在途帧结束后才真正回到空闲列表
+	 */
+	void AdMeshPool::Free(const AdMeshAllocation& allocation) {
+		if (!allocation.vertexBuffer) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (Block* block = FindBlock(allocation.vertexBuffer)) {
+			mPendingFrees.push_back({ block, allocation.vertexOffset, allocation.vertexCount, mFrameCounter, allocation.uploadTicket });
+		}
+		if (allocation.indexBuffer) {
+			if (Block* block = FindBlock(allocation.indexBuffer)) {
+				mPendingFrees.push_back({ block, allocation.firstIndex, allocation.indexCount, mFrameCounter, allocation.uploadTicket });
+			}
+		}
+	}
+
+	/**
+	 * @brief 推进帧号，回收释放于 framesInFlight 帧之前且上传已完成的区间
+	 *
+	 * 在帧围栏等待之后调用。
+	 */
+	void AdMeshPool::Update() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFrameCounter++;
+		if (mFrameCounter <= mFramesInFlight) {
+			return;
+		}
+		uint64_t completedFrame = mFrameCounter - mFramesInFlight;
+		AdVKUploadContext* uploadCxt = mDevice->GetUploadContext();
+		while (!mPendingFrees.empty() && mPendingFrees.front().frame <= completedFrame
+			&& uploadCxt->IsComplete(mPendingFrees.front().uploadTicket)) {
+			const PendingFree& pending = mPendingFrees.front();
+			FreeRange(pending.block, pending.offset, pending.count);
+			mPendingFrees.pop_front();
+		}
+	}
+
+	bool AdMeshPool::IsReady(const AdMeshAllocation& allocation) const {
+		return allocation.vertexBuffer && mDevice->GetUploadContext()->IsComplete(allocation.uploadTicket);
+	}
+
+	uint32_t AdMeshPool::GetBlockCount() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		size_t count = mIndexArena.blocks.size();
+		for (const auto& arena : mVertexArenas) {
+			count += arena.second->blocks.size();
+		}
+		return static_cast<uint32_t>(count);
+	}
+
+	VkDeviceSize AdMeshPool::GetUsedSize() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		VkDeviceSize size = 0;
+		for (const auto& block : mIndexArena.blocks) {
+			size += static_cast<VkDeviceSize>(block->usedCount) * mIndexArena.elementSize;
+		}
+		for (const auto& arena : mVertexArenas) {
+			for (const auto& block : arena.second->blocks) {
+				size += static_cast<VkDeviceSize>(block->usedCount) * arena.second->elementSize;
+			}
+		}
+		return size;
+	}
+
+	/**
+	 * @brief 在区块链中首次适配地分配 count 个连续元素，所有区块都放不下时追加新区块
+	 */
+	AdMeshPool::Block* AdMeshPool::AllocateRange(Arena* arena, uint32_t count, uint32_t* outOffset) {
+		for (const auto& block : arena->blocks) {
+			for (auto it = block->freeRanges.begin(); it != block->freeRanges.end(); ++it) {
+				if (it->second < count) {
+					continue;
+				}
+				uint32_t offset = it->first;
+				uint32_t remain = it->second - count;
+				block->freeRanges.erase(it);
+				if (remain > 0) {
+					block->freeRanges.emplace(offset + count, remain);
+				}
+				block->usedCount += count;
+				*outOffset = offset;
+				return block.get();
+			}
+		}
+
+		// 单个网格超过区块大小时为其单独创建一个恰好容纳的区块
+		uint32_t capacity = std::max(static_cast<uint32_t>(arena->blockSize / arena->elementSize), count);
+		auto block = std::make_unique<Block>();
+		block->buffer = std::make_shared<AdVKBuffer>(mDevice, arena->usage, static_cast<size_t>(capacity) * arena->elementSize);
+		if (block->buffer->GetHandle() == VK_NULL_HANDLE) {
+			return nullptr;
+		}
+		block->capacity = capacity;
+		block->usedCount = count;
+		if (capacity > count) {
+			block->freeRanges.emplace(count, capacity - count);
+		}
+		LOG_D("Mesh pool: new {0} block, {1} elements x {2} bytes",
+			arena->usage == VK_BUFFER_USAGE_INDEX_BUFFER_BIT ? "index" : "vertex", capacity, arena->elementSize);
+
+		*outOffset = 0;
+		arena->blocks.push_back(std::move(block));
+		return arena->blocks.back().get();
+	}
+
+	AdMeshPool::Block* AdMeshPool::FindBlock(AdVKBuffer* buffer) const {
+		for (const auto& block : mIndexArena.blocks) {
+			if (block->buffer.get() == buffer) {
+				return block.get();
+			}
+		}
+		for (const auto& arena : mVertexArenas) {
+			for (const auto& block : arena.second->blocks) {
+				if (block->buffer.get() == buffer) {
+					return block.get();
+				}
+			}
+		}
+		return nullptr;
+	}
+
+	// 归还区间并与前后相邻的空闲区间合并
+	void AdMeshPool::FreeRange(Block* block, uint32_t offset, uint32_t count) {
+		block->usedCount -= count;
+		auto next = block->freeRanges.lower_bound(offset);
+		if (next != block->freeRanges.end() && offset + count == next->first) {
+			count += next->second;
+			next = block->freeRanges.erase(next);
+		}
+		if (next != block->freeRanges.begin()) {
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset) {
+				prev->second += count;
+				return;
+			}
+		}
+		block->freeRanges.emplace(offset, count);
+	}
+}
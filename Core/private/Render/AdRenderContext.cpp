@@ -4,21 +4,26 @@ namespace WuDu {
 	/**
  * @brief AdRenderContext构造函数
  * @param window 窗口指针，用于创建图形上下文
+ * @param settings Vulkan设备配置（交换链图像数量、帧并行深度等）
  *
  * 该构造函数初始化渲染上下文模块，包括图形上下文、设备设置和交换链
  */
-	AdRenderContext::AdRenderContext(AdWindow* window) {
+	AdRenderContext::AdRenderContext(AdWindow* window, const AdVkSettings& settings) {
 		// 创建图形上下文
 		mGraphicContext = WuDu::AdGraphicContext::Create(window);
 		// 获取Vulkan图形上下文
 		auto vkContext = dynamic_cast<WuDu::AdVKGraphicContext*>(mGraphicContext.get());
 		// 创建Vulkan设备设置
-		mDevice = std::make_shared<WuDu::AdVKDevice>(vkContext, 1, 1);
+		mDevice = std::make_shared<WuDu::AdVKDevice>(vkContext, 1, 1, settings);
 		// 创建Vulkan交换链
 		mSwapchain = std::make_shared<WuDu::AdVKSwapchain>(vkContext, mDevice.get());
+		// 创建网格数据池，所有网格几何从其共享缓冲区中子分配
+		mMeshPool = std::make_shared<WuDu::AdMeshPool>(mDevice.get(), GetFramesInFlight());
 	}
 
 	AdRenderContext::~AdRenderContext() {
-
+		// 网格数据池的缓冲区可能仍被在途帧引用，需在设备销毁前等待空闲后释放
+		mDevice->WaitIdle();
+		mMeshPool.reset();
 	}
 }
\ No newline at end of file
@@ -0,0 +1,150 @@
+#include "Render/AdRenderQueue.h"
+#include "Render/AdMesh.h"
+
+namespace WuDu {
+	/**
+	 * @brief 组合排序键
+	 *
+	 * 状态从高位到低位依次为渲染阶段、管线、材质、网格，保证状态切换最少；深度放在最低位，
+	 * 同一批次内按由近到远排序。各字段超出位宽时截断，只影响排序效果，不影响正确性。
+	 *
+	 * @param pass 渲染阶段（AD_RENDER_PASS_*）
+	 * @param pipelineId 管线标识，使用 AdVKPipeline::GetSortId()；前 4096 个管线状态互不冲突
+	 * @param materialIndex 材质索引
+	 * @param meshId 网格标识
+	 * @param viewDepth 观察空间深度（到相机的距离，非负）
+	 */
+	uint64_t AdRenderQueue::MakeSortKey(uint32_t pass, uint32_t pipelineId, uint32_t materialIndex, uint32_t meshId, float viewDepth) {
+		// 非负浮点数的位模式与数值同序，取高16位（符号、指数和7位尾数）作为量化深度
+		float depth = std::max(viewDepth, 0.f);
+		uint32_t depthBits;
+		memcpy(&depthBits, &depth, sizeof(depthBits));
+
+		return (static_cast<uint64_t>(pass & 0xF) << AD_SORT_KEY_PASS_SHIFT)
+			| (static_cast<uint64_t>(pipelineId & 0xFFF) << AD_SORT_KEY_PIPELINE_SHIFT)
+			| (static_cast<uint64_t>(materialIndex & 0xFFFF) << AD_SORT_KEY_MATERIAL_SHIFT)
+			| (static_cast<uint64_t>(meshId & 0xFFFF) << AD_SORT_KEY_MESH_SHIFT)
+			| static_cast<uint64_t>(depthBits >> 16);
+	}
+
+	void AdRenderQueue::Clear() {
+		mPackets.clear();
+		mTransforms.clear();
+		mInstanceTransforms.clear();
+		mBatches.clear();
+		mStats = {};
+	}
+
+	void AdRenderQueue::Push(uint64_t sortKey, AdMaterial* material, AdMesh* mesh, const glm::mat4& transform) {
+		mPackets.push_back({ sortKey, material, mesh, static_cast<uint32_t>(mTransforms.size()) });
+		mTransforms.push_back(transform);
+	}
+
+	/**
+	 * @brief 排序并合并批次，生成实例变换数组
+	 */
+	void AdRenderQueue::Build() {
+		mInstanceTransforms.clear();
+		mBatches.clear();
+		mStats.packetCount = static_cast<uint32_t>(mPackets.size());
+		if (mPackets.empty()) {
+			return;
+		}
+
+		RadixSort();
+
+		mInstanceTransforms.reserve(mPackets.size());
+		for (const auto& packet : mPackets) {
+			bool bSameState = !mBatches.empty()
+				&& (mBatches.back().sortKey & AD_SORT_KEY_STATE_MASK) == (packet.sortKey & AD_SORT_KEY_STATE_MASK)
+				&& mBatches.back().material == packet.material
+				&& mBatches.back().mesh == packet.mesh;
+			if (!bSameState) {
+				mBatches.push_back({ packet.sortKey, packet.material, packet.mesh, static_cast<uint32_t>(mInstanceTransforms.size()), 0 });
+			}
+			mBatches.back().instanceCount++;
+			mInstanceTransforms.push_back(mTransforms[packet.transformIndex]);
+		}
+	}
+
+	/**
+	 * @brief 按排序顺序录制批次，消除冗余的材质与顶点缓冲绑定
+	 *
+	 * 网格位于网格数据池的共享区块中，只有顶点/索引缓冲区块变化时才需要重新绑定。
+	 *
+	 * @param cmdBuffer 命令缓冲
+	 * @param bindMaterial 材质变化时的绑定回调（描述符集、推送常量等）
+	 */
+	void AdRenderQueue::Record(VkCommandBuffer cmdBuffer, const std::function<void(AdMaterial*)>& bindMaterial,
+		const std::function<bool(AdVertexFormat)>& bindVertexFormat) {
+		AdMaterial* boundMaterial = nullptr;
+		AdVertexFormat boundFormat = AdVertexFormat::Float;
+		bool bFormatReady = true;
+		VkBuffer boundVertexBuffer = VK_NULL_HANDLE;
+		VkBuffer boundIndexBuffer = VK_NULL_HANDLE;
+		for (const auto& batch : mBatches) {
+			// 顶点/索引数据仍在上传中时跳过该批次
+			if (!batch.mesh->IsReady()) {
+				continue;
+			}
+			// 不同顶点格式对应不同管线，排序键中管线位不同，同格式的批次相邻
+			AdVertexFormat format = batch.mesh->GetVertexFormat();
+			if (format != boundFormat) {
+				boundFormat = format;
+				bFormatReady = bindVertexFormat ? bindVertexFormat(format) : false;
+			}
+			if (!bFormatReady) {
+				continue;
+			}
+			if (batch.material != boundMaterial) {
+				bindMaterial(batch.material);
+				boundMaterial = batch.material;
+				mStats.materialBindCount++;
+			}
+			if (batch.mesh->GetVertexBuffer() != boundVertexBuffer || batch.mesh->GetIndexBuffer() != boundIndexBuffer) {
+				batch.mesh->Bind(cmdBuffer);
+				boundVertexBuffer = batch.mesh->GetVertexBuffer();
+				boundIndexBuffer = batch.mesh->GetIndexBuffer();
+				mStats.meshBindCount++;
+			}
+			batch.mesh->DrawInstanced(cmdBuffer, batch.instanceCount, batch.firstInstance);
+			mStats.drawCount++;
+		}
+	}
+
+	/**
+	 * @brief 对绘制包按排序键做LSD基数排序（每轮8位，共8轮）
+	 *
+	 * 某一轮所有键在该字节上相同（常见于高位的阶段、管线字段）时跳过该轮。
+	 */
+	void AdRenderQueue::RadixSort() {
+		mSortScratch.resize(mPackets.size());
+		std::vector<Packet>* src = &mPackets;
+		std::vector<Packet>* dst = &mSortScratch;
+
+		for (uint32_t shift = 0; shift < 64; shift += 8) {
+			uint32_t counts[256] = {};
+			for (const auto& packet : *src) {
+				counts[(packet.sortKey >> shift) & 0xFF]++;
+			}
+			if (counts[((*src)[0].sortKey >> shift) & 0xFF] == src->size()) {
+				continue;
+			}
+
+			uint32_t offsets[256];
+			uint32_t sum = 0;
+			for (uint32_t i = 0; i < 256; i++) {
+				offsets[i] = sum;
+				sum += counts[i];
+			}
+			for (const auto& packet : *src) {
+				(*dst)[offsets[(packet.sortKey >> shift) & 0xFF]++] = packet;
+			}
+			std::swap(src, dst);
+		}
+
+		if (src != &mPackets) {
+			mPackets.swap(mSortScratch);
+		}
+	}
+}
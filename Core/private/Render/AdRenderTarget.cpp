@@ -205,6 +205,8 @@ void AdRenderTarget::Begin(VkCommandBuffer cmdBuffer) {
 
 	// 安全检查：确保当前帧缓冲存在且有效
 	if (mCurrentBufferIdx >= 0 && mCurrentBufferIdx < static_cast<int32_t>(mFrameBuffers.size())) {
+		// 材质系统的预处理（如GPU剔除）必须录制在渲染通道之外
+		PrepareMaterialSystems(cmdBuffer);
 		// 开始渲染通道
 		mRenderPass->Begin(cmdBuffer, GetFrameBuffer(), mClearValues);
 		bBeginTarget = true;
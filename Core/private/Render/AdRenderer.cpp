@@ -1,6 +1,9 @@
 #include "Render/AdRenderer.h"
 #include "AdApplication.h"
 #include "Graphic/AdVKQueue.h"
+#include "Graphic/AdVKUploadContext.h"
+#include "Graphic/AdVKDescriptorSet.h"
+#include "Graphic/AdVKBindlessTable.h"
 #include "Event/AdInputManager.h"
 #include "Event/AdEvent.h"
 
@@ -16,10 +19,10 @@ namespace WuDu {
 		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
 		WuDu::AdVKDevice* device = renderCxt->GetDevice();
 
-		// 创建同步对象数组，大小与帧缓冲数量匹配
-		mImageAvailableSemaphores.resize(RENDERER_NUM_BUFFER);
-		mSubmitedSemaphores.resize(RENDERER_NUM_BUFFER);
-		mFrameFences.resize(RENDERER_NUM_BUFFER);
+		// 创建同步对象数组，大小与帧并行深度匹配
+		mFramesInFlight = renderCxt->GetFramesInFlight();
+		mImageAvailableSemaphores.resize(mFramesInFlight);
+		mFrameFences.resize(mFramesInFlight);
 
 		// 信号量创建信息
 		VkSemaphoreCreateInfo semaphoreInfo = {
@@ -36,12 +39,13 @@ namespace WuDu {
 
 		};
 
-		// 为每个帧缓冲创建同步对象：图像可用信号量、提交信号量和帧围栏
-		for (int i = 0; i < RENDERER_NUM_BUFFER; i++) {
+		// 为每个帧槽位创建同步对象：图像可用信号量和帧围栏
+		for (uint32_t i = 0; i < mFramesInFlight; i++) {
 			CALL_VK(vkCreateSemaphore(device->GetHandle(), &semaphoreInfo, nullptr, &mImageAvailableSemaphores[i]));
-			CALL_VK(vkCreateSemaphore(device->GetHandle(), &semaphoreInfo, nullptr, &mSubmitedSemaphores[i]));
 			CALL_VK(vkCreateFence(device->GetHandle(), &fenceInfo, nullptr, &mFrameFences[i]));
 		}
+		// 提交信号量按交换链图像创建
+		CreateSubmitedSemaphores();
 
 		// 监听窗口大小变化事件
 		WuDu::InputManager::GetInstance().Subscribe<WuDu::WindowResizeEvent>([this](WuDu::WindowResizeEvent& event) {
@@ -57,14 +61,40 @@ namespace WuDu {
 		for (const auto& item : mImageAvailableSemaphores) {
 			VK_D(Semaphore, device->GetHandle(), item);
 		}
-		for (const auto& item : mSubmitedSemaphores) {
-			VK_D(Semaphore, device->GetHandle(), item);
-		}
+		DestroySubmitedSemaphores();
 		for (const auto& item : mFrameFences) {
 			VK_D(Fence, device->GetHandle(), item);
 		}
 	}
 
+	/**
+	 * @brief 为每个交换链图像创建一个提交(渲染完成)信号量，呈现该图像时等待它
+	 *
+	 * 同一图像在再次被获取之前，上一次对它的呈现必然已读取过该信号量，因此按图像索引复用是安全的。
+	 * 交换链重建后图像数量可能变化，需在设备空闲时销毁并重新创建。
+	 */
+	void AdRenderer::CreateSubmitedSemaphores() {
+		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
+		WuDu::AdVKDevice* device = renderCxt->GetDevice();
+		VkSemaphoreCreateInfo semaphoreInfo = {
+			.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0
+		};
+		mSubmitedSemaphores.resize(renderCxt->GetSwapchain()->GetImages().size());
+		for (auto& semaphore : mSubmitedSemaphores) {
+			CALL_VK(vkCreateSemaphore(device->GetHandle(), &semaphoreInfo, nullptr, &semaphore));
+		}
+	}
+
+	void AdRenderer::DestroySubmitedSemaphores() {
+		WuDu::AdVKDevice* device = AdApplication::GetAppContext()->renderCxt->GetDevice();
+		for (const auto& item : mSubmitedSemaphores) {
+			VK_D(Semaphore, device->GetHandle(), item);
+		}
+		mSubmitedSemaphores.clear();
+	}
+
 	/**
  * @brief 准备开始一帧的渲染，包括等待上一帧完成、获取下一个交换链图像索引
  *        并在需要时重建交换链
@@ -85,16 +115,30 @@ namespace WuDu {
 		WuDu::AdVKSwapchain* swapchain = renderCxt->GetSwapchain();
 
 		bool bShouldUpdateTarget = false;
+		mFrameWaitIdleBase = device->GetWaitIdleCount();
+		mFrameDescriptorWriteBase = DescriptorSetWriter::GetWriteCount();
 
-		// 等待当前帧的Fence，确保上一帧完成
+		// 等待当前帧槽位的Fence，确保该槽位上一次提交(mFramesInFlight帧之前)已经完成
+		// 这是帧间唯一的CPU/GPU同步点，其它帧可以继续在GPU上执行
 		CALL_VK(vkWaitForFences(device->GetHandle(), 1, &mFrameFences[mCurrentBuffer], VK_TRUE, UINT64_MAX));
 		// 重置Fence，为当前帧做准备
 		CALL_VK(vkResetFences(device->GetHandle(), 1, &mFrameFences[mCurrentBuffer]));
 
+		// 回收已完成的上传批次（对应资源变为就绪），并提交上一帧之后累积的上传
+		AdVKUploadContext* uploadCxt = device->GetUploadContext();
+		uploadCxt->Update();
+		uploadCxt->Flush();
+
+		// 当前槽位的围栏已触发，回收已不被在途帧引用的无绑定索引
+		if (AdVKBindlessTable* bindlessTable = device->GetBindlessTable()) {
+			bindlessTable->Update();
+		}
+		renderCxt->GetMeshPool()->Update();
+
 		// 如果需要重建交换链(窗口大小变化)，先重建交换链再继续AcquireImage的调用
 		if (mNeedSwapchainRecreate) {
 			// 等待设备空闲，确保完全重建
-			CALL_VK(vkDeviceWaitIdle(device->GetHandle()));
+			device->WaitIdle();
 			VkExtent2D originExtent = { swapchain->GetWidth(), swapchain->GetHeight() };
 			
 			// 强制重建交换链，确保获取最新的窗口大小
@@ -102,6 +146,8 @@ namespace WuDu {
 			
 			// 重建交换链，会在内部调用SetupSurfaceCapabilities()
 			swapchain->ReCreate();
+			DestroySubmitedSemaphores();
+			CreateSubmitedSemaphores();
 			
 			VkExtent2D newExtent = { swapchain->GetWidth(), swapchain->GetHeight() };
 			
@@ -127,11 +173,13 @@ namespace WuDu {
 		// 如果获取失败(如：窗口大小变化)，则重建交换链
 		if (ret == VK_ERROR_OUT_OF_DATE_KHR) {
 			// 等待设备空闲，确保完全重建
-			CALL_VK(vkDeviceWaitIdle(device->GetHandle()));
+			device->WaitIdle();
 			VkExtent2D originExtent = { swapchain->GetWidth(), swapchain->GetHeight() };
 			
 			// 重建交换链
 			bool bSuc = swapchain->ReCreate();
+			DestroySubmitedSemaphores();
+			CreateSubmitedSemaphores();
 
 			VkExtent2D newExtent = { swapchain->GetWidth(), swapchain->GetHeight() };
 			// 当交换链重建时，设置为true，确保渲染目标被更新
@@ -147,6 +195,9 @@ namespace WuDu {
 			}
 		}
 
+		// 通知渲染上下文当前帧槽位，供材质系统选择每帧资源
+		renderCxt->SetCurrentFrameIndex(mCurrentBuffer);
+
 		// 将结果返回给调用者
 		if (outImageIndex) {
 			*outImageIndex = static_cast<int32_t>(imageIndex);
@@ -172,17 +223,20 @@ namespace WuDu {
 		WuDu::AdVKSwapchain* swapchain = renderCxt->GetSwapchain();
 		bool bShouldUpdateTarget = false;
 
-		// 提交命令缓冲区到图形队列，并等待信号量
-		device->GetFirstGraphicQueue()->Submit(cmdBuffers, { mImageAvailableSemaphores[mCurrentBuffer] }, { mSubmitedSemaphores[mCurrentBuffer] }, mFrameFences[mCurrentBuffer]);
+		// 提交命令缓冲区到图形队列，并等待信号量；呈现等待的信号量按图像索引选取
+		VkSemaphore submitedSemaphore = mSubmitedSemaphores[imageIndex];
+		device->GetFirstGraphicQueue()->Submit(cmdBuffers, { mImageAvailableSemaphores[mCurrentBuffer] }, { submitedSemaphore }, mFrameFences[mCurrentBuffer]);
 
 		// 执行图像呈现操作
-		VkResult ret = swapchain->Present(imageIndex, { mSubmitedSemaphores[mCurrentBuffer] });
+		VkResult ret = swapchain->Present(imageIndex, { submitedSemaphore });
 
 		// 如果呈现结果为次优的，则需要重建交换链
 		if (ret == VK_SUBOPTIMAL_KHR) {
-			CALL_VK(vkDeviceWaitIdle(device->GetHandle()));
+			device->WaitIdle();
 			VkExtent2D originExtent = { swapchain->GetWidth(), swapchain->GetHeight() };
 			bool bSuc = swapchain->ReCreate();
+			DestroySubmitedSemaphores();
+			CreateSubmitedSemaphores();
 
 			VkExtent2D newExtent = { swapchain->GetWidth(), swapchain->GetHeight() };
 			// 当交换链重建时，设置为true，确保渲染目标被更新
@@ -192,9 +246,10 @@ namespace WuDu {
 			}
 		}
 
-		// 等待设备完成当前所有操作
-		CALL_VK(vkDeviceWaitIdle(device->GetHandle()));
-		mCurrentBuffer = (mCurrentBuffer + 1) % RENDERER_NUM_BUFFER;
+		// 不再等待设备空闲，直接推进到下一个帧槽位，由该槽位的Fence保证资源可复用
+		mLastFrameWaitIdleCount = static_cast<uint32_t>(device->GetWaitIdleCount() - mFrameWaitIdleBase);
+		mLastFrameDescriptorWriteCount = static_cast<uint32_t>(DescriptorSetWriter::GetWriteCount() - mFrameDescriptorWriteBase);
+		mCurrentBuffer = (mCurrentBuffer + 1) % mFramesInFlight;
 		return bShouldUpdateTarget;
 	}
 }
\ No newline at end of file
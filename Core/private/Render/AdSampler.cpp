@@ -1,6 +1,7 @@
 
 #include "Render/AdSampler.h"
 #include "AdApplication.h"
+#include "Graphic/AdVKBindlessTable.h"
 
 namespace WuDu {
 	AdSampler::AdSampler(const Settings& settings)
@@ -19,6 +20,9 @@ namespace WuDu {
 	}
 
 	AdSampler::~AdSampler() {
+		if (AdVKBindlessTable* bindlessTable = mDevice->GetBindlessTable()) {
+			bindlessTable->ReleaseSampler(mBindlessIndex);
+		}
 		if (mHandle != VK_NULL_HANDLE) {
 			vkDestroySampler(mDevice->GetHandle(), mHandle, nullptr);
 		}
@@ -46,5 +50,9 @@ namespace WuDu {
 		if (vkCreateSampler(mDevice->GetHandle(), &samplerInfo, nullptr, &mHandle) != VK_SUCCESS) {
 			throw std::runtime_error("failed to create texture sampler!");
 		}
+
+		if (AdVKBindlessTable* bindlessTable = mDevice->GetBindlessTable()) {
+			mBindlessIndex = bindlessTable->RegisterSampler(mHandle);
+		}
 	}
 }
\ No newline at end of file
@@ -6,6 +6,8 @@
 #include "Graphic/AdVKImage.h"
 #include "Graphic/AdVKImageView.h"
 #include "Graphic/AdVKBuffer.h"
+#include "Graphic/AdVKUploadContext.h"
+#include "Graphic/AdVKBindlessTable.h"
 
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb/stb_image.h"
@@ -50,17 +52,23 @@ namespace WuDu {
 	}
 
 	AdTexture::~AdTexture() {
+		// 上传尚未完成时不能释放目标图像
+		WaitReady();
+		AdVKBindlessTable* bindlessTable = AdApplication::GetAppContext()->renderCxt->GetDevice()->GetBindlessTable();
+		if (bindlessTable) {
+			bindlessTable->ReleaseTexture(mBindlessIndex);
+		}
 		mImageView.reset();
 		mImage.reset();
 	}
 
 	/**
-	* @brief 创建纹理图像并上传数据
+	* @brief 创建纹理图像并提交数据上传
 	* @param size 图像数据的大小(字节)
-	* @param data 指向图像数据的指针
+	* @param data 指向图像数据的指针，函数返回后即可释放
 	*
-	* 该方法负责创建Vulkan图像资源、图像视图和采样器，并将图像数据上传到GPU内存中
-	* 管理图像布局转换和数据传输到纹理内存
+	* 该方法负责创建Vulkan图像资源和图像视图，像素数据写入上传上下文的暂存区，
+	* 复制与布局转换随上传批次一起提交，不阻塞等待
 	*/
 	void AdTexture::CreateImage(size_t size, void* data) {
 		WuDu::AdRenderContext* renderCxt = AdApplication::GetAppContext()->renderCxt;
@@ -70,22 +78,27 @@ namespace WuDu {
 		mImage = std::make_shared<AdVKImage>(device, VkExtent3D{ mWidth, mHeight, 1 }, mFormat, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_SAMPLE_COUNT_1_BIT);
 		mImageView = std::make_shared<AdVKImageView>(device, mImage->GetHandle(), mFormat, VK_IMAGE_ASPECT_COLOR_BIT);
 
+		// 上传完成后图像处于 VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL 布局
+		mUploadTicket = device->GetUploadContext()->UploadImage(mImage.get(), data, size);
+		// 注册到无绑定纹理数组，上传完成前材质仍引用默认纹理的索引
+		if (AdVKBindlessTable* bindlessTable = device->GetBindlessTable()) {
+			mBindlessIndex = bindlessTable->RegisterTexture(mImageView->GetHandle());
+		}
+	}
 
-		// 创建临时数据缓冲区用于数据传输
-		std::shared_ptr<AdVKBuffer> stageBuffer = std::make_shared<AdVKBuffer>(device, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, size, data, true);
-
-
-		// 执行图像布局转换和数据传输操作
-		VkCommandBuffer cmdBuffer = device->CreateAndBeginOneCmdBuffer();
-		// 将图像布局从VK_IMAGE_LAYOUT_UNDEFINED转换为VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL，为数据传输做准备
-		AdVKImage::TransitionLayout(cmdBuffer, mImage->GetHandle(), VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-		// 将数据从临时缓冲区复制到图像
-		mImage->CopyFromBuffer(cmdBuffer, stageBuffer.get());
-		// 将图像布局从VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL转换为VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL，供着色器读取使用
-		AdVKImage::TransitionLayout(cmdBuffer, mImage->GetHandle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		device->SubmitOneCmdBuffer(cmdBuffer);
+	bool AdTexture::IsReady() const {
+		if (mUploadTicket == 0) {
+			return true;
+		}
+		WuDu::AdVKDevice* device = AdApplication::GetAppContext()->renderCxt->GetDevice();
+		return device->GetUploadContext()->IsComplete(mUploadTicket);
+	}
 
-		// 释放临时缓冲区
-		stageBuffer.reset();
+	void AdTexture::WaitReady() const {
+		if (IsReady()) {
+			return;
+		}
+		WuDu::AdVKDevice* device = AdApplication::GetAppContext()->renderCxt->GetDevice();
+		device->GetUploadContext()->Wait(mUploadTicket);
 	}
-}
\ No newline at end of file
+}
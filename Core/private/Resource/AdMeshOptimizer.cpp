@@ -0,0 +1,325 @@
+#include "Resource/AdMeshOptimizer.h"
+
+#define AD_MESH_OPTIMIZER_INVALID_VERTEX        UINT32_MAX
+
+namespace WuDu {
+	/**
+	 * @brief 用时间戳模拟 FIFO 顶点缓存
+	 *
+	 * 顶点的时间戳距当前时间超过缓存大小即视为已被挤出；把当前时间前移 cacheSize + 1 即可清空缓存。
+	 */
+	struct VertexCacheSimulator {
+		std::vector<uint32_t> timestamps;
+		uint32_t time;
+		uint32_t cacheSize;
+
+		VertexCacheSimulator(uint32_t vertexCount, uint32_t size) : timestamps(vertexCount, 0), time(size + 1), cacheSize(size) {}
+
+		// 访问一个顶点，未命中时返回 1
+		uint32_t Access(uint32_t vertex) {
+			if (time - timestamps[vertex] > cacheSize) {
+				timestamps[vertex] = time++;
+				return 1;
+			}
+			return 0;
+		}
+
+		uint32_t AccessTriangle(const uint32_t* triangle) {
+			return Access(triangle[0]) + Access(triangle[1]) + Access(triangle[2]);
+		}
+
+		void Flush() {
+			time += cacheSize + 1;
+		}
+	};
+
+	AdVertexCacheStats AdMeshOptimizer::AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount, uint32_t cacheSize) {
+		AdVertexCacheStats stats;
+		VertexCacheSimulator cache(vertexCount, cacheSize);
+		std::vector<uint8_t> referenced(vertexCount, 0);
+		for (uint32_t index : indices) {
+			stats.cacheMisses += cache.Access(index);
+			if (!referenced[index]) {
+				referenced[index] = 1;
+				stats.vertexCount++;
+			}
+		}
+		stats.triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		return stats;
+	}
+
+	/**
+	 * @brief 对单个网格执行顶点缓存、过度绘制与顶点读取三项优化
+	 *
+	 * 只处理三角形列表；索引越界或不是 3 的倍数时保持网格不变。
+	 *
+	 * @param mesh 待优化网格，顶点与索引原地重写
+	 * @param outBefore 可选，优化前的顶点缓存统计
+	 * @param outAfter 可选，优化后的顶点缓存统计
+	 */
+	void AdMeshOptimizer::Optimize(ModelMesh& mesh, AdVertexCacheStats* outBefore, AdVertexCacheStats* outAfter) {
+		const uint32_t vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+		bool bValid = mesh.Indices.size() >= 3 && mesh.Indices.size() % 3 == 0;
+		for (size_t i = 0; bValid && i < mesh.Indices.size(); i++) {
+			bValid = mesh.Indices[i] < vertexCount;
+		}
+		if (!bValid) {
+			if (outBefore) {
+				*outBefore = {};
+			}
+			if (outAfter) {
+				*outAfter = {};
+			}
+			return;
+		}
+
+		if (outBefore) {
+			*outBefore = AnalyzeVertexCache(mesh.Indices, vertexCount);
+		}
+		std::vector<uint32_t> hardClusters;
+		OptimizeVertexCache(mesh.Indices, vertexCount, &hardClusters);
+		OptimizeOverdraw(mesh.Indices, mesh.Vertices, hardClusters);
+		OptimizeVertexFetch(mesh.Indices, mesh.Vertices);
+		mesh.VertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+		mesh.IndexCount = static_cast<uint32_t>(mesh.Indices.size());
+		if (outAfter) {
+			*outAfter = AnalyzeVertexCache(mesh.Indices, mesh.VertexCount);
+		}
+	}
+
+	/**
+	 * @brief Tipsify 顶点缓存排序
+	 *
+	 * 以一个扇心顶点输出其全部未输出的相邻三角形，再从刚输出的顶点中选下一个扇心：
+	 * 优先选仍在缓存中、且输出其剩余三角形后不会被挤出缓存的顶点。没有候选时为死端，
+	 * 从最近输出的顶点栈或按顶点序号顺序寻找仍有剩余三角形的顶点，此处记为一个硬簇边界。
+	 *
+	 * @param indices 三角形列表索引，原地重排
+	 * @param vertexCount 顶点数
+	 * @param outClusters 可选，输出各硬簇起始三角形序号
+	 * @param cacheSize 目标缓存大小
+	 */
+	void AdMeshOptimizer::OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount,
+											std::vector<uint32_t>* outClusters, uint32_t cacheSize) {
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (outClusters) {
+			outClusters->clear();
+		}
+		if (triangleCount == 0) {
+			return;
+		}
+
+		// 顶点到三角形的邻接表
+		std::vector<uint32_t> liveCounts(vertexCount, 0);
+		for (uint32_t index : indices) {
+			liveCounts[index]++;
+		}
+		std::vector<uint32_t> adjacencyOffsets(vertexCount + 1, 0);
+		for (uint32_t v = 0; v < vertexCount; v++) {
+			adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveCounts[v];
+		}
+		std::vector<uint32_t> adjacency(indices.size());
+		{
+			std::vector<uint32_t> cursors(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+			for (uint32_t i = 0; i < indices.size(); i++) {
+				adjacency[cursors[indices[i]]++] = i / 3;
+			}
+		}
+
+		std::vector<uint32_t> cacheTimes(vertexCount, 0);
+		uint32_t time = cacheSize + 1;
+		std::vector<uint8_t> emitted(triangleCount, 0);
+		std::vector<uint32_t> deadEndStack;
+		deadEndStack.reserve(indices.size());
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		uint32_t scanCursor = 0;
+
+		if (outClusters) {
+			outClusters->push_back(0);
+		}
+		uint32_t fanning = indices[0];
+		while (fanning != AD_MESH_OPTIMIZER_INVALID_VERTEX) {
+			// 输出扇心的所有未输出三角形
+			candidates.clear();
+			for (uint32_t a = adjacencyOffsets[fanning]; a < adjacencyOffsets[fanning + 1]; a++) {
+				uint32_t triangle = adjacency[a];
+				if (emitted[triangle]) {
+					continue;
+				}
+				emitted[triangle] = 1;
+				for (uint32_t k = 0; k < 3; k++) {
+					uint32_t v = indices[triangle * 3 + k];
+					result.push_back(v);
+					deadEndStack.push_back(v);
+					candidates.push_back(v);
+					liveCounts[v]--;
+					if (time - cacheTimes[v] > cacheSize) {
+						cacheTimes[v] = time++;
+					}
+				}
+			}
+
+			// 在刚输出的顶点中选择下一个扇心
+			uint32_t next = AD_MESH_OPTIMIZER_INVALID_VERTEX;
+			int64_t bestPriority = -1;
+			for (uint32_t v : candidates) {
+				if (liveCounts[v] == 0) {
+					continue;
+				}
+				int64_t age = static_cast<int64_t>(time) - cacheTimes[v];
+				int64_t priority = age + 2 * static_cast<int64_t>(liveCounts[v]) <= cacheSize ? age : 0;
+				if (priority > bestPriority) {
+					bestPriority = priority;
+					next = v;
+				}
+			}
+
+			// 死端：先回溯最近输出的顶点，再按序号扫描
+			if (next == AD_MESH_OPTIMIZER_INVALID_VERTEX) {
+				while (!deadEndStack.empty()) {
+					uint32_t v = deadEndStack.back();
+					deadEndStack.pop_back();
+					if (liveCounts[v] > 0) {
+						next = v;
+						break;
+					}
+				}
+				while (next == AD_MESH_OPTIMIZER_INVALID_VERTEX && scanCursor < vertexCount) {
+					if (liveCounts[scanCursor] > 0) {
+						next = scanCursor;
+					}
+					scanCursor++;
+				}
+				uint32_t emittedTriangles = static_cast<uint32_t>(result.size() / 3);
+				if (outClusters && next != AD_MESH_OPTIMIZER_INVALID_VERTEX && emittedTriangles > outClusters->back()) {
+					outClusters->push_back(emittedTriangles);
+				}
+			}
+			fanning = next;
+		}
+		indices.swap(result);
+	}
+
+	/**
+	 * @brief 过度绘制排序
+	 *
+	 * 硬簇内部继续切分：从簇起点模拟缓存，局部 ACMR 不超过该硬簇 ACMR 的 threshold 倍时在此处切开并清空缓存，
+	 * 这样簇之间任意重排对顶点缓存的影响有上界。然后按簇的面积加权中心相对网格中心在簇法线方向上的投影
+	 * 从大到小排序：朝外的簇先绘制，更可能遮挡后绘制的簇。
+	 *
+	 * @param indices 已经过顶点缓存排序的索引，原地重排
+	 * @param vertices 顶点数据，用于计算簇的位置与朝向
+	 * @param hardClusters OptimizeVertexCache 输出的硬簇起点
+	 * @param threshold 允许的 ACMR 劣化比例
+	 * @param cacheSize 模拟缓存大小
+	 */
+	void AdMeshOptimizer::OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<ModelVertex>& vertices,
+										const std::vector<uint32_t>& hardClusters, float threshold, uint32_t cacheSize) {
+		const uint32_t triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount == 0 || hardClusters.empty()) {
+			return;
+		}
+
+		// 在硬簇内切分软簇
+		VertexCacheSimulator cache(static_cast<uint32_t>(vertices.size()), cacheSize);
+		std::vector<uint32_t> clusters;
+		for (size_t c = 0; c < hardClusters.size(); c++) {
+			uint32_t start = hardClusters[c];
+			uint32_t end = c + 1 < hardClusters.size() ? hardClusters[c + 1] : triangleCount;
+
+			cache.Flush();
+			uint32_t clusterMisses = 0;
+			for (uint32_t t = start; t < end; t++) {
+				clusterMisses += cache.AccessTriangle(&indices[t * 3]);
+			}
+			float clusterThreshold = threshold * static_cast<float>(clusterMisses) / static_cast<float>(end - start);
+
+			cache.Flush();
+			clusters.push_back(start);
+			uint32_t localStart = start;
+			uint32_t localMisses = 0;
+			for (uint32_t t = start; t < end; t++) {
+				localMisses += cache.AccessTriangle(&indices[t * 3]);
+				if (t + 1 < end && static_cast<float>(localMisses) / static_cast<float>(t + 1 - localStart) <= clusterThreshold) {
+					clusters.push_back(t + 1);
+					cache.Flush();
+					localStart = t + 1;
+					localMisses = 0;
+				}
+			}
+		}
+		if (clusters.size() < 2) {
+			return;
+		}
+
+		// 网格中心：所有三角形顶点的平均位置
+		glm::dvec3 meshCenter(0.0);
+		for (uint32_t index : indices) {
+			meshCenter += glm::dvec3(vertices[index].Position);
+		}
+		meshCenter /= static_cast<double>(indices.size());
+
+		// 每个簇的排序键
+		std::vector<float> sortKeys(clusters.size());
+		for (size_t c = 0; c < clusters.size(); c++) {
+			uint32_t start = clusters[c];
+			uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+			glm::vec3 center(0.f);
+			glm::vec3 normal(0.f);
+			float area = 0.f;
+			for (uint32_t t = start; t < end; t++) {
+				const glm::vec3& p0 = vertices[indices[t * 3 + 0]].Position;
+				const glm::vec3& p1 = vertices[indices[t * 3 + 1]].Position;
+				const glm::vec3& p2 = vertices[indices[t * 3 + 2]].Position;
+				glm::vec3 triangleNormal = glm::cross(p1 - p0, p2 - p0);
+				float triangleArea = glm::length(triangleNormal);
+				center += (p0 + p1 + p2) * (triangleArea / 3.f);
+				normal += triangleNormal;
+				area += triangleArea;
+			}
+			float normalLength = glm::length(normal);
+			if (area > 0.f && normalLength > 0.f) {
+				center /= area;
+				sortKeys[c] = glm::dot(center - glm::vec3(meshCenter), normal / normalLength);
+			} else {
+				sortKeys[c] = 0.f;
+			}
+		}
+
+		std::vector<uint32_t> order(clusters.size());
+		for (uint32_t c = 0; c < order.size(); c++) {
+			order[c] = c;
+		}
+		std::stable_sort(order.begin(), order.end(), [&sortKeys](uint32_t a, uint32_t b) {
+			return sortKeys[a] > sortKeys[b];
+		});
+
+		std::vector<uint32_t> result;
+		result.reserve(indices.size());
+		for (uint32_t c : order) {
+			uint32_t start = clusters[c];
+			uint32_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+			result.insert(result.end(), indices.begin() + start * 3, indices.begin() + end * 3);
+		}
+		indices.swap(result);
+	}
+
+	/**
+	 * @brief 按索引首次引用顺序重排顶点，丢弃未被引用的顶点
+	 */
+	void AdMeshOptimizer::OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<ModelVertex>& vertices) {
+		std::vector<uint32_t> remap(vertices.size(), AD_MESH_OPTIMIZER_INVALID_VERTEX);
+		std::vector<ModelVertex> result;
+		result.reserve(vertices.size());
+		for (uint32_t& index : indices) {
+			if (remap[index] == AD_MESH_OPTIMIZER_INVALID_VERTEX) {
+				remap[index] = static_cast<uint32_t>(result.size());
+				result.push_back(vertices[index]);
+			}
+			index = remap[index];
+		}
+		vertices.swap(result);
+	}
+}
@@ -0,0 +1,286 @@
+#include "Resource/AdModelCache.h"
+#include "AdMappedFile.h"
+#include "Adlog.h"
+
+namespace WuDu {
+	static uint64_t AlignOffset(uint64_t offset) {
+		return (offset + AD_MODEL_CACHE_ALIGNMENT - 1) & ~static_cast<uint64_t>(AD_MODEL_CACHE_ALIGNMENT - 1);
+	}
+
+	/**
+	 * @brief 按 8 字节字宽计算 64 位哈希
+	 *
+	 * 每次缓存加载都要对整个源文件求哈希，逐字节的 FNV-1a 对上百 MB 的模型太慢；
+	 * 这里用 4 路互不依赖的乘法链并行处理 32 字节，最后再合并。
+	 */
+	static uint64_t HashMemory(const uint8_t* data, size_t size, uint64_t seed) {
+		const uint64_t prime = 1099511628211ull;
+		uint64_t lanes[4] = { seed, seed ^ 0x9E3779B97F4A7C15ull, seed ^ 0xC2B2AE3D27D4EB4Full, seed ^ 0x165667B19E3779F9ull };
+		size_t i = 0;
+		for (; i + 32 <= size; i += 32) {
+			for (uint32_t lane = 0; lane < 4; lane++) {
+				uint64_t word;
+				memcpy(&word, data + i + lane * 8, sizeof(word));
+				lanes[lane] = (lanes[lane] ^ word) * prime;
+				lanes[lane] ^= lanes[lane] >> 29;
+			}
+		}
+		uint64_t hash = size;
+		for (uint32_t lane = 0; lane < 4; lane++) {
+			hash = (hash ^ lanes[lane]) * prime;
+		}
+		for (; i < size; i++) {
+			hash = (hash ^ data[i]) * prime;
+		}
+		return hash;
+	}
+
+	// 缓存文件与源文件放在同一目录，例如 Phainon.fbx -> Phainon.fbx.admesh
+	std::string AdModelCache::GetCachePath(const std::string& sourcePath) {
+		return sourcePath + AD_MODEL_CACHE_EXTENSION;
+	}
+
+	/**
+	 * @brief 计算源文件内容、导入选项与缓存格式版本的组合哈希
+	 *
+	 * @param sourcePath 源模型文件
+	 * @param importFlags Assimp 导入选项
+	 * @param settings 引擎侧导入选项
+	 * @param outHash 输出哈希
+	 * @return 源文件无法读取时返回 false
+	 */
+	bool AdModelCache::ComputeSourceHash(const std::string& sourcePath, uint32_t importFlags, const AdModelImportSettings& settings, uint64_t* outHash) {
+		AdMappedFile sourceFile;
+		if (!sourceFile.Open(sourcePath)) {
+			return false;
+		}
+		uint64_t seed = 14695981039346656037ull;
+		seed = (seed ^ importFlags) * 1099511628211ull;
+		seed = (seed ^ AD_MODEL_CACHE_VERSION) * 1099511628211ull;
+		seed = (seed ^ static_cast<uint64_t>(settings.bOptimizeMeshes)) * 1099511628211ull;
+		*outHash = HashMemory(sourceFile.GetData(), sourceFile.GetSize(), seed);
+		return true;
+	}
+
+	/**
+	 * @brief 从缓存文件加载网格与材质
+	 *
+	 * 任何校验失败(格式版本、源哈希、顶点布局、越界偏移)都返回 false，且不修改输出参数，
+	 * 调用方应回退到 Assimp 导入并重新生成缓存。
+	 */
+	bool AdModelCache::Load(const std::string& cachePath, uint64_t sourceHash,
+							std::vector<ModelMesh>& meshes,
+							std::vector<ModelMaterial>& materials) {
+		AdMappedFile cacheFile;
+		if (!cacheFile.Open(cachePath)) {
+			return false;
+		}
+		const uint8_t* data = cacheFile.GetData();
+		const uint64_t fileSize = cacheFile.GetSize();
+		if (fileSize < sizeof(AdModelCacheHeader)) {
+			return false;
+		}
+
+		AdModelCacheHeader header;
+		memcpy(&header, data, sizeof(header));
+		if (header.magic != AD_MODEL_CACHE_MAGIC || header.version != AD_MODEL_CACHE_VERSION) {
+			LOG_W("Model cache {0} has an unknown format, ignore it.", cachePath);
+			return false;
+		}
+		if (header.sourceHash != sourceHash || header.vertexStride != sizeof(ModelVertex) || header.fileSize != fileSize) {
+			LOG_D("Model cache {0} is out of date.", cachePath);
+			return false;
+		}
+
+		auto inRange = [fileSize](uint64_t offset, uint64_t size) {
+			return offset <= fileSize && size <= fileSize - offset;
+		};
+		if (!inRange(header.meshTableOffset, uint64_t(header.meshCount) * sizeof(AdModelCacheMesh))
+			|| !inRange(header.materialTableOffset, uint64_t(header.materialCount) * sizeof(AdModelCacheMaterial))
+			|| !inRange(header.stringTableOffset, header.stringTableSize)) {
+			LOG_W("Model cache {0} is corrupted.", cachePath);
+			return false;
+		}
+		const char* stringTable = reinterpret_cast<const char*>(data + header.stringTableOffset);
+		auto readString = [&](const AdModelCacheString& str, std::string& outStr) {
+			if (uint64_t(str.offset) + str.length > header.stringTableSize) {
+				return false;
+			}
+			outStr.assign(stringTable + str.offset, str.length);
+			return true;
+		};
+
+		std::vector<ModelMesh> cachedMeshes(header.meshCount);
+		for (uint32_t i = 0; i < header.meshCount; i++) {
+			AdModelCacheMesh entry;
+			memcpy(&entry, data + header.meshTableOffset + i * sizeof(AdModelCacheMesh), sizeof(entry));
+			if (!inRange(entry.vertexOffset, uint64_t(entry.vertexCount) * sizeof(ModelVertex))
+				|| !inRange(entry.indexOffset, uint64_t(entry.indexCount) * sizeof(uint32_t))) {
+				LOG_W("Model cache {0} is corrupted.", cachePath);
+				return false;
+			}
+
+			ModelMesh& mesh = cachedMeshes[i];
+			if (!readString(entry.name, mesh.Name)) {
+				return false;
+			}
+			// 顶点与索引数据整块拷贝
+			mesh.Vertices.resize(entry.vertexCount);
+			memcpy(mesh.Vertices.data(), data + entry.vertexOffset, entry.vertexCount * sizeof(ModelVertex));
+			mesh.Indices.resize(entry.indexCount);
+			memcpy(mesh.Indices.data(), data + entry.indexOffset, entry.indexCount * sizeof(uint32_t));
+			mesh.VertexCount = entry.vertexCount;
+			mesh.IndexCount = entry.indexCount;
+			mesh.MaterialIndex = entry.materialIndex;
+			mesh.BoundsMin = entry.boundsMin;
+			mesh.BoundsMax = entry.boundsMax;
+			mesh.BoundingSphere = entry.boundingSphere;
+		}
+
+		std::vector<ModelMaterial> cachedMaterials(header.materialCount);
+		for (uint32_t i = 0; i < header.materialCount; i++) {
+			AdModelCacheMaterial entry;
+			memcpy(&entry, data + header.materialTableOffset + i * sizeof(AdModelCacheMaterial), sizeof(entry));
+
+			ModelMaterial& mat = cachedMaterials[i];
+			mat.BaseColor = entry.baseColor;
+			mat.Metallic = entry.metallic;
+			mat.Roughness = entry.roughness;
+			mat.AO = entry.ao;
+			mat.Alpha = entry.alpha;
+			mat.EmissiveColor = entry.emissiveColor;
+			mat.EmissiveStrength = entry.emissiveStrength;
+			mat.Anisotropy = entry.anisotropy;
+			mat.AnisotropyDirection = entry.anisotropyDirection;
+			if (!readString(entry.name, mat.Name)
+				|| !readString(entry.baseColorTexturePath, mat.BaseColorTexturePath)
+				|| !readString(entry.metallicTexturePath, mat.MetallicTexturePath)
+				|| !readString(entry.roughnessTexturePath, mat.RoughnessTexturePath)
+				|| !readString(entry.normalTexturePath, mat.NormalTexturePath)
+				|| !readString(entry.aoTexturePath, mat.AOTexturePath)
+				|| !readString(entry.alphaTexturePath, mat.AlphaTexturePath)
+				|| !readString(entry.emissiveTexturePath, mat.EmissiveTexturePath)) {
+				LOG_W("Model cache {0} is corrupted.", cachePath);
+				return false;
+			}
+		}
+
+		meshes.insert(meshes.end(), std::make_move_iterator(cachedMeshes.begin()), std::make_move_iterator(cachedMeshes.end()));
+		materials.insert(materials.end(), std::make_move_iterator(cachedMaterials.begin()), std::make_move_iterator(cachedMaterials.end()));
+		return true;
+	}
+
+	/**
+	 * @brief 把导入结果写入缓存文件
+	 *
+	 * 布局：头部 | 网格表 | 材质表 | 字符串表 | 各网格的顶点与索引数据，每段按 16 字节对齐。
+	 * 先写临时文件再替换，避免中途退出留下损坏的缓存。
+	 */
+	bool AdModelCache::Save(const std::string& cachePath, uint64_t sourceHash,
+							const std::vector<ModelMesh>& meshes,
+							const std::vector<ModelMaterial>& materials) {
+		std::string stringTable;
+		auto addString = [&stringTable](const std::string& str) {
+			AdModelCacheString entry = { static_cast<uint32_t>(stringTable.size()), static_cast<uint32_t>(str.size()) };
+			stringTable += str;
+			return entry;
+		};
+
+		AdModelCacheHeader header = {};
+		header.magic = AD_MODEL_CACHE_MAGIC;
+		header.version = AD_MODEL_CACHE_VERSION;
+		header.sourceHash = sourceHash;
+		header.vertexStride = sizeof(ModelVertex);
+		header.meshCount = static_cast<uint32_t>(meshes.size());
+		header.materialCount = static_cast<uint32_t>(materials.size());
+		header.meshTableOffset = AlignOffset(sizeof(AdModelCacheHeader));
+		header.materialTableOffset = AlignOffset(header.meshTableOffset + meshes.size() * sizeof(AdModelCacheMesh));
+		header.stringTableOffset = AlignOffset(header.materialTableOffset + materials.size() * sizeof(AdModelCacheMaterial));
+
+		std::vector<AdModelCacheMesh> meshTable(meshes.size());
+		std::vector<AdModelCacheMaterial> materialTable(materials.size());
+		for (size_t i = 0; i < meshes.size(); i++) {
+			const ModelMesh& mesh = meshes[i];
+			AdModelCacheMesh& entry = meshTable[i];
+			entry = {};
+			entry.vertexCount = static_cast<uint32_t>(mesh.Vertices.size());
+			entry.indexCount = static_cast<uint32_t>(mesh.Indices.size());
+			entry.materialIndex = mesh.MaterialIndex;
+			entry.name = addString(mesh.Name);
+			entry.boundsMin = mesh.BoundsMin;
+			entry.boundsMax = mesh.BoundsMax;
+			entry.boundingSphere = mesh.BoundingSphere;
+		}
+		for (size_t i = 0; i < materials.size(); i++) {
+			const ModelMaterial& mat = materials[i];
+			AdModelCacheMaterial& entry = materialTable[i];
+			entry = {};
+			entry.name = addString(mat.Name);
+			entry.baseColor = mat.BaseColor;
+			entry.metallic = mat.Metallic;
+			entry.roughness = mat.Roughness;
+			entry.ao = mat.AO;
+			entry.alpha = mat.Alpha;
+			entry.emissiveColor = mat.EmissiveColor;
+			entry.emissiveStrength = mat.EmissiveStrength;
+			entry.anisotropy = mat.Anisotropy;
+			entry.anisotropyDirection = mat.AnisotropyDirection;
+			entry.baseColorTexturePath = addString(mat.BaseColorTexturePath);
+			entry.metallicTexturePath = addString(mat.MetallicTexturePath);
+			entry.roughnessTexturePath = addString(mat.RoughnessTexturePath);
+			entry.normalTexturePath = addString(mat.NormalTexturePath);
+			entry.aoTexturePath = addString(mat.AOTexturePath);
+			entry.alphaTexturePath = addString(mat.AlphaTexturePath);
+			entry.emissiveTexturePath = addString(mat.EmissiveTexturePath);
+		}
+		header.stringTableSize = static_cast<uint32_t>(stringTable.size());
+
+		// 字符串表之后依次排布各网格的顶点与索引数据
+		uint64_t offset = header.stringTableOffset + stringTable.size();
+		for (AdModelCacheMesh& entry : meshTable) {
+			entry.vertexOffset = AlignOffset(offset);
+			entry.indexOffset = AlignOffset(entry.vertexOffset + uint64_t(entry.vertexCount) * sizeof(ModelVertex));
+			offset = entry.indexOffset + uint64_t(entry.indexCount) * sizeof(uint32_t);
+		}
+		header.fileSize = offset;
+
+		std::filesystem::path path(cachePath);
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			LOG_W("Can not write model cache: {0}", tmpPath.string());
+			return false;
+		}
+
+		uint64_t written = 0;
+		auto write = [&](uint64_t targetOffset, const void* src, uint64_t size) {
+			static const char padding[AD_MODEL_CACHE_ALIGNMENT] = {};
+			file.write(padding, static_cast<std::streamsize>(targetOffset - written));
+			file.write(static_cast<const char*>(src), static_cast<std::streamsize>(size));
+			written = targetOffset + size;
+		};
+		write(0, &header, sizeof(header));
+		write(header.meshTableOffset, meshTable.data(), meshTable.size() * sizeof(AdModelCacheMesh));
+		write(header.materialTableOffset, materialTable.data(), materialTable.size() * sizeof(AdModelCacheMaterial));
+		write(header.stringTableOffset, stringTable.data(), stringTable.size());
+		for (size_t i = 0; i < meshes.size(); i++) {
+			write(meshTable[i].vertexOffset, meshes[i].Vertices.data(), meshes[i].Vertices.size() * sizeof(ModelVertex));
+			write(meshTable[i].indexOffset, meshes[i].Indices.data(), meshes[i].Indices.size() * sizeof(uint32_t));
+		}
+		file.close();
+		if (file.fail()) {
+			LOG_W("Can not write model cache: {0}", tmpPath.string());
+			return false;
+		}
+
+		std::error_code ec;
+		std::filesystem::rename(tmpPath, path, ec);
+		if (ec) {
+			LOG_W("Can not replace model cache {0}: {1}", path.string(), ec.message());
+			return false;
+		}
+		LOG_D("Save model cache {0}: {1} bytes", cachePath, header.fileSize);
+		return true;
+	}
+}
@@ -1,11 +1,15 @@
 #include "Resource/AdModelLoader.h"
+#include "Resource/AdModelCache.h"
+#include "Resource/AdMeshOptimizer.h"
+#include "AdThreadPool.h"
 
 
 namespace WuDu {
 
 	bool AdModelLoader::LoadModel(const std::string& filePath,
 								std::vector<ModelMesh>& meshes,
-								std::vector<ModelMaterial>& materials) {
+								std::vector<ModelMaterial>& materials,
+								const AdModelImportSettings& settings) {
 		Assimp::Importer importer;
 
 		//设置Assimp导入选项
@@ -17,6 +21,20 @@ namespace WuDu {
 			aiProcess_JoinIdenticalVertices |	//合并相同顶点
 			aiProcess_OptimizeMeshes;			//优化网格
 
+		auto startTime = std::chrono::steady_clock::now();
+		auto elapsedMs = [&startTime]() {
+			return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+		};
+
+		//优先从烘焙缓存加载，缓存与源文件或导入选项不匹配时重新导入
+		std::string cachePath = AdModelCache::GetCachePath(filePath);
+		uint64_t sourceHash = 0;
+		bool bHashed = settings.bUseCache && AdModelCache::ComputeSourceHash(filePath, importFlags, settings, &sourceHash);
+		if (bHashed && AdModelCache::Load(cachePath, sourceHash, meshes, materials)) {
+			LOG_I("Model {0} loaded from cache in {1:.2f} ms", filePath, elapsedMs());
+			return true;
+		}
+
 		//导入模型
 		const aiScene* scene = importer.ReadFile(filePath,importFlags);
 
@@ -28,79 +46,108 @@ namespace WuDu {
 		//处理材质
 		ProcessMaterials(scene,materials);
 
-		//递归处理所有节点
-		ProcessNode(scene->mRootNode, scene, meshes, materials);
+		//先串行收集所有节点引用的网格，再在线程池上并行转换，每个网格写入预先分配好的位置
+		std::vector<const aiMesh*> sceneMeshes;
+		ProcessNode(scene->mRootNode, scene, sceneMeshes);
+		size_t firstMesh = meshes.size();
+		meshes.resize(firstMesh + sceneMeshes.size());
+		//网格优化只在导入时执行一次，结果随烘焙缓存保存
+		std::vector<AdVertexCacheStats> statsBefore(sceneMeshes.size());
+		std::vector<AdVertexCacheStats> statsAfter(sceneMeshes.size());
+		auto processMesh = [&](uint32_t index) {
+			ModelMesh& mesh = meshes[firstMesh + index];
+			ProcessMesh(sceneMeshes[index], mesh);
+			if (settings.bOptimizeMeshes) {
+				AdMeshOptimizer::Optimize(mesh, &statsBefore[index], &statsAfter[index]);
+			}
+		};
+		if (settings.bParallelMeshes) {
+			AdThreadPool::GetInstance()->ParallelFor(static_cast<uint32_t>(sceneMeshes.size()), processMesh);
+		} else {
+			for (uint32_t index = 0; index < sceneMeshes.size(); index++) {
+				processMesh(index);
+			}
+		}
+		if (settings.bOptimizeMeshes) {
+			AdVertexCacheStats totalBefore;
+			AdVertexCacheStats totalAfter;
+			for (size_t i = 0; i < sceneMeshes.size(); i++) {
+				totalBefore += statsBefore[i];
+				totalAfter += statsAfter[i];
+			}
+			LOG_I("Model {0} mesh optimization: ACMR {1:.3f} -> {2:.3f}, ATVR {3:.3f} -> {4:.3f}", filePath,
+				totalBefore.GetACMR(), totalAfter.GetACMR(), totalBefore.GetATVR(), totalAfter.GetATVR());
+		}
+		LOG_I("Model {0} imported by Assimp in {1:.2f} ms", filePath, elapsedMs());
 
+		if (bHashed) {
+			AdModelCache::Save(cachePath, sourceHash, meshes, materials);
+		}
 		return true;
 	}
 
 	void AdModelLoader::ProcessNode(aiNode* node, const aiScene* scene,
-		std::vector<ModelMesh>& meshes,
-		std::vector<ModelMaterial>& materials) {
-		//处理当前节点的所有网格
+		std::vector<const aiMesh*>& sceneMeshes) {
+		//收集当前节点的所有网格
 		for (unsigned int i = 0; i < node->mNumMeshes; i++) {
-			aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-			meshes.push_back(ProcessMesh(mesh, scene, materials));
+			sceneMeshes.push_back(scene->mMeshes[node->mMeshes[i]]);
 		}
 
 		//递归处理子节点
 		for (unsigned int i = 0; i < node->mNumChildren; i++) {
-			ProcessNode(node->mChildren[i], scene, meshes, materials);
+			ProcessNode(node->mChildren[i], scene, sceneMeshes);
 		}
 	}
 
 	//处理单个网格 提取顶点数据
-	ModelMesh AdModelLoader::ProcessMesh(aiMesh* mesh, const aiScene* scene,
-						const std::vector<ModelMaterial>& materials) {
-		ModelMesh result;
+	void AdModelLoader::ProcessMesh(const aiMesh* mesh, ModelMesh& result) {
 		result.MaterialIndex = mesh->mMaterialIndex;
 
-		//提取顶点数据
+		//提取顶点数据，输出按顶点数一次分配
+		const aiVector3D* texCoords = mesh->mTextureCoords[0];
+		const bool bHasTangents = mesh->mTangents && mesh->mBitangents;
+		result.Vertices.resize(mesh->mNumVertices);
 		for (unsigned int i = 0; i < mesh->mNumVertices; i++) {
-			ModelVertex vertex;
+			ModelVertex& vertex = result.Vertices[i];
 
 			// 提取位置
-			vertex.Position.x = mesh->mVertices[i].x;
-			vertex.Position.y = mesh->mVertices[i].y;
-			vertex.Position.z = mesh->mVertices[i].z;
+			vertex.Position = glm::vec3(mesh->mVertices[i].x, mesh->mVertices[i].y, mesh->mVertices[i].z);
 
 			// 提取纹理坐标（如果存在）
-			if (mesh->mTextureCoords[0]) {
-				vertex.TexCoord.x = mesh->mTextureCoords[0][i].x;
-				vertex.TexCoord.y = mesh->mTextureCoords[0][i].y;
-			}
-			else {
-				vertex.TexCoord = glm::vec2(0.0f, 0.0f);
-			}
+			vertex.TexCoord = texCoords ? glm::vec2(texCoords[i].x, texCoords[i].y) : glm::vec2(0.0f, 0.0f);
 
 			// 提取法线
-			vertex.Normal.x = mesh->mNormals[i].x;
-			vertex.Normal.y = mesh->mNormals[i].y;
-			vertex.Normal.z = mesh->mNormals[i].z;
+			vertex.Normal = mesh->mNormals ? glm::vec3(mesh->mNormals[i].x, mesh->mNormals[i].y, mesh->mNormals[i].z) : glm::vec3(0.0f);
 
 			// 提取切线和副切线（如果存在）
-			if (mesh->mTangents && mesh->mBitangents) {
-				vertex.Tangent.x = mesh->mTangents[i].x;
-				vertex.Tangent.y = mesh->mTangents[i].y;
-				vertex.Tangent.z = mesh->mTangents[i].z;
-
-				vertex.Bitangent.x = mesh->mBitangents[i].x;
-				vertex.Bitangent.y = mesh->mBitangents[i].y;
-				vertex.Bitangent.z = mesh->mBitangents[i].z;
+			if (bHasTangents) {
+				vertex.Tangent = glm::vec3(mesh->mTangents[i].x, mesh->mTangents[i].y, mesh->mTangents[i].z);
+				vertex.Bitangent = glm::vec3(mesh->mBitangents[i].x, mesh->mBitangents[i].y, mesh->mBitangents[i].z);
+			}
+			else {
+				vertex.Tangent = glm::vec3(0.0f);
+				vertex.Bitangent = glm::vec3(0.0f);
 			}
-
-			result.Vertices.push_back(vertex);
 		}
 
-		//提取索引数据
+		//提取索引数据，先统计索引总数再一次分配
+		size_t indexCount = 0;
 		for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
-			aiFace face = mesh->mFaces[i];
-			for (unsigned int j = 0; j < face.mNumIndices; j++) {
-				result.Indices.push_back(face.mIndices[j]);
-			}
+			indexCount += mesh->mFaces[i].mNumIndices;
+		}
+		result.Indices.resize(indexCount);
+		uint32_t* indices = result.Indices.data();
+		for (unsigned int i = 0; i < mesh->mNumFaces; i++) {
+			const aiFace& face = mesh->mFaces[i];
+			memcpy(indices, face.mIndices, face.mNumIndices * sizeof(uint32_t));
+			indices += face.mNumIndices;
 		}
+		result.VertexCount = static_cast<uint32_t>(result.Vertices.size());
+		result.IndexCount = static_cast<uint32_t>(result.Indices.size());
 
-		return result;
+		//计算包围盒与包围球，供视锥体剔除使用
+		AdGeometryUtil::ComputeBounds(result.Vertices.data(), sizeof(ModelVertex), result.VertexCount,
+			result.BoundsMin, result.BoundsMax, result.BoundingSphere);
 	}
 
 	//处理材质
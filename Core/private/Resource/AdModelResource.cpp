@@ -4,8 +4,8 @@
 
 namespace WuDu {
 
-	AdModelResource::AdModelResource(const std::string& modelPath)
-		: AdResource(modelPath),mModelPath(modelPath) {
+	AdModelResource::AdModelResource(const std::string& modelPath, const AdModelImportSettings& settings)
+		: AdResource(modelPath),mModelPath(modelPath),mImportSettings(settings) {
 	}
 
 	AdModelResource::~AdModelResource() {
@@ -19,7 +19,7 @@ namespace WuDu {
 
 		LOG_I("Loading model: {0}", mModelPath);
 
-		if (AdModelLoader::LoadModel(mModelPath, mMeshes, mMaterials)) {
+		if (AdModelLoader::LoadModel(mModelPath, mMeshes, mMaterials, mImportSettings)) {
 			mIsLoaded = true;
 			LOG_I("Model loaded successfully. Meshes: {0}, Materials: {1}", mMeshes.size(), mMaterials.size());
 			return true;
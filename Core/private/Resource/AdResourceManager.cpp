@@ -0,0 +1,88 @@
+#include "Resource/AdResourceManager.h"
+
+namespace WuDu {
+	AdResourceManager* AdResourceManager::GetInstance() {
+		static AdResourceManager sResourceManager;
+		return &sResourceManager;
+	}
+
+	AdResourceManager::AdResourceManager() {
+
+	}
+
+	AdResourceManager::~AdResourceManager() {
+		UnloadAll();
+	}
+
+	/**
+	 * @brief 执行一次加载并结束对应的进行中请求
+	 *
+	 * 耗时的 Load 在锁外执行，加载期间其他路径的查找与加载不受影响；
+	 * 结束后在锁内登记映射表并移出进行中列表，最后在锁外唤醒所有等待者。
+	 * Load 抛出的异常按加载失败处理：在线程池上异常无人读取，若不结束请求，等待者与之后同一路径的请求会一直挂起。
+	 *
+	 * @param path 请求时的资源路径
+	 * @param resource Acquire 创建的资源对象
+	 */
+	void AdResourceManager::RunLoad(const std::string& path, const std::shared_ptr<AdResource>& resource) {
+		bool bLoaded = false;
+		try {
+			bLoaded = resource->Load();
+		}
+		catch (const std::exception& e) {
+			LOG_E("Resource load threw: {0}, {1}", path, e.what());
+		}
+		catch (...) {
+			LOG_E("Resource load threw: {0}", path);
+		}
+		resource->SetState(bLoaded ? ResourceState::Loaded : ResourceState::Failed);
+
+		std::shared_ptr<std::promise<bool>> promise;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			auto pendingIt = mPendingLoads.find(path);
+			if (pendingIt != mPendingLoads.end() && pendingIt->second.resource == resource) {
+				promise = pendingIt->second.promise;
+				mPendingLoads.erase(pendingIt);
+			}
+			if (bLoaded) {
+				// 更新双映射表
+				const UUID& uuid = resource->GetUUID();
+				mUUIDToResource[uuid] = resource;
+				mPathToUUID[path] = uuid;
+			}
+		}
+		if (!bLoaded) {
+			LOG_E("Resource load failed: {0}", path);
+		}
+		if (promise) {
+			promise->set_value(bLoaded);
+		}
+	}
+
+	// 清理已无人持有的资源映射
+	void AdResourceManager::UnloadUnused() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (auto it = mUUIDToResource.begin(); it != mUUIDToResource.end();) {
+			if (it->second.expired()) {
+				it = mUUIDToResource.erase(it);
+			} else {
+				++it;
+			}
+		}
+		for (auto it = mPathToUUID.begin(); it != mPathToUUID.end();) {
+			if (mUUIDToResource.find(it->second) == mUUIDToResource.end()) {
+				it = mPathToUUID.erase(it);
+			} else {
+				++it;
+			}
+		}
+	}
+
+	// 进行中的加载不受影响，完成后仍会登记到映射表
+	void AdResourceManager::UnloadAll() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mUUIDToResource.clear();
+		mPathToUUID.clear();
+	}
+}
@@ -10,6 +10,7 @@ namespace WuDu {
 		uint32_t width = 1920;
 		uint32_t height = 1080;
 		const char* title = "WuDu Engine";
+		uint32_t framesInFlight = 2;   // CPU可领先GPU的最大帧数(延迟深度)
 	};
 
 	class AdApplication {
@@ -28,6 +29,11 @@ namespace WuDu {
 		uint64_t GetFrameIndex() const { return mFrameIndex; }
 		AdWindow* GetWindow() const { return mWindow.get(); }
 
+		// 命令行开关，如 --gpu-driven；--frames N 使主循环在 N 帧后退出，用于自动化运行
+		bool HasArg(const std::string& name) const;
+		// 进程退出码，自检类运行失败时由应用设置为非零
+		int GetExitCode() const { return mExitCode; }
+
 	protected:
 		virtual void OnConfiguration(AppSettings* appSettings) {}
 		virtual void OnInit() {}
@@ -38,6 +44,8 @@ namespace WuDu {
 		virtual void OnSceneInit(AdScene* scene) {}
 		virtual void OnSceneDestroy(AdScene* scene) {}
 
+		void SetExitCode(int exitCode) { mExitCode = exitCode; }
+
 		std::chrono::steady_clock::time_point mStartTimePoint;
 		std::chrono::steady_clock::time_point mLastTimePoint;
 		std::shared_ptr<AdRenderContext> mRenderContext;
@@ -47,10 +55,18 @@ namespace WuDu {
 		void ParseArgs(int argc, char* argv[]);
 		bool LoadScene(const std::string& filePath = "");
 		void UnLoadScene();
+		void LogStartupIfReady();
 
 		AppSettings mAppSettings;
 
+		std::chrono::steady_clock::time_point mInitTimePoint;
+		float mInitTimeMs = 0.f;
+		bool bStartupLogged = false;
+
 		uint64_t mFrameIndex = 0;
+		uint64_t mMaxFrames = 0;        // 0 表示不限制
+		std::vector<std::string> mArgs;
+		int mExitCode = EXIT_SUCCESS;
 		bool bPause = false;
 
 		static AdAppContext sAppContext;
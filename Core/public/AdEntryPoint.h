@@ -19,10 +19,11 @@ int main(int argc, char* argv[]) {
 	app->MainLoop();
 	// stop
 	app->Stop();
+	int exitCode = app->GetExitCode();
 	// delete
 	delete app;
 
-	return EXIT_SUCCESS;
+	return exitCode;
 }
 
 #endif
@@ -28,6 +28,7 @@ namespace WuDu {
 
 		bool IsValid() const { return mScene && mScene->mEcsRegistry.valid(mEcsEntity); }
 		const entt::entity& GetEcsEntity() const { return mEcsEntity; }
+		AdScene* GetScene() const { return mScene; }
 
 		template<typename T, typename... Args>
 		T& AddComponent(Args &&...args) {
@@ -67,6 +68,19 @@ namespace WuDu {
 		entt::entity mEcsEntity;
 		AdScene* mScene;
 	};
+
+	template<typename T>
+	void AdScene::AddComponents(std::span<AdEntity* const> entities, const T& value) {
+		std::vector<entt::entity> enttEntities;
+		enttEntities.reserve(entities.size());
+		for (AdEntity* entity : entities) {
+			enttEntities.push_back(entity->GetEcsEntity());
+		}
+		mEcsRegistry.insert<T>(enttEntities.begin(), enttEntities.end(), value);
+		for (AdEntity* entity : entities) {
+			mEcsRegistry.get<T>(entity->GetEcsEntity()).SetOwner(entity);
+		}
+	}
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,45 @@
+#ifndef AD_ENTITYSLOTMAP_H
+#define AD_ENTITYSLOTMAP_H
+
+#include "AdEngine.h"
+#include "entt/entity/entity.hpp"
+
+namespace WuDu {
+	class AdEntity;
+	class AdScene;
+
+#define AD_ENTITY_SLOT_PAGE_SIZE        1024        // 每页容纳的实体数，页一经分配不再移动
+
+	/**
+	 * @brief 实体对象的槽位表
+	 *
+	 * 以 entt 实体的索引部分作为槽位下标，AdEntity 就地构造在分页的连续存储中，地址在其生命周期内不变；
+	 * 每个槽位记录占用它的完整实体标识（含版本号），查询时比较版本，已销毁或已被复用的旧标识返回空。
+	 * 创建、查询、销毁均为 O(1)，只在首次用到某一页时分配内存。
+	 */
+	class AdEntitySlotMap {
+	public:
+		AdEntitySlotMap() = default;
+		AdEntitySlotMap(const AdEntitySlotMap&) = delete;
+		AdEntitySlotMap& operator=(const AdEntitySlotMap&) = delete;
+		~AdEntitySlotMap();
+
+		AdEntity* Emplace(entt::entity enttEntity, AdScene* scene);
+		AdEntity* Get(entt::entity enttEntity) const;
+		bool Erase(entt::entity enttEntity);
+		void Clear();
+
+		uint32_t GetSize() const { return mSize; }
+		uint32_t GetSlotCount() const { return static_cast<uint32_t>(mSlotEntities.size()); }
+		uint32_t GetPageCount() const { return static_cast<uint32_t>(mPages.size()); }
+	private:
+		AdEntity* GetSlot(uint32_t index) const;
+
+		std::vector<std::unique_ptr<std::byte[]>> mPages;
+		// 各槽位当前对象的实体标识，空槽位为 entt::null
+		std::vector<entt::entity> mSlotEntities;
+		uint32_t mSize = 0;
+	};
+}
+
+#endif
@@ -4,29 +4,64 @@
 #include "AdUUID.h"
 
 namespace WuDu {
+	/**
+	 * @brief 场景层级节点
+	 *
+	 * 父子关系以侵入式双向链表保存：每个节点记录父节点、首/尾子节点和前/后兄弟节点，
+	 * 挂接与摘除都是 O(1)。需要按层级顺序频繁遍历的系统（如变换系统）在层级版本变化时
+	 * 把节点树展开为连续数组，逐帧遍历数组而不是链表。
+	 */
 	class AdNode {
 	public:
 		AdNode() = default;
-		virtual ~AdNode() = default;
+		AdNode(const AdNode&) = delete;
+		AdNode& operator=(const AdNode&) = delete;
+		// 析构时从父节点摘除自身，并摘除所有子节点，层级中不会留下悬空指针
+		virtual ~AdNode();
 
 		AdUUID GetId() const;
 		void SetId(const AdUUID& nodeId);
 		const std::string& GetName() const;
 		void SetName(const std::string& name);
 
-		const std::vector<AdNode*>& GetChildren() const;
-		bool HasParent();
-		bool HasChildren();
+		bool HasParent() const { return mParent != nullptr; }
+		bool HasChildren() const { return mFirstChild != nullptr; }
+		AdNode* GetParent() const { return mParent; }
+		AdNode* GetFirstChild() const { return mFirstChild; }
+		AdNode* GetLastChild() const { return mLastChild; }
+		AdNode* GetPrevSibling() const { return mPrevSibling; }
+		AdNode* GetNextSibling() const { return mNextSibling; }
+		uint32_t GetChildCount() const { return mChildCount; }
+
+		template<typename F>
+		void ForEachChild(F&& func) const {
+			for (AdNode* child = mFirstChild; child; ) {
+				// 回调中可能摘除当前子节点，先取下一个
+				AdNode* next = child->mNextSibling;
+				func(child);
+				child = next;
+			}
+		}
+
 		void SetParent(AdNode* node);
-		AdNode* GetParent() const;
 		void AddChild(AdNode* node);
 		void RemoveChild(AdNode* node);
+		void RemoveAllChildren();
+
+		// 任意节点父子关系变化时递增，依赖层级顺序的系统据此判断是否需要重建
+		static uint64_t GetHierarchyVersion() { return sHierarchyVersion.load(); }
 	private:
-		AdUUID mId;
+		inline static std::atomic<uint64_t> sHierarchyVersion{ 0 };
+
+		AdUUID mId{ 0u };       // 由场景在创建时赋值，避免默认构造多取一次随机数
 		std::string mName;
 		AdNode* mParent = nullptr;
-		std::vector<AdNode*> mChildren;
+		AdNode* mFirstChild = nullptr;
+		AdNode* mLastChild = nullptr;
+		AdNode* mPrevSibling = nullptr;
+		AdNode* mNextSibling = nullptr;
+		uint32_t mChildCount = 0;
 	};
 }
 
-#endif
\ No newline at end of file
+#endif
@@ -2,11 +2,24 @@
 #define ADSCENE_H
 
 #include "AdUUID.h"
+#include "AdEntitySlotMap.h"
 #include "entt/entity/registry.hpp"
+#include <span>
+#include <glm/glm.hpp>
 
 namespace WuDu {
 	class AdNode;
 	class AdEntity;
+	class AdTransformSystem;
+
+	// 批量创建实体的模板：名称、父节点与初始局部变换
+	struct AdEntityPrototype {
+		std::string name = "Entity";
+		AdNode* parent = nullptr;       // 为空时挂到场景根节点
+		glm::vec3 position{ 0.f, 0.f, 0.f };
+		glm::vec3 rotation{ 0.f, 0.f, 0.f };  // degree
+		glm::vec3 scale{ 1.f, 1.f, 1.f };
+	};
 
 	class AdScene {
 	public:
@@ -18,16 +31,29 @@ namespace WuDu {
 		void DestroyEntity(const AdEntity* entity);
 		void DestroyAllEntity();
 
+		// 批量创建/销毁：entt 区间创建与插入，组件池预留容量，一次随机数生成整段 UUID
+		std::vector<AdEntity*> CreateEntities(uint32_t count, const AdEntityPrototype& prototype = {});
+		void DestroyEntities(std::span<AdEntity* const> entities);
+		// 为一批实体插入相同的组件副本（定义在 AdEntity.h）
+		template<typename T>
+		void AddComponents(std::span<AdEntity* const> entities, const T& value);
+
+		// 每帧在逻辑更新之后、渲染之前调用，更新场景级系统（层级变换）
+		void OnUpdate(float deltaTime);
+
 		entt::registry& GetEcsRegistry() { return mEcsRegistry; }
 		AdNode* GetRootNode() const { return mRootNode.get(); }
 		AdEntity* GetEntity(entt::entity enttEntity);
+		AdTransformSystem* GetTransformSystem() const { return mTransformSystem.get(); }
 
 	private:
 		std::string mName;
 		entt::registry mEcsRegistry;
 
-		std::unordered_map<entt::entity, std::shared_ptr<AdEntity>> mEntities;
+		// 实体对象按 entt 实体索引存放，地址稳定
+		AdEntitySlotMap mEntities;
 		std::shared_ptr<AdNode> mRootNode;
+		std::unique_ptr<AdTransformSystem> mTransformSystem;
 
 		friend class AdEntity;
 	};
@@ -0,0 +1,49 @@
+#ifndef AD_TRANSFORMPOOL_H
+#define AD_TRANSFORMPOOL_H
+
+#include "AdEngine.h"
+#include <glm/glm.hpp>
+#include <glm/gtc/quaternion.hpp>
+
+namespace WuDu {
+	/**
+	 * @brief 批量变换池
+	 *
+	 * 面向大量同构对象（粒子、植被、群体等）的批量变换路径：位置、旋转（四元数）和缩放按分量
+	 * 以结构数组 (SoA) 存放，ComposeMatrices 一次组合多个矩阵写入连续的 mat4 数组。
+	 * 编译目标支持 AVX2 时每次 8 个，支持 SSE 时每次 4 个，否则退化为标量循环。
+	 * 组合结果与 AdTransformComponent 的 T * R * S 顺序一致。
+	 */
+	class AdTransformPool {
+	public:
+		uint32_t Add(const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+		void Set(uint32_t index, const glm::vec3& position, const glm::quat& rotation, const glm::vec3& scale);
+		void SetPosition(uint32_t index, const glm::vec3& position);
+		void SetRotation(uint32_t index, const glm::quat& rotation);
+		void SetScale(uint32_t index, const glm::vec3& scale);
+		void Reserve(uint32_t capacity);
+		void Clear();
+
+		// 组合所有对象的模型矩阵，outMatrices 至少要有 GetSize() 个元素
+		void ComposeMatrices(glm::mat4* outMatrices) const;
+
+		uint32_t GetSize() const { return mSize; }
+		glm::vec3 GetPosition(uint32_t index) const { return { mPosX[index], mPosY[index], mPosZ[index] }; }
+		glm::quat GetRotation(uint32_t index) const { return glm::quat(mRotW[index], mRotX[index], mRotY[index], mRotZ[index]); }
+		glm::vec3 GetScale(uint32_t index) const { return { mScaleX[index], mScaleY[index], mScaleZ[index] }; }
+
+		// 与 AdTransformComponent::rotation 相同约定的欧拉角（角度，依次绕 X、Y、Z 轴）转换为四元数
+		static glm::quat EulerDegreesToQuat(const glm::vec3& rotation);
+		// ComposeMatrices 每次并行组合的对象数，由编译 WuDu_core 时的指令集决定：AVX2 为 8，SSE 为 4，否则为 1
+		static uint32_t GetSimdWidth();
+	private:
+		void ComposeScalar(uint32_t begin, uint32_t end, glm::mat4* outMatrices) const;
+
+		uint32_t mSize = 0;
+		std::vector<float> mPosX, mPosY, mPosZ;
+		std::vector<float> mRotX, mRotY, mRotZ, mRotW;
+		std::vector<float> mScaleX, mScaleY, mScaleZ;
+	};
+}
+
+#endif
@@ -5,13 +5,19 @@
 #include "AdGraphicContext.h"
 
 namespace WuDu {
+#define AD_TRANSFORM_INVALID_INDEX      UINT32_MAX
+
 	class AdTransformComponent : public AdComponent {
 	public:
+		// 局部变换（相对父节点），可直接修改，变换系统每帧检测变化
 		glm::vec3 position{ 0.f, 0.f, 0.f };
 		glm::vec3 rotation{ 0.f, 0.f, 0.f };  // degree
 		glm::vec3 scale{ 1.f, 1.f, 1.f };
 
-		glm::mat4 GetTransform() const {
+		// 世界矩阵，取自变换系统缓存的世界矩阵数组；尚未参与过更新时退化为局部矩阵
+		glm::mat4 GetTransform() const;
+		// 由 position/rotation/scale 重新计算局部矩阵
+		glm::mat4 ComputeLocalTransform() const {
 			glm::mat4 transMat = glm::translate(glm::mat4(1.f), position);
 			glm::mat4 rotationMat = glm::rotate(glm::mat4(1.f), glm::radians(rotation.x), glm::vec3{ 1, 0, 0 });
 			rotationMat = glm::rotate(rotationMat, glm::radians(rotation.y), glm::vec3{ 0, 1, 0 });
@@ -19,6 +25,31 @@ namespace WuDu {
 			glm::mat4 scaleMat = glm::scale(glm::mat4(1.f), scale);
 			return transMat * rotationMat * scaleMat;
 		}
+		const glm::mat4& GetLocalTransform() const { return mLocalMatrix; }
+		// 在变换系统世界矩阵数组中的位置，层级变化后重新分配
+		uint32_t GetWorldIndex() const { return mWorldIndex; }
+	private:
+		// 与上次重建局部矩阵时的 TRS 比较，有变化时重建并返回 true
+		bool UpdateLocalTransform() {
+			if (bLocalValid && position == mCachedPosition && rotation == mCachedRotation && scale == mCachedScale) {
+				return false;
+			}
+			mCachedPosition = position;
+			mCachedRotation = rotation;
+			mCachedScale = scale;
+			mLocalMatrix = ComputeLocalTransform();
+			bLocalValid = true;
+			return true;
+		}
+
+		glm::vec3 mCachedPosition{ 0.f };
+		glm::vec3 mCachedRotation{ 0.f };
+		glm::vec3 mCachedScale{ 1.f };
+		glm::mat4 mLocalMatrix{ 1.f };
+		bool bLocalValid = false;
+		uint32_t mWorldIndex = AD_TRANSFORM_INVALID_INDEX;
+
+		friend class AdTransformSystem;
 	};
 }
 
@@ -25,6 +25,12 @@ namespace WuDu {
 		alignas(16) TextureParam textureParam1;
 	};
 
+	// 无绑定路径下材质SSBO中的元素，纹理以无绑定数组中的索引引用（std430）
+	struct UnlitMaterialGpuData {
+		UnlitMaterialUbo params;
+		alignas(16) glm::uvec4 textureIndices;     // x,y --> 纹理0的纹理/采样器索引, z,w --> 纹理1的纹理/采样器索引
+	};
+
 	class AdUnlitMaterial : public AdMaterial {
 	public:
 		const UnlitMaterialUbo& GetParams() const { return mParams; }
@@ -0,0 +1,141 @@
+#ifndef ADGPUDRIVENMATERIALSYSTEM_H
+#define ADGPUDRIVENMATERIALSYSTEM_H
+
+#include "ECS/System/AdMaterialSystem.h"
+#include "ECS/Component/Material/AdUnlitMaterialComponent.h"
+
+namespace WuDu {
+#define NUM_GPU_DRIVEN_MATERIAL_BATCH   16
+#define NUM_GPU_DRIVEN_MESH_BATCH       256
+#define NUM_GPU_DRIVEN_INSTANCE_BATCH   4096
+#define GPU_CULL_WORKGROUP_SIZE         64          // 与 05_gpu_cull.comp 的 local_size_x 一致
+
+	class AdVKPipelineLayout;
+	class AdVKPipeline;
+	class AdVKComputePipeline;
+	class AdVKDescriptorSetLayout;
+	class AdVKRingBuffer;
+	class AdVKBuffer;
+	class AdMesh;
+
+	// 实例SSBO中的元素（std430），剔除着色器与顶点着色器共用
+	struct GpuInstanceData {
+		glm::mat4 modelMat;
+		uint32_t meshIndex;
+		uint32_t materialIndex;
+		uint32_t padding[2];
+	};
+
+	// 网格表SSBO中的元素（std430）：模型空间包围球与间接绘制所需的索引区间
+	struct GpuMeshData {
+		glm::vec4 boundingSphere;
+		uint32_t indexCount;
+		uint32_t firstIndex;
+		int32_t vertexOffset;
+		uint32_t padding;
+	};
+
+	// 剔除计算着色器的推送常量：视锥体平面与当前绘制组的实例/命令区间
+	struct GpuCullPC {
+		glm::vec4 frustumPlanes[6];
+		uint32_t instanceBase;
+		uint32_t instanceCount;
+		uint32_t commandBase;
+		uint32_t countIndex;
+	};
+
+	/**
+	 * @brief GPU驱动的无光照材质系统
+	 *
+	 * 与 AdUnlitMaterialSystem 渲染同样的无光照材质实体，但剔除与绘制命令生成放在GPU上：
+	 * 每帧CPU只写入实例数据（模型矩阵、网格与材质索引）和网格表，渲染通道开始前由计算着色器对每个实例
+	 * 做视锥体剔除，把可见实例压缩写入 VkDrawIndexedIndirectCommand 缓冲并累加绘制数量，
+	 * 渲染时每个绘制组（共用同一顶点/索引区块的网格）只需一次 vkCmdDrawIndexedIndirectCount。
+	 *
+	 * 依赖无绑定资源表（材质按索引从SSBO读取）与多重间接绘制；设备不支持 drawIndirectCount 时
+	 * 退回到固定数量的 vkCmdDrawIndexedIndirect，未写入的命令预先清零而不产生绘制。
+	 * 只处理有索引的网格，支持 AdVertex、ModelVertex 与量化顶点三种布局，每种布局一条图形管线。
+	 * 与 AdUnlitMaterialSystem 二选一注册，两者会消费同一份材质变化标记。
+	 */
+	class AdGpuDrivenMaterialSystem : public AdMaterialSystem {
+	public:
+		void OnInit(AdVKRenderPass* renderPass) override;
+		void OnPrepare(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) override;
+		void OnRender(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) override;
+		void OnDestroy() override;
+
+		// 设备不支持无绑定或多重间接绘制时系统不工作
+		bool IsSupported() const { return bSupported; }
+		// 最近一次已完成帧的实例总数与剔除后可见的实例数（GPU回读，滞后 framesInFlight 帧）
+		uint32_t GetTotalInstanceCount() const { return mCompletedTotalCount; }
+		uint32_t GetVisibleInstanceCount() const { return mCompletedVisibleCount; }
+		// 上一帧录制的间接绘制调用次数
+		uint32_t GetDrawCallCount() const { return mDrawGroupCount; }
+	private:
+		struct DrawGroup {
+			VkBuffer vertexBuffer;
+			VkBuffer indexBuffer;
+			AdVertexFormat format;
+			uint32_t instanceBase;
+			std::vector<GpuInstanceData> instances;
+		};
+
+		struct FrameResources {
+			std::shared_ptr<AdVKBuffer> commandBuffer;      // 压缩后的间接绘制命令
+			std::shared_ptr<AdVKBuffer> countBuffer;        // 每个绘制组的绘制数量
+			std::shared_ptr<AdVKBuffer> readbackBuffer;     // 绘制数量的主机可见副本
+			uint32_t commandCapacity = 0;
+			uint32_t groupCapacity = 0;
+			uint32_t submittedGroupCount = 0;
+			uint32_t submittedInstanceCount = 0;
+			bool bPendingReadback = false;
+		};
+
+		void GatherInstances(void* materialData, uint32_t frameIndex);
+		DrawGroup* FindDrawGroup(VkBuffer vertexBuffer, VkBuffer indexBuffer, AdVertexFormat format);
+		bool EnsureFrameResources(uint32_t frameIndex, uint32_t instanceCount, uint32_t groupCount);
+		void UpdateFrameDescSets(uint32_t frameIndex);
+		void ReadbackVisibleCount(uint32_t frameIndex);
+		bool WriteMaterialGpuData(AdUnlitMaterial* material, void* dst);
+
+		bool bSupported = false;
+		bool bDrawIndirectCount = false;
+		bool bFrameRecorded = false;
+		uint32_t mMaxDrawIndirectCount = 0;
+
+		std::shared_ptr<AdVKDescriptorSetLayout> mDrawDescSetLayout;
+		std::shared_ptr<AdVKDescriptorSetLayout> mCullDescSetLayout;
+		std::shared_ptr<AdVKPipelineLayout> mPipelineLayout;
+		std::shared_ptr<AdVKPipelineLayout> mPackedPipelineLayout;
+		// 按顶点布局索引：[AdVertexFormat]
+		std::shared_ptr<AdVKPipeline> mPipelines[AD_VERTEX_FORMAT_COUNT];
+		std::shared_ptr<AdVKComputePipeline> mCullPipeline;
+
+		// 帧UBO与材质区（材质位置固定，只在变化时重写）、实例数据、网格表各用一个持久映射的环形缓冲区
+		std::shared_ptr<AdVKRingBuffer> mUniformRing;
+		std::shared_ptr<AdVKRingBuffer> mInstanceRing;
+		std::shared_ptr<AdVKRingBuffer> mMeshRing;
+		// 以下描述符集与资源按帧槽位各持有一份：[frameIndex]
+		std::vector<VkDescriptorSet> mDrawDescSets;
+		std::vector<VkDescriptorSet> mCullDescSets;
+		std::vector<FrameResources> mFrameResources;
+		uint32_t mFrameUboOffset = 0;
+		std::vector<uint32_t> mMaterialDirtyFrames;         // [materialIndex]，每一位对应一个帧槽位
+		std::vector<uint64_t> mMaterialVisitStamps;         // [materialIndex]，本帧是否已处理过该材质
+		uint64_t mVisitStamp = 0;
+
+		// 每帧收集的绘制组与网格表，容器跨帧复用以避免重复分配，前 mDrawGroupCount 个绘制组有效
+		std::vector<DrawGroup> mDrawGroups;
+		uint32_t mDrawGroupCount = 0;
+		std::vector<GpuMeshData> mMeshData;
+		std::unordered_map<AdMesh*, uint32_t> mMeshIndices;
+
+		uint32_t mCompletedTotalCount = 0;
+		uint32_t mCompletedVisibleCount = 0;
+
+		std::shared_ptr<AdTexture> mDefaultTexture;
+		std::shared_ptr<AdSampler> mDefaultSampler;
+	};
+}
+
+#endif
@@ -16,11 +16,15 @@ namespace WuDu {
 	public:
 		virtual void OnInit(AdVKRenderPass* renderPass) = 0;
 		virtual void OnRender(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) = 0;
+		// 渲染通道开始之前调用，录制计算、复制等不能出现在渲染通道内的命令
+		virtual void OnPrepare(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) {}
 		virtual void OnDestroy() = 0;
 	protected:
 		AdApplication* GetApp() const;
 		AdScene* GetScene() const;
 		AdVKDevice* GetDevice() const;
+		uint32_t GetFramesInFlight() const;
+		uint32_t GetCurrentFrameIndex() const;
 		const glm::mat4 GetProjMat(AdRenderTarget* renderTarget) const;
 		const glm::mat4 GetViewMat(AdRenderTarget* renderTarget) const;
 	};
@@ -5,12 +5,11 @@
 
 namespace WuDu {
 #define NUM_MATERIAL_BATCH              16
-#define NUM_MATERIAL_BATCH_MAX          2048
 
 	class AdVKPipelineLayout;
 	class AdVKPipeline;
 	class AdVKDescriptorSetLayout;
-	class AdVKDescriptorPool;
+	class AdVKRingBuffer;
 
 	class AdPBRMaterialSystem : public AdMaterialSystem {
 	public:
@@ -18,9 +17,9 @@ namespace WuDu {
 		void OnRender(VkCommandBuffer cmdbuffer, AdRenderTarget* renderTarget) override;
 		void OnDestroy() override;
 	private:
-		void ReCreateMaterialDescPool(uint32_t materialCount);
-		void UpdateFrameUboDescSet(AdRenderTarget* renderTarget);
-		void UpdateMaterialParamsDescSet(VkDescriptorSet descSet, AdPBRMaterial* metarial);
+		void GrowMaterialDescSets(uint32_t materialCount);
+		void UpdateUniformDescSets(uint32_t frameIndex);
+		uint32_t PushFrameUbo(AdRenderTarget* renderTarget);
 		void UpdateMaterialResourceDescSet(VkDescriptorSet descSet, AdPBRMaterial* material);
 
 		std::shared_ptr<AdVKDescriptorSetLayout> mFrameUboDescSetLayout;
@@ -30,16 +29,15 @@ namespace WuDu {
 		std::shared_ptr<AdVKPipelineLayout> mPipelineLayout;
 		std::shared_ptr<AdVKPipeline> mPipeline;
 
-		std::shared_ptr<AdVKDescriptorPool> mDescriptorPool;
-		std::shared_ptr<AdVKDescriptorPool> mMaterialDescriptorPool;
-
-		VkDescriptorSet mFrameUboDescSet;
-		std::shared_ptr<AdVKBuffer> mFrameUboBuffer;
+		// 帧UBO与材质参数统一写入持久映射的环形缓冲区，以动态偏移绑定
+		std::shared_ptr<AdVKRingBuffer> mUniformRing;
+		// 以下描述符集按帧槽位(frame in flight)各持有一份：[frameIndex]
+		std::vector<VkDescriptorSet> mFrameUboDescSets;
+		std::vector<VkDescriptorSet> mMaterialParamDescSets;
 
+		// 材质纹理资源：[frameIndex][materialIndex]
 		uint32_t mLastDescriptorSetCount = 0;
-		std::vector<VkDescriptorSet> mMaterialDescSets;
-		std::vector<VkDescriptorSet> mMaterialResourceDescSets;
-		std::vector<std::shared_ptr<AdVKBuffer>> mMaterialBuffers;
+		std::vector<std::vector<VkDescriptorSet>> mMaterialResourceDescSets;
 		std::shared_ptr<AdTexture> mDefaultTexture;
 		std::shared_ptr<AdSampler> mDefaultSampler;
 
@@ -0,0 +1,50 @@
+#ifndef AD_TRANSFORMSYSTEM_H
+#define AD_TRANSFORMSYSTEM_H
+
+#include "ECS/AdSystem.h"
+#include "ECS/Component/AdTransformComponent.h"
+
+namespace WuDu {
+	class AdScene;
+	class AdNode;
+
+	/**
+	 * @brief 层级变换系统
+	 *
+	 * 按父节点在前的顺序把场景节点树展开为数组，只在节点层级变化时重建顺序。
+	 * 每帧 OnUpdate 检测各节点局部 TRS 是否变化，只重算自身或祖先有变化的节点，
+	 * 世界矩阵写入连续数组，渲染与剔除按组件的 GetWorldIndex 直接读取。
+	 */
+	class AdTransformSystem : public AdSystem {
+	public:
+		explicit AdTransformSystem(AdScene* scene);
+
+		void OnUpdate(float deltaTime) override;
+
+		const std::vector<glm::mat4>& GetWorldMatrices() const { return mWorldMatrices; }
+		glm::mat4 GetWorldMatrix(const AdTransformComponent& transComp) const {
+			uint32_t index = transComp.GetWorldIndex();
+			return index < mWorldMatrices.size() ? mWorldMatrices[index] : transComp.ComputeLocalTransform();
+		}
+		// 上一次更新中重算了世界矩阵的节点数
+		uint32_t GetUpdatedCount() const { return mUpdatedCount; }
+	private:
+		// 展开后的节点：parent 为父节点在数组中的位置，根节点下的实体为 AD_TRANSFORM_INVALID_INDEX
+		struct TransformNode {
+			entt::entity entity;
+			uint32_t parent;
+		};
+
+		void RebuildOrder();
+
+		AdScene* mScene;
+		uint64_t mHierarchyVersion = UINT64_MAX;
+		std::vector<TransformNode> mNodes;
+		std::vector<glm::mat4> mWorldMatrices;
+		// 本次更新中世界矩阵是否变化，子节点据此判断是否需要重算
+		std::vector<uint8_t> mWorldChanged;
+		uint32_t mUpdatedCount = 0;
+	};
+}
+
+#endif
@@ -6,41 +6,79 @@
 
 namespace WuDu {
 #define NUM_MATERIAL_BATCH              16
-#define NUM_MATERIAL_BATCH_MAX          2048
+#define NUM_INSTANCE_BATCH              1024
 
 	class AdVKPipelineLayout;
 	class AdVKPipeline;
 	class AdVKDescriptorSetLayout;
-	class AdVKDescriptorPool;
+	class AdVKRingBuffer;
+	class AdRenderQueue;
+	struct AdRenderQueueStats;
+	class AdFrustumCuller;
+	struct AdCullStats;
+	class AdMesh;
 
 	class AdUnlitMaterialSystem : public AdMaterialSystem {
 	public:
 		void OnInit(AdVKRenderPass* renderPass) override;
 		void OnRender(VkCommandBuffer cmdBuffer, AdRenderTarget* renderTarget) override;
 		void OnDestroy() override;
+
+		// 上一帧的绘制包数、实例化绘制次数及材质/顶点缓冲绑定次数
+		const AdRenderQueueStats& GetRenderStats() const;
+		// 上一帧参与视锥体剔除的对象数与可见数
+		const AdCullStats& GetCullStats() const;
 	private:
-		void ReCreateMaterialDescPool(uint32_t materialCount);
-		void UpdateFrameUboDescSet(AdRenderTarget* renderTarget);
-		void UpdateMaterialParamsDescSet(VkDescriptorSet descSet, AdUnlitMaterial* material);
-		void UpdateMaterialResourceDescSet(VkDescriptorSet descSet, AdUnlitMaterial* material);
+		// 等待剔除的绘制包，与剔除器中的对象索引一一对应
+		struct CullCandidate {
+			uint64_t sortKey;
+			AdUnlitMaterial* material;
+			AdMesh* mesh;
+			glm::mat4 transform;
+		};
+
+		void GrowMaterialDescSets(uint32_t materialCount);
+		void UpdateUniformDescSets(uint32_t frameIndex);
+		uint32_t PushFrameUbo(AdRenderTarget* renderTarget);
+		void WriteMaterialParams(AdUnlitMaterial* material, void* dst);
+		bool WriteBindlessMaterialParams(AdUnlitMaterial* material, void* dst);
+		bool UpdateMaterialResourceDescSet(VkDescriptorSet descSet, AdUnlitMaterial* material);
+		void MarkMaterialsDirty(std::vector<uint32_t>& dirtyFrames, uint32_t frameMask);
 
 		std::shared_ptr<AdVKDescriptorSetLayout> mFrameUboDescSetLayout;
 		std::shared_ptr<AdVKDescriptorSetLayout> mMaterialParamDescSetLayout;
 		std::shared_ptr<AdVKDescriptorSetLayout> mMaterialResourceDescSetLayout;
 
+		// 设备支持 descriptor indexing 时使用无绑定路径，每帧只绑定一次描述符集
+		bool bBindless = false;
+
 		std::shared_ptr<AdVKPipelineLayout> mPipelineLayout;
-		std::shared_ptr<AdVKPipeline> mPipeline;
+		// 量化顶点(AdPackedVertex)使用的管线布局，描述符集布局与上面相同，切换管线后已绑定的描述符集仍然有效
+		std::shared_ptr<AdVKPipelineLayout> mPackedPipelineLayout;
+		// 按顶点布局索引：[AdVertexFormat]
+		std::shared_ptr<AdVKPipeline> mPipelines[AD_VERTEX_FORMAT_COUNT];
 
-		std::shared_ptr<AdVKDescriptorPool> mDescriptorPool;
-		std::shared_ptr<AdVKDescriptorPool> mMaterialDescriptorPool;
+		// 帧UBO与材质参数统一写入持久映射的环形缓冲区，以动态偏移绑定
+		std::shared_ptr<AdVKRingBuffer> mUniformRing;
+		// 以下描述符集按帧槽位(frame in flight)各持有一份：[frameIndex]，均指向该槽位的环形缓冲区
+		std::vector<VkDescriptorSet> mFrameUboDescSets;
+		std::vector<VkDescriptorSet> mMaterialParamDescSets;
+		// 材质参数在每个槽位中的位置固定：帧UBO之后按材质索引排列，未变化的材质无需重写
+		// 各材质仍需在哪些帧槽位上重写参数/纹理描述符：[materialIndex]，每一位对应一个帧槽位
+		VkDeviceSize mMaterialParamStride = 0;
+		std::vector<uint32_t> mMaterialParamsDirtyFrames;
+		std::vector<uint32_t> mMaterialResourceDirtyFrames;
 
-		VkDescriptorSet mFrameUboDescSet;
-		std::shared_ptr<AdVKBuffer> mFrameUboBuffer;
+		// 按排序键合批的渲染队列，以及存放每帧实例模型矩阵的环形顶点缓冲区
+		std::shared_ptr<AdRenderQueue> mRenderQueue;
+		std::shared_ptr<AdVKRingBuffer> mInstanceRing;
+		// 提交渲染队列之前先做视锥体剔除
+		std::shared_ptr<AdFrustumCuller> mCuller;
+		std::vector<CullCandidate> mCullCandidates;
 
+		// 材质纹理资源：[frameIndex][materialIndex]
 		uint32_t mLastDescriptorSetCount = 0;
-		std::vector<VkDescriptorSet> mMaterialDescSets;
-		std::vector<VkDescriptorSet> mMaterialResourceDescSets;
-		std::vector<std::shared_ptr<AdVKBuffer>> mMaterialBuffers;
+		std::vector<std::vector<VkDescriptorSet>> mMaterialResourceDescSets;
 		std::shared_ptr<AdTexture> mDefaultTexture;
 		std::shared_ptr<AdSampler> mDefaultSampler;
 
@@ -5,7 +5,6 @@
 #include "Graphic/AdVKDescriptorSet.h"
 #include "Graphic/AdVKCommandBuffer.h"
 #include "Render/AdRenderTarget.h"
-#include "Render/AdRenderer.h"
 #include "Graphic/AdVKPipeline.h"
 #include "imgui/imgui.h"
 #include "imgui/backends/imgui_impl_vulkan.h"
@@ -19,8 +18,8 @@ namespace WuDu {
 
 		// 初始化渲染资源
 		void OnInit();
-		// 渲染ImGui内容
-		void OnRender();
+		// 将ImGui内容录制到场景的命令缓冲区中（在场景渲染通道之后），与场景共用一次提交和呈现
+		void OnRender(VkCommandBuffer cmdBuffer);
 		// 清理渲染资源
 		void OnDestroy();
 		// 重建资源（窗口大小变化时调用）
@@ -28,8 +27,6 @@ namespace WuDu {
 		// 创建GUI渲染通道
 		void CreateGUIRenderPass();
 
-		// 获取渲染器
-		std::shared_ptr<AdRenderer> GetRenderer() const { return mGUIRenderer; }
 		// 获取渲染目标
 		std::shared_ptr<AdRenderTarget> GetRenderTarget() const { return mGUIRenderTarget; }
 		// 获取渲染通道
@@ -41,7 +38,5 @@ namespace WuDu {
 		std::shared_ptr<AdVKDescriptorPool> mImGuiDescriptorPool;
 		std::shared_ptr<AdVKRenderPass> mGUIRenderPass;    // GUI专用渲染通道
 		std::shared_ptr<AdRenderTarget> mGUIRenderTarget;   // GUI专用渲染目标
-		std::shared_ptr<AdRenderer> mGUIRenderer;          // GUI渲染器
-		std::vector<VkCommandBuffer> mGUICmdBuffers;        // GUI命令缓冲区数组
 	};
 }
\ No newline at end of file
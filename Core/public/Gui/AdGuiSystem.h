@@ -17,8 +17,8 @@ namespace WuDu {
 
 		// 初始化GUI系统
 		void OnInit();
-		// 渲染GUI
-		void OnRender();
+		// 将GUI录制到场景命令缓冲区（场景渲染通道之后）
+		void OnRender(VkCommandBuffer cmdBuffer);
 		// 销毁资源
 		void OnDestroy();
 		// 渲染前准备
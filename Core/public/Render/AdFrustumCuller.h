@@ -0,0 +1,56 @@
+#ifndef AD_FRUSTUMCULLER_H
+#define AD_FRUSTUMCULLER_H
+
+#include "AdEngine.h"
+#include <glm/glm.hpp>
+
+namespace WuDu {
+#define AD_FRUSTUM_PLANE_COUNT          6
+#define AD_FRUSTUM_CULL_SIMD_WIDTH      4           // 每次测试的包围盒数量，SoA 数组长度补齐为其整数倍
+
+	// 视锥体六个平面 (nx, ny, nz, d)，法线指向视锥体内部并已归一化
+	struct AdFrustum {
+		glm::vec4 planes[AD_FRUSTUM_PLANE_COUNT];
+
+		static AdFrustum FromViewProj(const glm::mat4& viewProj);
+	};
+
+	// 每帧统计：提交剔除的对象数与可见数
+	struct AdCullStats {
+		uint32_t objectCount = 0;
+		uint32_t visibleCount = 0;
+
+		uint32_t GetCulledCount() const { return objectCount - visibleCount; }
+	};
+
+	/**
+	 * @brief CPU视锥体剔除
+	 *
+	 * 每帧 Begin 之后以 Add 提交对象的模型空间包围盒与模型矩阵，包围盒变换为世界空间后按 SoA 存放；
+	 * Cull 用 SSE 一次测试 4 个包围盒与六个平面（不支持 SSE 的平台退化为标量循环），
+	 * 之后按 Add 返回的索引查询可见性。
+	 */
+	class AdFrustumCuller {
+	public:
+		void Begin(const glm::mat4& viewProj);
+		// 返回对象索引，Cull 之后用于 IsVisible 查询
+		uint32_t Add(const glm::vec3& boundsMin, const glm::vec3& boundsMax, const glm::mat4& transform);
+		void Cull();
+
+		bool IsVisible(uint32_t index) const { return mVisibility[index] != 0; }
+		const AdFrustum& GetFrustum() const { return mFrustum; }
+		const AdCullStats& GetStats() const { return mStats; }
+	private:
+		void CullScalar(uint32_t begin, uint32_t end);
+
+		AdFrustum mFrustum{};
+		uint32_t mObjectCount = 0;
+		// 世界空间包围盒：中心与半边长，各分量分别连续存放
+		std::vector<float> mCenterX, mCenterY, mCenterZ;
+		std::vector<float> mExtentX, mExtentY, mExtentZ;
+		std::vector<uint8_t> mVisibility;
+		AdCullStats mStats;
+	};
+}
+
+#endif
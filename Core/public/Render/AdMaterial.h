@@ -20,6 +20,11 @@ namespace WuDu {
 		alignas(16) glm::mat3 normalMat;
 	};
 
+	// 无绑定路径的推送常量：材质参数从材质SSBO中按索引读取，模型矩阵来自实例数据
+	struct BindlessMaterialPC {
+		alignas(4) uint32_t materialIndex;
+	};
+
 	// -------------------------------------------------------------------------------------------------
 
 	struct TextureView {
@@ -2,23 +2,58 @@
 #define AD_MESH_H
 
 #include "Graphic/AdVKBuffer.h"
+#include "Render/AdMeshPool.h"
 #include "AdGeometryUtil.h"
 #include "Resource/AdModelResource.h"
 
 namespace WuDu {
+	// 网格只是网格数据池中一段顶点/索引区间的句柄，同一区块中的网格共用缓冲绑定
 	class AdMesh {
 	public:
 		AdMesh(const std::vector<WuDu::AdVertex>& vertices, const std::vector<uint32_t>& indices = {});
 		AdMesh(const std::vector<WuDu::ModelVertex>& vertices, const std::vector<uint32_t>& indices = {});
+		// 使用模型加载时已计算的包围体；format 只能为 Model 或 Packed，Packed 时顶点量化为 AdPackedVertex，绘制时需乘以 GetDequantizeTransform()
+		AdMesh(const WuDu::ModelMesh& modelMesh, AdVertexFormat format = AdVertexFormat::Model);
 		~AdMesh();
 
+		// 顶点布局对应的顶点输入：绑定0上位置 0~4 依次为位置、纹理坐标、法线、切线、副切线(Packed 没有副切线，符号在位置 w 中)
+		static void GetVertexInputState(AdVertexFormat format, VkVertexInputBindingDescription* outBinding,
+			std::vector<VkVertexInputAttributeDescription>& outAttrs);
+
 		void Draw(VkCommandBuffer cmdBuffer);
+		// 绑定所在区块的顶点/索引缓冲，连续绘制同一区块中的网格时只需绑定一次
+		void Bind(VkCommandBuffer cmdBuffer);
+		// 不绑定缓冲，需先调用 Bind；实例数据由调用者绑定在顶点绑定点1上，firstInstance 为本批次在实例数据中的起始位置
+		void DrawInstanced(VkCommandBuffer cmdBuffer, uint32_t instanceCount, uint32_t firstInstance);
+		bool IsReady() const;
+		// 进程内唯一的网格编号，用于渲染队列排序键
+		uint32_t GetSortId() const { return mSortId; }
+		// 所在共享区块的缓冲句柄，相同时连续绘制无需重新绑定
+		VkBuffer GetVertexBuffer() const;
+		VkBuffer GetIndexBuffer() const;
+		const AdMeshAllocation& GetAllocation() const { return mAllocation; }
+		// 模型空间包围盒与包围球：xyz --> 球心, w --> 半径
+		const glm::vec3& GetBoundsMin() const { return mBoundsMin; }
+		const glm::vec3& GetBoundsMax() const { return mBoundsMax; }
+		const glm::vec4& GetBoundingSphere() const { return mBoundingSphere; }
+		AdVertexFormat GetVertexFormat() const { return mVertexFormat; }
+		// 量化位置到模型空间的变换：xyz --> 平移, w --> 统一缩放；非 Packed 格式为单位变换
+		const glm::vec4& GetDequantize() const { return mDequantize; }
+		glm::mat4 GetDequantizeTransform() const;
 
 	private:
-		std::shared_ptr<AdVKBuffer> mVertexBuffer;
-		std::shared_ptr<AdVKBuffer> mIndexBuffer;
-		uint32_t mVertexCount;
-		uint32_t mIndexCount;
+		inline static std::atomic<uint32_t> sNextSortId{ 0 };
+
+		void Create(uint32_t vertexStride, const void* vertices, uint32_t vertexCount, const std::vector<uint32_t>& indices, bool bComputeBounds = true);
+
+		uint32_t mSortId = sNextSortId.fetch_add(1);
+		AdMeshPool* mPool = nullptr;
+		AdMeshAllocation mAllocation;
+		glm::vec3 mBoundsMin{ 0.f };
+		glm::vec3 mBoundsMax{ 0.f };
+		glm::vec4 mBoundingSphere{ 0.f };
+		AdVertexFormat mVertexFormat = AdVertexFormat::Float;
+		glm::vec4 mDequantize{ 0.f, 0.f, 0.f, 1.f };
 	};
 }
 #endif
\ No newline at end of file
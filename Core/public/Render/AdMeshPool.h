@@ -0,0 +1,87 @@
+#ifndef AD_MESHPOOL_H
+#define AD_MESHPOOL_H
+
+#include "Graphic/AdVKCommon.h"
+
+namespace WuDu {
+	class AdVKDevice;
+	class AdVKBuffer;
+
+#define AD_MESH_POOL_VERTEX_BLOCK_SIZE      (64ull * 1024 * 1024)     // 每个顶点缓冲区块的大小
+#define AD_MESH_POOL_INDEX_BLOCK_SIZE       (32ull * 1024 * 1024)     // 每个索引缓冲区块的大小
+
+	// 网格在共享缓冲区中的位置，偏移均以元素（顶点/索引）为单位，可直接用作 vertexOffset / firstIndex
+	struct AdMeshAllocation {
+		AdVKBuffer* vertexBuffer = nullptr;
+		AdVKBuffer* indexBuffer = nullptr;
+		uint32_t vertexStride = 0;
+		uint32_t vertexOffset = 0;
+		uint32_t vertexCount = 0;
+		uint32_t firstIndex = 0;
+		uint32_t indexCount = 0;
+		uint64_t uploadTicket = 0;
+	};
+
+	/**
+	 * @brief 网格几何数据池
+	 *
+	 * 所有网格的顶点与索引从少量大块设备本地缓冲区中子分配：顶点按步长（顶点格式）分别成块，
+	 * 索引统一为 uint32 共用索引块。区块写满时追加新区块，已有区块不会移动，分配结果在网格生命周期内保持有效。
+	 * 同一区块中的网格共用顶点/索引缓冲绑定，绘制时以 vertexOffset / firstIndex 定位。
+	 *
+	 * 释放的区间要等所有在途帧结束、且其上传已完成后才能复用，每帧开始时调用 Update 推进回收。
+	 * 所有公开接口线程安全。
+	 */
+	class AdMeshPool {
+	public:
+		AdMeshPool(AdVKDevice* device, uint32_t framesInFlight);
+		~AdMeshPool();
+
+		bool Allocate(uint32_t vertexStride, const void* vertices, uint32_t vertexCount, const uint32_t* indices, uint32_t indexCount, AdMeshAllocation* outAllocation);
+		void Free(const AdMeshAllocation& allocation);
+
+		// 每帧开始时调用，回收已不再被在途帧引用的区间
+		void Update();
+
+		bool IsReady(const AdMeshAllocation& allocation) const;
+		uint32_t GetBlockCount() const;
+		VkDeviceSize GetUsedSize() const;
+	private:
+		struct Block {
+			std::shared_ptr<AdVKBuffer> buffer;
+			uint32_t capacity = 0;
+			uint32_t usedCount = 0;
+			std::map<uint32_t, uint32_t> freeRanges;      // 起始元素 -> 元素个数，按地址有序以便合并相邻区间
+		};
+
+		struct Arena {
+			uint32_t elementSize = 0;
+			VkBufferUsageFlags usage = 0;
+			VkDeviceSize blockSize = 0;
+			std::vector<std::unique_ptr<Block>> blocks;
+		};
+
+		struct PendingFree {
+			Block* block;
+			uint32_t offset;
+			uint32_t count;
+			uint64_t frame;
+			uint64_t uploadTicket;
+		};
+
+		Block* AllocateRange(Arena* arena, uint32_t count, uint32_t* outOffset);
+		Block* FindBlock(AdVKBuffer* buffer) const;
+		static void FreeRange(Block* block, uint32_t offset, uint32_t count);
+
+		AdVKDevice* mDevice;
+		uint32_t mFramesInFlight;
+		uint64_t mFrameCounter = 0;
+
+		std::unordered_map<uint32_t, std::unique_ptr<Arena>> mVertexArenas;     // 顶点步长 -> 顶点区块
+		Arena mIndexArena;
+		std::deque<PendingFree> mPendingFrees;
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
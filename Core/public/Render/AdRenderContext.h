@@ -4,22 +4,32 @@
 #include "Graphic/AdVKGraphicContext.h"
 #include "Graphic/AdVkSwapchain.h"
 #include "Graphic/AdVKDevice.h"
+#include "Render/AdMeshPool.h"
 
 namespace WuDu {
 	class AdWindow;
 
 	class AdRenderContext {
 	public:
-		AdRenderContext(AdWindow* window);
+		AdRenderContext(AdWindow* window, const AdVkSettings& settings = {});
 		~AdRenderContext();
 
 		AdGraphicContext* GetGraphicContext() const { return mGraphicContext.get(); }
 		AdVKDevice* GetDevice() const { return mDevice.get(); }
 		AdVKSwapchain* GetSwapchain() const { return mSwapchain.get(); }
+		AdMeshPool* GetMeshPool() const { return mMeshPool.get(); }
+
+		// 帧并行(frames in flight)信息：由渲染器在每帧开始时更新，材质系统据此选择当前帧的资源
+		uint32_t GetFramesInFlight() const { return mDevice->GetSettings().framesInFlight; }
+		uint32_t GetCurrentFrameIndex() const { return mCurrentFrameIndex; }
+		void SetCurrentFrameIndex(uint32_t frameIndex) { mCurrentFrameIndex = frameIndex; }
 	private:
 		std::shared_ptr<AdGraphicContext> mGraphicContext;
 		std::shared_ptr<AdVKDevice> mDevice;
 		std::shared_ptr<AdVKSwapchain> mSwapchain;
+		std::shared_ptr<AdMeshPool> mMeshPool;
+
+		uint32_t mCurrentFrameIndex = 0;
 	};
 }
 
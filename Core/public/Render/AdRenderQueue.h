@@ -0,0 +1,84 @@
+#ifndef AD_RENDERQUEUE_H
+#define AD_RENDERQUEUE_H
+
+#include "Graphic/AdVKCommon.h"
+#include <glm/glm.hpp>
+
+namespace WuDu {
+	class AdMaterial;
+	class AdMesh;
+	enum class AdVertexFormat;
+
+	// 64位排序键布局（高位优先）：| pass 4 | pipeline 12 | material 16 | mesh 16 | depth 16 |
+#define AD_SORT_KEY_PASS_SHIFT          60
+#define AD_SORT_KEY_PIPELINE_SHIFT      48
+#define AD_SORT_KEY_MATERIAL_SHIFT      32
+#define AD_SORT_KEY_MESH_SHIFT          16
+#define AD_SORT_KEY_STATE_MASK          (~0xFFFFull)        // 去掉深度后的状态部分，相同者可合并为一个实例化批次
+
+#define AD_RENDER_PASS_OPAQUE           0
+#define AD_RENDER_PASS_TRANSPARENT      1
+
+	// 一次实例化绘制：相同材质与网格的实例在实例数据中连续存放
+	struct AdRenderBatch {
+		uint64_t sortKey;
+		AdMaterial* material;
+		AdMesh* mesh;
+		uint32_t firstInstance;
+		uint32_t instanceCount;
+	};
+
+	// 每帧统计：逐包绘制时每个包都要绑定一次材质和顶点缓冲，与实际绑定次数之差即为省掉的绑定
+	struct AdRenderQueueStats {
+		uint32_t packetCount = 0;
+		uint32_t drawCount = 0;
+		uint32_t materialBindCount = 0;
+		uint32_t meshBindCount = 0;
+
+		uint32_t GetBindsAvoided() const { return packetCount * 2 - materialBindCount - meshBindCount; }
+	};
+
+	/**
+	 * @brief 基于排序键的渲染队列
+	 *
+	 * 材质系统每帧把可见实体以绘制包 (排序键, 材质, 网格, 模型矩阵) 提交到队列，Build 时对排序键做基数排序，
+	 * 状态相同（去掉深度位后排序键相等，且材质与网格相同）的相邻包合并为一个实例化批次，
+	 * 生成按批次连续排列的实例变换数组。Record 按排序顺序录制绘制命令，只在材质或网格变化时重新绑定。
+	 */
+	class AdRenderQueue {
+	public:
+		static uint64_t MakeSortKey(uint32_t pass, uint32_t pipelineId, uint32_t materialIndex, uint32_t meshId, float viewDepth);
+
+		void Clear();
+		void Push(uint64_t sortKey, AdMaterial* material, AdMesh* mesh, const glm::mat4& transform);
+		void Build();
+		// 录制所有批次：材质变化时调用 bindMaterial，网格变化时绑定顶点/索引缓冲；实例数据需由调用者预先绑定
+		// 调用前需已绑定 Float 顶点格式的管线，顶点格式变化时调用 bindVertexFormat 切换管线，返回 false 时跳过该格式的批次；
+		// 未提供 bindVertexFormat 时只绘制 Float 格式的网格
+		void Record(VkCommandBuffer cmdBuffer, const std::function<void(AdMaterial*)>& bindMaterial,
+			const std::function<bool(AdVertexFormat)>& bindVertexFormat = nullptr);
+
+		bool IsEmpty() const { return mPackets.empty(); }
+		const std::vector<AdRenderBatch>& GetBatches() const { return mBatches; }
+		const std::vector<glm::mat4>& GetInstanceTransforms() const { return mInstanceTransforms; }
+		const AdRenderQueueStats& GetStats() const { return mStats; }
+	private:
+		struct Packet {
+			uint64_t sortKey;
+			AdMaterial* material;
+			AdMesh* mesh;
+			uint32_t transformIndex;
+		};
+
+		void RadixSort();
+
+		std::vector<Packet> mPackets;
+		std::vector<Packet> mSortScratch;
+		std::vector<glm::mat4> mTransforms;
+		std::vector<glm::mat4> mInstanceTransforms;
+		std::vector<AdRenderBatch> mBatches;
+		AdRenderQueueStats mStats;
+	};
+}
+
+#endif
@@ -28,10 +28,17 @@ namespace WuDu {
 		void SetDepthStencilClearValue(uint32_t attachmentIndex, VkClearDepthStencilValue depthStencilValue);
 
 		template<typename T, typename... Args>
-		void AddMaterialSystem(Args&&... args) {
-			std::shared_ptr<AdMaterialSystem> system = std::make_shared<T>(std::forward<Args>(args)...);
+		T* AddMaterialSystem(Args&&... args) {
+			std::shared_ptr<T> system = std::make_shared<T>(std::forward<Args>(args)...);
 			system->OnInit(mRenderPass);
 			mMaterialSystemList.push_back(system);
+			return system.get();
+		}
+
+		void PrepareMaterialSystems(VkCommandBuffer cmdBuffer) {
+			for (auto& item : mMaterialSystemList) {
+				item->OnPrepare(cmdBuffer, this);
+			}
 		}
 
 		void RenderMaterialSystems(VkCommandBuffer cmdBuffer) {
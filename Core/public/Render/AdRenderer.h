@@ -4,8 +4,6 @@
 #include "AdRenderContext.h"
 
 namespace WuDu {
-#define RENDERER_NUM_BUFFER     2
-
 	class AdRenderer {
 	public:
 		AdRenderer();
@@ -13,9 +11,27 @@ namespace WuDu {
 
 		bool Begin(int32_t* outImageIndex);
 		bool End(int32_t imageIndex, const std::vector<VkCommandBuffer>& cmdBuffers);
+
+		// 当前帧在帧并行环中的索引，每帧的命令缓冲/Uniform/描述符应以此索引选取
+		uint32_t GetCurrentFrameIndex() const { return mCurrentBuffer; }
+		uint32_t GetFramesInFlight() const { return mFramesInFlight; }
+		// 上一帧(Begin到End之间)发生的设备空闲等待次数，稳态下应为0
+		uint32_t GetLastFrameWaitIdleCount() const { return mLastFrameWaitIdleCount; }
+		// 上一帧写入的描述符数量，材质未变化时稳态下应为0
+		uint32_t GetLastFrameDescriptorWriteCount() const { return mLastFrameDescriptorWriteCount; }
 	private:
+		void CreateSubmitedSemaphores();
+		void DestroySubmitedSemaphores();
+
+		uint32_t mFramesInFlight = 0;
 		uint32_t mCurrentBuffer = 0;
+		uint64_t mFrameWaitIdleBase = 0;
+		uint32_t mLastFrameWaitIdleCount = 0;
+		uint64_t mFrameDescriptorWriteBase = 0;
+		uint32_t mLastFrameDescriptorWriteCount = 0;
 		std::vector<VkSemaphore> mImageAvailableSemaphores;
+		// 呈现等待的信号量按交换链图像索引：[imageIndex]；帧围栏只覆盖提交，不覆盖呈现，
+		// 按帧槽位复用会在呈现读取之前被后续提交再次触发
 		std::vector<VkSemaphore> mSubmitedSemaphores;
 		std::vector<VkFence> mFrameFences;
 		bool mNeedSwapchainRecreate = false;
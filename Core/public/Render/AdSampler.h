@@ -26,10 +26,13 @@ namespace WuDu {
 		~AdSampler();
 
 		VkSampler GetHandle() const { return mHandle; }
+		// 在无绑定采样器数组中的索引，设备不支持无绑定时为 UINT32_MAX
+		uint32_t GetBindlessIndex() const { return mBindlessIndex; }
 
 	private:
 		AdVKDevice* mDevice;
 		VkSampler mHandle = VK_NULL_HANDLE;
+		uint32_t mBindlessIndex = UINT32_MAX;
 		void CreateSampler(const Settings& settings);
 	};
 }
\ No newline at end of file
@@ -25,6 +25,12 @@ namespace WuDu {
 		uint32_t GetHeight() const { return mHeight; }
 		AdVKImage* GetImage() const { return mImage.get(); }
 		AdVKImageView* GetImageView() const { return mImageView.get(); }
+
+		// 纹理数据通过上传上下文异步写入，未就绪时渲染应使用默认纹理
+		bool IsReady() const;
+		void WaitReady() const;
+		// 在无绑定纹理数组中的索引，设备不支持无绑定时为 UINT32_MAX
+		uint32_t GetBindlessIndex() const { return mBindlessIndex; }
 	private:
 		void CreateImage(size_t size, void* data);
 
@@ -33,6 +39,8 @@ namespace WuDu {
 		VkFormat mFormat;
 		std::shared_ptr<AdVKImage> mImage;
 		std::shared_ptr<AdVKImageView> mImageView;
+		uint64_t mUploadTicket = 0;
+		uint32_t mBindlessIndex = UINT32_MAX;
 	};
 }
 
@@ -0,0 +1,55 @@
+#ifndef AD_MESH_OPTIMIZER_H
+#define AD_MESH_OPTIMIZER_H
+
+#include "Resource/AdModelResource.h"
+#include "AdEngine.h"
+
+namespace WuDu {
+
+#define AD_MESH_OPTIMIZER_CACHE_SIZE            16          // 模拟的后变换顶点缓存(FIFO)大小
+#define AD_MESH_OPTIMIZER_OVERDRAW_THRESHOLD    1.05f       // 过度绘制排序允许的 ACMR 劣化比例
+
+	// 顶点缓存统计，ACMR = 未命中数 / 三角形数，ATVR = 未命中数 / 被引用的顶点数(理想值 1)
+	struct AdVertexCacheStats {
+		uint32_t triangleCount = 0;
+		uint32_t vertexCount = 0;
+		uint32_t cacheMisses = 0;
+
+		float GetACMR() const { return triangleCount > 0 ? static_cast<float>(cacheMisses) / triangleCount : 0.f; }
+		float GetATVR() const { return vertexCount > 0 ? static_cast<float>(cacheMisses) / vertexCount : 0.f; }
+
+		AdVertexCacheStats& operator+=(const AdVertexCacheStats& other) {
+			triangleCount += other.triangleCount;
+			vertexCount += other.vertexCount;
+			cacheMisses += other.cacheMisses;
+			return *this;
+		}
+	};
+
+	/**
+	 * @brief 导入期网格优化
+	 *
+	 * 依次执行：
+	 * 1. 顶点缓存排序：Tipsify(Sander 2007)，线性时间，同时得到缓存刷新处的硬簇边界；
+	 * 2. 过度绘制排序：在硬簇内按 ACMR 阈值再切分软簇，按簇朝外程度排序，先绘制外侧的簇以提高早期深度剔除率；
+	 * 3. 顶点读取重映射：按索引首次引用顺序重排顶点，去掉未引用顶点，使顶点读取尽量顺序。
+	 */
+	class AdMeshOptimizer {
+	public:
+		static AdVertexCacheStats AnalyzeVertexCache(const std::vector<uint32_t>& indices, uint32_t vertexCount,
+													uint32_t cacheSize = AD_MESH_OPTIMIZER_CACHE_SIZE);
+
+		static void Optimize(ModelMesh& mesh, AdVertexCacheStats* outBefore = nullptr, AdVertexCacheStats* outAfter = nullptr);
+
+		static void OptimizeVertexCache(std::vector<uint32_t>& indices, uint32_t vertexCount,
+										std::vector<uint32_t>* outClusters = nullptr,
+										uint32_t cacheSize = AD_MESH_OPTIMIZER_CACHE_SIZE);
+		static void OptimizeOverdraw(std::vector<uint32_t>& indices, const std::vector<ModelVertex>& vertices,
+									const std::vector<uint32_t>& hardClusters,
+									float threshold = AD_MESH_OPTIMIZER_OVERDRAW_THRESHOLD,
+									uint32_t cacheSize = AD_MESH_OPTIMIZER_CACHE_SIZE);
+		static void OptimizeVertexFetch(std::vector<uint32_t>& indices, std::vector<ModelVertex>& vertices);
+	};
+}
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef AD_MODEL_CACHE_H
+#define AD_MODEL_CACHE_H
+
+#include "Resource/AdModelResource.h"
+#include "AdEngine.h"
+
+namespace WuDu {
+
+#define AD_MODEL_CACHE_MAGIC            0x48534D41      // "AMSH"
+#define AD_MODEL_CACHE_VERSION          2               // 布局变化时递增，旧缓存自动失效
+#define AD_MODEL_CACHE_EXTENSION        ".admesh"
+#define AD_MODEL_CACHE_ALIGNMENT        16
+
+	// 字符串表中的一段，offset 相对字符串表起始位置
+	struct AdModelCacheString {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	struct AdModelCacheHeader {
+		uint32_t magic;
+		uint32_t version;
+		uint64_t sourceHash;            // 源文件内容与导入选项的哈希
+		uint64_t fileSize;
+		uint32_t vertexStride;          // sizeof(ModelVertex)，顶点结构变化时缓存失效
+		uint32_t meshCount;
+		uint32_t materialCount;
+		uint32_t stringTableSize;
+		uint64_t meshTableOffset;
+		uint64_t materialTableOffset;
+		uint64_t stringTableOffset;
+	};
+
+	struct AdModelCacheMesh {
+		uint64_t vertexOffset;
+		uint64_t indexOffset;
+		uint32_t vertexCount;
+		uint32_t indexCount;
+		uint32_t materialIndex;
+		AdModelCacheString name;
+		glm::vec3 boundsMin;
+		glm::vec3 boundsMax;
+		glm::vec4 boundingSphere;
+	};
+
+	struct AdModelCacheMaterial {
+		AdModelCacheString name;
+		glm::vec3 baseColor;
+		float metallic;
+		float roughness;
+		float ao;
+		float alpha;
+		glm::vec3 emissiveColor;
+		float emissiveStrength;
+		float anisotropy;
+		glm::vec3 anisotropyDirection;
+		AdModelCacheString baseColorTexturePath;
+		AdModelCacheString metallicTexturePath;
+		AdModelCacheString roughnessTexturePath;
+		AdModelCacheString normalTexturePath;
+		AdModelCacheString aoTexturePath;
+		AdModelCacheString alphaTexturePath;
+		AdModelCacheString emissiveTexturePath;
+	};
+
+	/**
+	 * @brief 模型烘焙缓存(.admesh)
+	 *
+	 * 首次用 Assimp 导入后，把网格的顶点/索引数据、材质与包围体按上面的定长结构连续写入缓存文件；
+	 * 之后的加载内存映射该文件，校验头部后按偏移直接整块拷贝，不经过 Assimp 也不做逐元素解析。
+	 * 头部记录源文件内容与导入选项的哈希，源文件或导入选项改变后缓存自动失效并重新生成。
+	 */
+	class AdModelCache {
+	public:
+		static std::string GetCachePath(const std::string& sourcePath);
+		static bool ComputeSourceHash(const std::string& sourcePath, uint32_t importFlags, const AdModelImportSettings& settings, uint64_t* outHash);
+
+		static bool Load(const std::string& cachePath, uint64_t sourceHash,
+						std::vector<ModelMesh>& meshes,
+						std::vector<ModelMaterial>& materials);
+
+		static bool Save(const std::string& cachePath, uint64_t sourceHash,
+						const std::vector<ModelMesh>& meshes,
+						const std::vector<ModelMaterial>& materials);
+	};
+}
+
+#endif
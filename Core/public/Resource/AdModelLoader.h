@@ -1,5 +1,6 @@
 #pragma once
 #include "Resource/AdModelResource.h"
+#include "AdGeometryUtil.h"
 #include "AdEngine.h"
 #include <assimp/Importer.hpp>
 #include <assimp/scene.h>
@@ -11,19 +12,17 @@ namespace WuDu {
 	public:
 		static bool LoadModel(const std::string& filePath,
 								std::vector<ModelMesh>& meshes,
-								std::vector<ModelMaterial>& materials);
+								std::vector<ModelMaterial>& materials,
+								const AdModelImportSettings& settings = {});
 
 	private:
-		//处理assimp节点
+		//收集assimp节点引用的网格，保持深度优先顺序
 		static void ProcessNode(aiNode* node,
 							const aiScene* scene,
-							std::vector<ModelMesh>& meshes,
-							std::vector<ModelMaterial>& materials);
+							std::vector<const aiMesh*>& sceneMeshes);
 
-		//处理单个网格 提取顶点数据
-		static ModelMesh ProcessMesh(aiMesh* mesh,
-			const aiScene* scene,
-			const std::vector<ModelMaterial>& materials);
+		//处理单个网格 提取顶点数据，直接写入预先分配的输出
+		static void ProcessMesh(const aiMesh* mesh, ModelMesh& result);
 
 		//处理材质
 		static void ProcessMaterials(const aiScene* scene,
@@ -26,6 +26,10 @@ namespace WuDu {
 		uint32_t VertexCount;
 		uint32_t IndexCount;
 		uint32_t MaterialIndex;
+		// 模型空间包围盒与包围球，加载时计算
+		glm::vec3 BoundsMin{ 0.f };
+		glm::vec3 BoundsMax{ 0.f };
+		glm::vec4 BoundingSphere{ 0.f };
 
 	};
 
@@ -53,9 +57,17 @@ namespace WuDu {
 		std::string EmissiveTexturePath;    // 自发光纹理
 	};
 
+	// 单个模型资源的导入选项，影响导入结果的选项参与烘焙缓存的哈希，修改后缓存自动重新生成
+	struct AdModelImportSettings {
+		bool bOptimizeMeshes = true;        // 导入时执行顶点缓存/过度绘制/顶点读取优化
+		// 以下选项不改变导入结果，不参与哈希
+		bool bParallelMeshes = true;        // 网格转换与优化在线程池上并行执行，关闭时在调用线程上串行执行
+		bool bUseCache = true;              // 读写烘焙缓存，关闭时总是经过 Assimp 导入
+	};
+
 	class AdModelResource : public AdResource {
 	public:
-		AdModelResource(const std::string& modelPath);
+		AdModelResource(const std::string& modelPath, const AdModelImportSettings& settings = {});
 		~AdModelResource();
 
 		bool Load() override;
@@ -65,6 +77,7 @@ namespace WuDu {
 
 	private:
 		std::string mModelPath;
+		AdModelImportSettings mImportSettings;
 		std::vector<ModelMesh> mMeshes;
 		std::vector<ModelMaterial> mMaterials;
 		std::shared_ptr<AdVKDevice> mDevice;
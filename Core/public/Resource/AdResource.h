@@ -56,6 +56,8 @@ namespace WuDu {
 		UUID
 	};
 
+	class AdResourceManager;
+
 	class AdResource {
 	public:
 		AdResource(const std::string& resourcePath) :mPath(resourcePath), mUUID(CreateUUID()), mState(ResourceState::Unloaded), mRefCount(0) {}
@@ -66,8 +68,9 @@ namespace WuDu {
 		//virtual bool Reload();
 
 		const std::string& GetPath() const { return mPath; }
-		ResourceState GetState() const { return mState; }
-		bool IsLoaded() const { return mState == ResourceState::Loaded; }
+		const UUID& GetUUID() const { return mUUID; }
+		ResourceState GetState() const { return mState.load(std::memory_order_acquire); }
+		bool IsLoaded() const { return GetState() == ResourceState::Loaded; }
 
 		void AddReference() {
 			mRefCount.fetch_add(1);
@@ -81,10 +84,15 @@ namespace WuDu {
 		}
 
 	protected:
+		void SetState(ResourceState state) { mState.store(state, std::memory_order_release); }
+
 		UUID mUUID;
 		std::string mPath;
-		ResourceState mState;
+		// 异步加载时由工作线程写入，其他线程读取
+		std::atomic<ResourceState> mState;
 		std::atomic<int32_t> mRefCount;
+
+		friend class AdResourceManager;
 	};
 
 }
@@ -3,44 +3,80 @@
 
 #include "AdResource.h"
 #include "AdEngine.h"
+#include "AdThreadPool.h"
 #include "Adlog.h"
 
 namespace WuDu {
+	/**
+	 * @brief 资源加载句柄
+	 *
+	 * 资源对象在请求时立即创建，处于 Loading 状态；加载在工作线程完成后句柄变为就绪。
+	 * 同一路径的并发请求共享同一个资源对象与同一个就绪状态。
+	 */
+	template<typename T>
+	class AdResourceHandle {
+	public:
+		AdResourceHandle() = default;
+		AdResourceHandle(std::shared_ptr<T> resource, std::shared_future<bool> loaded) : mResource(std::move(resource)), mLoaded(std::move(loaded)) {}
+
+		bool IsValid() const { return mResource != nullptr; }
+		bool IsReady() const {
+			return mLoaded.valid() && mLoaded.wait_for(std::chrono::seconds(0)) == std::future_status::ready;
+		}
+
+		// 阻塞直到加载结束，返回是否加载成功
+		bool Wait() const {
+			return mLoaded.valid() && mLoaded.get();
+		}
+
+		// 阻塞直到加载结束，加载失败时资源处于 Failed 状态
+		std::shared_ptr<T> Get() const {
+			Wait();
+			return mResource;
+		}
+
+		// 不等待，直接返回资源对象，调用方需自行检查状态
+		const std::shared_ptr<T>& GetResource() const { return mResource; }
+	private:
+		std::shared_ptr<T> mResource;
+		std::shared_future<bool> mLoaded;
+	};
+
 	//资源管理器
 	class AdResourceManager {
 	public:
 		static AdResourceManager* GetInstance();
 
+		/**
+		 * @brief 同步加载资源，在调用线程上执行加载
+		 *
+		 * 该路径已有进行中的加载时等待其完成，不重复加载。
+		 */
 		template<typename T, typename... Args>
 		std::shared_ptr<T> Load(const std::string& path, Args&&... args) {
-			static_assert(std::is_base_of<AdResource, T>::value, "T must derive from AdResource");
-
-			std::lock_guard<std::mutex> lock(mMutex);
-
-			// 首先检查路径是否已经存在
-			auto pathIt = mPathToUUID.find(path);
-			if (pathIt != mPathToUUID.end()) {
-				const UUID& uuid = pathIt->second;
-				auto uuidIt = mUUIDToResource.find(uuid);
-				if (uuidIt != mUUIDToResource.end()) {
-					auto resource = std::dynamic_pointer_cast<T>(uuidIt->second.lock());
-					if (resource) {
-						return resource;
-					}
-				}
+			bool bOwner = false;
+			AdResourceHandle<T> handle = Acquire<T>(path, bOwner, std::forward<Args>(args)...);
+			if (bOwner) {
+				RunLoad(path, handle.GetResource());
 			}
+			return handle.Get();
+		}
 
-			// 创建新资源，资源内部会生成UUID
-			auto resource = std::make_shared<T>(path, std::forward<Args>(args)...);
-			if (resource->Load()) {
-				const UUID& uuid = resource->GetUUID();
-
-				// 更新双映射表
-				mUUIDToResource[uuid] = resource;
-				mPathToUUID[path] = uuid;
+		/**
+		 * @brief 异步加载资源，立即返回句柄，加载在 AdThreadPool 的工作线程上执行
+		 *
+		 * 同一路径已加载时返回已就绪的句柄，正在加载时返回同一个进行中的句柄。
+		 * 不要在工作线程中等待另一个异步加载的句柄，否则所有工作线程都可能阻塞在等待上。
+		 */
+		template<typename T, typename... Args>
+		AdResourceHandle<T> LoadAsync(const std::string& path, Args&&... args) {
+			bool bOwner = false;
+			AdResourceHandle<T> handle = Acquire<T>(path, bOwner, std::forward<Args>(args)...);
+			if (bOwner) {
+				std::shared_ptr<AdResource> resource = handle.GetResource();
+				AdThreadPool::GetInstance()->Submit([this, path, resource]() { RunLoad(path, resource); });
 			}
-
-			return resource;
+			return handle;
 		}
 
 		// 通过路径获取资源
@@ -49,19 +85,12 @@ namespace WuDu {
 			static_assert(std::is_base_of<AdResource, T>::value, "T must derive from AdResource");
 
 			std::lock_guard<std::mutex> lock(mMutex);
-
-			auto pathIt = mPathToUUID.find(path);
-			if (pathIt != mPathToUUID.end()) {
-				const UUID& uuid = pathIt->second;
-				return Get<T>(uuid);
-			}
-
-			return nullptr;
+			return FindLoaded<T>(path);
 		}
 
-		// 通过UUID获取资源
+		// 通过UUID获取资源，UUID 与路径同为字符串，不能与 Get 重载
 		template<typename T>
-		std::shared_ptr<T> Get(const UUID& uuid) {
+		std::shared_ptr<T> GetByUUID(const UUID& uuid) {
 			static_assert(std::is_base_of<AdResource, T>::value, "T must derive from AdResource");
 
 			std::lock_guard<std::mutex> lock(mMutex);
@@ -131,15 +160,86 @@ namespace WuDu {
 			return mRootPath + relativePath;
 		}
 
+		uint32_t GetPendingCount() {
+			std::lock_guard<std::mutex> lock(mMutex);
+			return static_cast<uint32_t>(mPendingLoads.size());
+		}
+
 	private:
 		AdResourceManager();
 		~AdResourceManager();
 
+		// 进行中的加载：资源对象与加载结束时兑现的 promise
+		struct PendingLoad {
+			std::shared_ptr<AdResource> resource;
+			std::shared_ptr<std::promise<bool>> promise;
+			std::shared_future<bool> loaded;
+		};
+
+		// 调用方需持有 mMutex
+		template<typename T>
+		std::shared_ptr<T> FindLoaded(const std::string& path) {
+			auto pathIt = mPathToUUID.find(path);
+			if (pathIt == mPathToUUID.end()) {
+				return nullptr;
+			}
+			auto uuidIt = mUUIDToResource.find(pathIt->second);
+			if (uuidIt == mUUIDToResource.end()) {
+				return nullptr;
+			}
+			return std::dynamic_pointer_cast<T>(uuidIt->second.lock());
+		}
+
+		/**
+		 * @brief 查找已加载或进行中的资源，都不存在时创建资源并登记为进行中
+		 *
+		 * 只在锁内做映射表查找与登记，资源构造也在锁内完成(构造不应包含耗时加载)。
+		 *
+		 * @param bOwner 输出，为 true 时调用方负责执行 RunLoad
+		 */
+		template<typename T, typename... Args>
+		AdResourceHandle<T> Acquire(const std::string& path, bool& bOwner, Args&&... args) {
+			static_assert(std::is_base_of<AdResource, T>::value, "T must derive from AdResource");
+			bOwner = false;
+
+			std::lock_guard<std::mutex> lock(mMutex);
+			if (auto resource = FindLoaded<T>(path)) {
+				std::promise<bool> ready;
+				ready.set_value(true);
+				return AdResourceHandle<T>(resource, ready.get_future().share());
+			}
+
+			auto pendingIt = mPendingLoads.find(path);
+			if (pendingIt != mPendingLoads.end()) {
+				auto resource = std::dynamic_pointer_cast<T>(pendingIt->second.resource);
+				if (!resource) {
+					LOG_E("Resource {0} is already loading as a different type", path);
+					return {};
+				}
+				return AdResourceHandle<T>(resource, pendingIt->second.loaded);
+			}
+
+			// 创建新资源，资源内部会生成UUID
+			auto resource = std::make_shared<T>(path, std::forward<Args>(args)...);
+			resource->SetState(ResourceState::Loading);
+			PendingLoad pending;
+			pending.resource = resource;
+			pending.promise = std::make_shared<std::promise<bool>>();
+			pending.loaded = pending.promise->get_future().share();
+			AdResourceHandle<T> handle(resource, pending.loaded);
+			mPendingLoads.emplace(path, std::move(pending));
+			bOwner = true;
+			return handle;
+		}
+
+		void RunLoad(const std::string& path, const std::shared_ptr<AdResource>& resource);
+
 		std::string mRootPath;
 
 		// 双映射表实现双索引系统
 		std::unordered_map<UUID, std::weak_ptr<AdResource>> mUUIDToResource;  // UUID到资源的映射
 		std::unordered_map<std::string, UUID> mPathToUUID;  // 路径到UUID的映射
+		std::unordered_map<std::string, PendingLoad> mPendingLoads;  // 路径到进行中加载的映射
 
 		std::mutex mMutex;
 	};
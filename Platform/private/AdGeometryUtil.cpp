@@ -1,4 +1,5 @@
 #include "AdGeometryUtil.h"
+#include "glm/gtc/packing.hpp"
 
 namespace WuDu {
 	void AdGeometryUtil::CreateCube(float leftPlane, float rightPlane, float bottomPlane, float topPlane, float nearPlane, float farPlane,
@@ -113,4 +114,83 @@ namespace WuDu {
 			20, 21, 22, 20, 22, 23
 		};
 	}
+
+	void AdGeometryUtil::ComputeBounds(const void* vertices, uint32_t vertexStride, uint32_t vertexCount,
+		glm::vec3& outMin, glm::vec3& outMax, glm::vec4& outSphere) {
+		if (vertexCount == 0) {
+			outMin = outMax = glm::vec3(0.f);
+			outSphere = glm::vec4(0.f);
+			return;
+		}
+		const uint8_t* vertexBytes = static_cast<const uint8_t*>(vertices);
+		outMin = glm::vec3(std::numeric_limits<float>::max());
+		outMax = glm::vec3(std::numeric_limits<float>::lowest());
+		for (uint32_t i = 0; i < vertexCount; i++) {
+			glm::vec3 position;
+			memcpy(&position, vertexBytes + static_cast<size_t>(i) * vertexStride, sizeof(position));
+			outMin = glm::min(outMin, position);
+			outMax = glm::max(outMax, position);
+		}
+		glm::vec3 center = (outMin + outMax) * 0.5f;
+		float radiusSq = 0.f;
+		for (uint32_t i = 0; i < vertexCount; i++) {
+			glm::vec3 position;
+			memcpy(&position, vertexBytes + static_cast<size_t>(i) * vertexStride, sizeof(position));
+			glm::vec3 offset = position - center;
+			radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+		}
+		outSphere = glm::vec4(center, std::sqrt(radiusSq));
+	}
+
+	static int16_t PackSnorm16(float v) {
+		return static_cast<int16_t>(std::round(glm::clamp(v, -1.f, 1.f) * 32767.f));
+	}
+
+	static glm::vec2 SignNotZero(const glm::vec2& v) {
+		return glm::vec2(v.x >= 0.f ? 1.f : -1.f, v.y >= 0.f ? 1.f : -1.f);
+	}
+
+	glm::vec2 AdGeometryUtil::OctEncode(const glm::vec3& n) {
+		float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+		if (l1 <= 0.f) {
+			return glm::vec2(0.f);
+		}
+		glm::vec2 p = glm::vec2(n) / l1;
+		// 下半球折叠到外侧三角形
+		if (n.z < 0.f) {
+			p = (1.f - glm::abs(glm::vec2(p.y, p.x))) * SignNotZero(p);
+		}
+		return p;
+	}
+
+	glm::vec3 AdGeometryUtil::OctDecode(const glm::vec2& e) {
+		glm::vec3 n(e.x, e.y, 1.f - std::abs(e.x) - std::abs(e.y));
+		if (n.z < 0.f) {
+			glm::vec2 p = (1.f - glm::abs(glm::vec2(n.y, n.x))) * SignNotZero(glm::vec2(n));
+			n.x = p.x;
+			n.y = p.y;
+		}
+		return glm::normalize(n);
+	}
+
+	void AdGeometryUtil::PackVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoord,
+		const glm::vec3& tangent, const glm::vec3& bitangent, const glm::vec4& dequantize, AdPackedVertex& outVertex) {
+		glm::vec3 local = (position - glm::vec3(dequantize)) / dequantize.w;
+		outVertex.Position[0] = PackSnorm16(local.x);
+		outVertex.Position[1] = PackSnorm16(local.y);
+		outVertex.Position[2] = PackSnorm16(local.z);
+		// 副切线由 cross(N, T) * sign 重建，只保留手性
+		float handedness = glm::dot(glm::cross(normal, tangent), bitangent) < 0.f ? -1.f : 1.f;
+		outVertex.Position[3] = PackSnorm16(handedness);
+
+		glm::vec2 n = OctEncode(normal);
+		glm::vec2 t = OctEncode(tangent);
+		outVertex.Normal[0] = PackSnorm16(n.x);
+		outVertex.Normal[1] = PackSnorm16(n.y);
+		outVertex.Tangent[0] = PackSnorm16(t.x);
+		outVertex.Tangent[1] = PackSnorm16(t.y);
+
+		outVertex.TexCoord[0] = glm::packHalf1x16(texCoord.x);
+		outVertex.TexCoord[1] = glm::packHalf1x16(texCoord.y);
+	}
 }
\ No newline at end of file
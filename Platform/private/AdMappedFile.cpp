@@ -0,0 +1,93 @@
+#include "AdMappedFile.h"
+#include "Adlog.h"
+
+#ifdef AD_ENGINE_PLATFORM_WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace WuDu {
+	AdMappedFile::~AdMappedFile() {
+		Close();
+	}
+
+	/**
+	 * @brief 以只读方式映射整个文件
+	 *
+	 * @param filePath 文件路径
+	 * @return 映射成功返回 true；文件不存在、为空或映射失败返回 false
+	 */
+	bool AdMappedFile::Open(const std::string& filePath) {
+		Close();
+#ifdef AD_ENGINE_PLATFORM_WIN32
+		HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER fileSize;
+		if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+			CloseHandle(file);
+			return false;
+		}
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping) {
+			CloseHandle(file);
+			return false;
+		}
+		void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!data) {
+			CloseHandle(mapping);
+			CloseHandle(file);
+			return false;
+		}
+		mFileHandle = file;
+		mMappingHandle = mapping;
+		mData = static_cast<const uint8_t*>(data);
+		mSize = static_cast<size_t>(fileSize.QuadPart);
+#else
+		int fd = open(filePath.c_str(), O_RDONLY);
+		if (fd < 0) {
+			return false;
+		}
+		struct stat fileStat;
+		if (fstat(fd, &fileStat) != 0 || fileStat.st_size == 0) {
+			close(fd);
+			return false;
+		}
+		void* data = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+		// 映射建立后即可关闭文件描述符
+		close(fd);
+		if (data == MAP_FAILED) {
+			LOG_W("mmap failed: {0}", filePath);
+			return false;
+		}
+		mData = static_cast<const uint8_t*>(data);
+		mSize = static_cast<size_t>(fileStat.st_size);
+#endif
+		return true;
+	}
+
+	void AdMappedFile::Close() {
+		if (!mData) {
+			return;
+		}
+#ifdef AD_ENGINE_PLATFORM_WIN32
+		UnmapViewOfFile(mData);
+		CloseHandle(static_cast<HANDLE>(mMappingHandle));
+		CloseHandle(static_cast<HANDLE>(mFileHandle));
+		mMappingHandle = nullptr;
+		mFileHandle = nullptr;
+#else
+		munmap(const_cast<uint8_t*>(mData), mSize);
+#endif
+		mData = nullptr;
+		mSize = 0;
+	}
+}
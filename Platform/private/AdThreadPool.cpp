@@ -0,0 +1,54 @@
+#include "AdThreadPool.h"
+
+namespace WuDu {
+	AdThreadPool* AdThreadPool::GetInstance() {
+		// 保留一个硬件线程给主线程(渲染线程)
+		static AdThreadPool sThreadPool(std::max(2u, std::thread::hardware_concurrency()) - 1);
+		return &sThreadPool;
+	}
+
+	AdThreadPool::AdThreadPool(uint32_t workerCount) {
+		mWorkers.reserve(workerCount);
+		for (uint32_t i = 0; i < workerCount; i++) {
+			mWorkers.emplace_back(&AdThreadPool::WorkerLoop, this);
+		}
+	}
+
+	// 析构时先执行完队列中剩余的任务，再回收工作线程
+	AdThreadPool::~AdThreadPool() {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			bStop = true;
+		}
+		mCondition.notify_all();
+		for (auto& worker : mWorkers) {
+			if (worker.joinable()) {
+				worker.join();
+			}
+		}
+	}
+
+	void AdThreadPool::Enqueue(std::function<void()> job) {
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			mJobs.push(std::move(job));
+		}
+		mCondition.notify_one();
+	}
+
+	void AdThreadPool::WorkerLoop() {
+		while (true) {
+			std::function<void()> job;
+			{
+				std::unique_lock<std::mutex> lock(mMutex);
+				mCondition.wait(lock, [this]() { return bStop || !mJobs.empty(); });
+				if (mJobs.empty()) {
+					return;
+				}
+				job = std::move(mJobs.front());
+				mJobs.pop();
+			}
+			job();
+		}
+	}
+}
@@ -0,0 +1,192 @@
+#include "Graphic/AdVKBindlessTable.h"
+#include "Graphic/AdVKDevice.h"
+#include "Graphic/AdVKGraphicContext.h"
+#include "Graphic/AdVKDescriptorSet.h"
+
+namespace WuDu {
+	/**
+	 * @brief 构造无绑定资源表，创建 update-after-bind 的描述符集布局、描述符池和唯一的描述符集
+	 *
+	 * @param device 逻辑设备，需已启用 descriptor indexing 相关特性
+	 * @param framesInFlight 帧并行数量，决定释放的索引延迟多少帧后复用
+	 */
+	AdVKBindlessTable::AdVKBindlessTable(AdVKDevice* device, uint32_t framesInFlight) : mDevice(device), mFramesInFlight(framesInFlight) {
+		// 数组容量受设备 update-after-bind 描述符数量上限约束
+		VkPhysicalDeviceDescriptorIndexingProperties indexingProps = {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DESCRIPTOR_INDEXING_PROPERTIES
+		};
+		VkPhysicalDeviceProperties2 props2 = {
+			.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2,
+			.pNext = &indexingProps
+		};
+		vkGetPhysicalDeviceProperties2(device->GetContext()->GetPhyDevice(), &props2);
+		mTextureSlots.capacity = std::min<uint32_t>(AD_VK_BINDLESS_MAX_TEXTURES, indexingProps.maxDescriptorSetUpdateAfterBindSampledImages);
+		mSamplerSlots.capacity = std::min<uint32_t>(AD_VK_BINDLESS_MAX_SAMPLERS, indexingProps.maxDescriptorSetUpdateAfterBindSamplers);
+
+		const std::vector<VkDescriptorSetLayoutBinding> bindings = {
+			{
+				.binding = 0,
+				.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+				.descriptorCount = mTextureSlots.capacity,
+				.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+			},
+			{
+				.binding = 1,
+				.descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER,
+				.descriptorCount = mSamplerSlots.capacity,
+				.stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT
+			}
+		};
+		// 未写入的数组元素允许保持无效；已绑定的描述符集中未被在途帧使用的元素可以随时更新
+		const VkDescriptorBindingFlags bindingFlag = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT
+			| VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT
+			| VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+		mDescSetLayout = std::make_shared<AdVKDescriptorSetLayout>(device, bindings, std::vector<VkDescriptorBindingFlags>{ bindingFlag, bindingFlag });
+
+		std::vector<VkDescriptorPoolSize> poolSizes = {
+			{
+				.type = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE,
+				.descriptorCount = mTextureSlots.capacity
+			},
+			{
+				.type = VK_DESCRIPTOR_TYPE_SAMPLER,
+				.descriptorCount = mSamplerSlots.capacity
+			}
+		};
+		mDescPool = std::make_shared<AdVKDescriptorPool>(device, 1, poolSizes, VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT);
+		std::vector<VkDescriptorSet> descSets = mDescPool->AllocateDescriptorSet(mDescSetLayout.get(), 1);
+		if (!descSets.empty()) {
+			mDescSet = descSets[0];
+		}
+		LOG_D("Bindless table: {0} textures, {1} samplers", mTextureSlots.capacity, mSamplerSlots.capacity);
+	}
+
+	AdVKBindlessTable::~AdVKBindlessTable() {
+		mDescPool.reset();
+		mDescSetLayout.reset();
+	}
+
+	/**
+	 * @brief 注册一个纹理图像视图，返回其在纹理数组中的索引
+	 *
+	 * 图像在着色器访问时需处于 SHADER_READ_ONLY_OPTIMAL 布局，写入描述符本身不要求图像已就绪。
+	 *
+	 * @param imageView 图像视图
+	 * @return 纹理索引，数组已满时返回 AD_VK_BINDLESS_INVALID_INDEX
+	 */
+	uint32_t AdVKBindlessTable::RegisterTexture(VkImageView imageView) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		uint32_t index = mTextureSlots.Acquire();
+		if (index == AD_VK_BINDLESS_INVALID_INDEX) {
+			LOG_E("Bindless texture table is full: {0}", mTextureSlots.capacity);
+			return index;
+		}
+		VkDescriptorImageInfo imageInfo = {
+			.sampler = VK_NULL_HANDLE,
+			.imageView = imageView,
+			.imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL
+		};
+		WriteDescriptor(0, index, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, imageInfo);
+		return index;
+	}
+
+	void AdVKBindlessTable::ReleaseTexture(uint32_t index) {
+		if (index == AD_VK_BINDLESS_INVALID_INDEX) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mMutex);
+		mTextureSlots.Release(index, mFrameCounter);
+	}
+
+	/**
+	 * @brief 注册一个采样器，返回其在采样器数组中的索引
+	 *
+	 * @param sampler 采样器句柄
+	 * @return 采样器索引，数组已满时返回 AD_VK_BINDLESS_INVALID_INDEX
+	 */
+	uint32_t AdVKBindlessTable::RegisterSampler(VkSampler sampler) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		uint32_t index = mSamplerSlots.Acquire();
+		if (index == AD_VK_BINDLESS_INVALID_INDEX) {
+			LOG_E("Bindless sampler table is full: {0}", mSamplerSlots.capacity);
+			return index;
+		}
+		VkDescriptorImageInfo imageInfo = {
+			.sampler = sampler,
+			.imageView = VK_NULL_HANDLE,
+			.imageLayout = VK_IMAGE_LAYOUT_UNDEFINED
+		};
+		WriteDescriptor(1, index, VK_DESCRIPTOR_TYPE_SAMPLER, imageInfo);
+		return index;
+	}
+
+	void AdVKBindlessTable::ReleaseSampler(uint32_t index) {
+		if (index == AD_VK_BINDLESS_INVALID_INDEX) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mMutex);
+		mSamplerSlots.Release(index, mFrameCounter);
+	}
+
+	/**
+	 * @brief 推进帧号，释放超过 framesInFlight 帧的索引回到空闲列表
+	 *
+	 * 在帧围栏等待之后调用：此时释放于 framesInFlight 帧之前的索引已不可能被任何在途命令缓冲引用。
+	 */
+	void AdVKBindlessTable::Update() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		mFrameCounter++;
+		if (mFrameCounter > mFramesInFlight) {
+			uint64_t completedFrame = mFrameCounter - mFramesInFlight;
+			mTextureSlots.Retire(completedFrame);
+			mSamplerSlots.Retire(completedFrame);
+		}
+	}
+
+	uint32_t AdVKBindlessTable::GetTextureCount() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mTextureSlots.GetUsedCount();
+	}
+
+	uint32_t AdVKBindlessTable::GetSamplerCount() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return mSamplerSlots.GetUsedCount();
+	}
+
+	void AdVKBindlessTable::WriteDescriptor(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo& imageInfo) {
+		VkWriteDescriptorSet write = {
+			.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+			.pNext = nullptr,
+			.dstSet = mDescSet,
+			.dstBinding = binding,
+			.dstArrayElement = index,
+			.descriptorCount = 1,
+			.descriptorType = type,
+			.pImageInfo = &imageInfo
+		};
+		DescriptorSetWriter::UpdateDescriptorSets(mDevice->GetHandle(), { write });
+	}
+
+	uint32_t AdVKBindlessTable::SlotList::Acquire() {
+		if (!freeIndices.empty()) {
+			uint32_t index = freeIndices.back();
+			freeIndices.pop_back();
+			return index;
+		}
+		if (nextIndex >= capacity) {
+			return AD_VK_BINDLESS_INVALID_INDEX;
+		}
+		return nextIndex++;
+	}
+
+	void AdVKBindlessTable::SlotList::Release(uint32_t index, uint64_t frame) {
+		pendingIndices.emplace_back(index, frame);
+	}
+
+	void AdVKBindlessTable::SlotList::Retire(uint64_t completedFrame) {
+		while (!pendingIndices.empty() && pendingIndices.front().second <= completedFrame) {
+			freeIndices.push_back(pendingIndices.front().first);
+			pendingIndices.pop_front();
+		}
+	}
+}
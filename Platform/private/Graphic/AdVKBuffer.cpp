@@ -2,6 +2,7 @@
 #include "Graphic/AdVKDevice.h"
 #include "Graphic/AdVKQueue.h"
 #include "Graphic/AdVKCommandBuffer.h"
+#include "Graphic/AdVKUploadContext.h"
 
 namespace WuDu {
 	AdVKBuffer::AdVKBuffer(AdVKDevice* device, VkBufferUsageFlags usage, size_t size, void* data, bool bHostVisible)
@@ -10,36 +11,28 @@ namespace WuDu {
 	}
 
 	AdVKBuffer::~AdVKBuffer() {
+		// 上传尚未完成时不能释放目标缓冲区
+		WaitReady();
 		VK_D(Buffer, mDevice->GetHandle(), mHandle);
-		VK_F(mDevice->GetHandle(), mMemory);
+		mDevice->GetMemoryAllocator()->Free(mAllocation);
 	}
 
 	void AdVKBuffer::CreateBuffer(VkBufferUsageFlags usage, void* data) {
 		if (bHostVisible) {
-			CreateBufferInternal(mDevice, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, usage, mSize, &mHandle, &mMemory);
+			CreateBufferInternal(mDevice, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT, usage, mSize, &mHandle, &mAllocation);
 			WriteData(data);
 		}
 		else {
-			VkBuffer stageBuffer;
-			VkDeviceMemory stageMemory;
-			CreateBufferInternal(mDevice, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-				VK_BUFFER_USAGE_TRANSFER_SRC_BIT, mSize, &stageBuffer, &stageMemory);
+			CreateBufferInternal(mDevice, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, mSize, &mHandle, &mAllocation);
 
-			void* mapping;
-			CALL_VK(vkMapMemory(mDevice->GetHandle(), stageMemory, 0, VK_WHOLE_SIZE, 0, &mapping));
-			memcpy(mapping, data, mSize);
-			vkUnmapMemory(mDevice->GetHandle(), stageMemory);
-			CreateBufferInternal(mDevice, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, usage | VK_BUFFER_USAGE_TRANSFER_DST_BIT, mSize, &mHandle, &mMemory);
-
-			// copy
-			CopyToBuffer(mDevice, stageBuffer, mHandle, mSize);
-
-			VK_D(Buffer, mDevice->GetHandle(), stageBuffer);
-			VK_F(mDevice->GetHandle(), stageMemory);
+			// 初始数据进入上传批次，与其它资源的上传合并提交，不再逐个阻塞等待
+			if (data) {
+				mUploadTicket = mDevice->GetUploadContext()->UploadBuffer(mHandle, data, mSize);
+			}
 		}
 	}
 
-	void AdVKBuffer::CreateBufferInternal(AdVKDevice* device, VkMemoryPropertyFlags memProps, VkBufferUsageFlags usage, size_t size, VkBuffer* outBuffer, VkDeviceMemory* outMemory) {
+	void AdVKBuffer::CreateBufferInternal(AdVKDevice* device, VkMemoryPropertyFlags memProps, VkBufferUsageFlags usage, size_t size, VkBuffer* outBuffer, AdVKAllocation* outAllocation) {
 		VkBufferCreateInfo bufferInfo = {
 			.sType = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
 			.pNext = nullptr,
@@ -50,19 +43,24 @@ namespace WuDu {
 			.queueFamilyIndexCount = 0,
 			.pQueueFamilyIndices = nullptr,
 		};
+		// 作为上传目标的缓冲区需要在图形队列与传输队列之间共享
+		const std::vector<uint32_t>& queueFamilyIndices = device->GetUploadQueueFamilyIndices();
+		if ((usage & VK_BUFFER_USAGE_TRANSFER_DST_BIT) && queueFamilyIndices.size() > 1) {
+			bufferInfo.sharingMode = VK_SHARING_MODE_CONCURRENT;
+			bufferInfo.queueFamilyIndexCount = static_cast<uint32_t>(queueFamilyIndices.size());
+			bufferInfo.pQueueFamilyIndices = queueFamilyIndices.data();
+		}
 		CALL_VK(vkCreateBuffer(device->GetHandle(), &bufferInfo, nullptr, outBuffer));
-		// allocate memory
+		// allocate memory from the engine allocator
 		VkMemoryRequirements memReqs;
 		vkGetBufferMemoryRequirements(device->GetHandle(), *outBuffer, &memReqs);
 
-		VkMemoryAllocateInfo allocateInfo = {
-			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-			.pNext = nullptr,
-			.allocationSize = memReqs.size,
-			.memoryTypeIndex = static_cast<uint32_t>(device->GetMemoryIndex(memProps, memReqs.memoryTypeBits))
-		};
-		CALL_VK(vkAllocateMemory(device->GetHandle(), &allocateInfo, nullptr, outMemory));
-		CALL_VK(vkBindBufferMemory(device->GetHandle(), *outBuffer, *outMemory, 0));
+		AdVKMemoryAllocator* allocator = device->GetMemoryAllocator();
+		if (!allocator->Allocate(memReqs, memProps, AD_VK_ALLOCATION_LINEAR, outAllocation)) {
+			LOG_E("Failed to allocate {0} bytes for buffer", memReqs.size);
+			return;
+		}
+		CALL_VK(allocator->BindBuffer(*outBuffer, *outAllocation));
 	}
 
 	void AdVKBuffer::CopyToBuffer(AdVKDevice* device, VkBuffer srcBuffer, VkBuffer dstBuffer, size_t size) {
@@ -77,18 +75,22 @@ namespace WuDu {
 	}
 
 	VkResult AdVKBuffer::WriteData(void* data) {
-		size_t size = 0;
-		if (!data || !bHostVisible) {
+		if (!data || !bHostVisible || !mAllocation.mappedData) {
 			return VK_ERROR_INITIALIZATION_FAILED;
 		}
-		size_t copySize = (size > 0) ? min(size, mSize) : mSize;
 
-		void* mapping;
-		VkResult ret = vkMapMemory(mDevice->GetHandle(), mMemory, 0, copySize, 0, &mapping);
-		if (ret == VK_SUCCESS) {
-			memcpy(mapping, data, copySize);
-			vkUnmapMemory(mDevice->GetHandle(), mMemory);
+		// 主机可见内存由分配器持久映射（HOST_COHERENT），无需 map/unmap
+		memcpy(mAllocation.mappedData, data, mSize);
+		return VK_SUCCESS;
+	}
+
+	bool AdVKBuffer::IsReady() const {
+		return mUploadTicket == 0 || mDevice->GetUploadContext()->IsComplete(mUploadTicket);
+	}
+
+	void AdVKBuffer::WaitReady() const {
+		if (!IsReady()) {
+			mDevice->GetUploadContext()->Wait(mUploadTicket);
 		}
-		return ret;
 	}
-}
\ No newline at end of file
+}
@@ -0,0 +1,63 @@
+#include "Graphic/AdVKComputePipeline.h"
+#include "AdFileUtil.h"
+#include "Graphic/AdVKDevice.h"
+
+namespace WuDu {
+	AdVKComputePipeline::AdVKComputePipeline(AdVKDevice* device, const std::string& computeShaderFile, const ShaderLayout& shaderLayout) : mDevice(device) {
+		// 创建计算着色器模块
+		std::vector<char> content = ReadCharArrayFromFile(computeShaderFile + ".spv");
+		VkShaderModuleCreateInfo shaderModuleInfo = {
+			.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.codeSize = static_cast<uint32_t>(content.size()),
+			.pCode = reinterpret_cast<const uint32_t*>(content.data())
+		};
+		CALL_VK(vkCreateShaderModule(mDevice->GetHandle(), &shaderModuleInfo, nullptr, &mShaderModule));
+
+		// 创建管线布局
+		VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
+			.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.setLayoutCount = static_cast<uint32_t>(shaderLayout.descriptorSetLayouts.size()),
+			.pSetLayouts = shaderLayout.descriptorSetLayouts.data(),
+			.pushConstantRangeCount = static_cast<uint32_t>(shaderLayout.pushConstants.size()),
+			.pPushConstantRanges = shaderLayout.pushConstants.data()
+		};
+		CALL_VK(vkCreatePipelineLayout(mDevice->GetHandle(), &pipelineLayoutInfo, nullptr, &mLayout));
+
+		// 创建计算管线
+		VkComputePipelineCreateInfo pipelineInfo = {
+			.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+			.pNext = nullptr,
+			.flags = 0,
+			.stage = {
+				.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0,
+				.stage = VK_SHADER_STAGE_COMPUTE_BIT,
+				.module = mShaderModule,
+				.pName = "main",
+				.pSpecializationInfo = nullptr
+			},
+			.layout = mLayout,
+			.basePipelineHandle = VK_NULL_HANDLE,
+			.basePipelineIndex = 0
+		};
+		auto startTime = std::chrono::steady_clock::now();
+		CALL_VK(vkCreateComputePipelines(mDevice->GetHandle(), mDevice->GetPipelineCache(), 1, &pipelineInfo, nullptr, &mHandle));
+		uint64_t createTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		mDevice->AddPipelineCreateTime(createTimeUs);
+	}
+
+	AdVKComputePipeline::~AdVKComputePipeline() {
+		VK_D(Pipeline, mDevice->GetHandle(), mHandle);
+		VK_D(PipelineLayout, mDevice->GetHandle(), mLayout);
+		VK_D(ShaderModule, mDevice->GetHandle(), mShaderModule);
+	}
+
+	void AdVKComputePipeline::Bind(VkCommandBuffer cmdBuffer) const {
+		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, mHandle);
+	}
+}
@@ -7,13 +7,28 @@ namespace WuDu {
 	 * @brief 构造函数，用于创建 Vulkan 描述符集布局对象
 	 * @param device 指向 Vulkan 设备对象的指针，用于获取逻辑设备句柄
 	 * @param bindings 描述符集布局绑定信息的数组，定义了每个绑定的描述符类型、数量和阶段等
+	 * @param bindingFlags 每个绑定的描述符索引标志(descriptor indexing)，为空时不使用；
+	 *                     含 UPDATE_AFTER_BIND 时布局自动带上 UPDATE_AFTER_BIND_POOL 标志
 	 */
-	AdVKDescriptorSetLayout::AdVKDescriptorSetLayout(AdVKDevice* device, const std::vector<VkDescriptorSetLayoutBinding>& bindings) : mDevice(device) {
+	AdVKDescriptorSetLayout::AdVKDescriptorSetLayout(AdVKDevice* device, const std::vector<VkDescriptorSetLayoutBinding>& bindings, const std::vector<VkDescriptorBindingFlags>& bindingFlags) : mDevice(device) {
+		VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo = {
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO,
+			.pNext = nullptr,
+			.bindingCount = static_cast<uint32_t>(bindingFlags.size()),
+			.pBindingFlags = bindingFlags.data()
+		};
+		VkDescriptorSetLayoutCreateFlags layoutFlags = 0;
+		for (VkDescriptorBindingFlags flags : bindingFlags) {
+			if (flags & VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT) {
+				layoutFlags |= VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+			}
+		}
+
 		// 填充描述符集布局创建信息结构体
 		VkDescriptorSetLayoutCreateInfo descriptorSetLayoutInfo = {
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO,
-			.pNext = nullptr,
-			.flags = 0,
+			.pNext = bindingFlags.empty() ? nullptr : &bindingFlagsInfo,
+			.flags = layoutFlags,
 			.bindingCount = static_cast<uint32_t>(bindings.size()),
 			.pBindings = bindings.data()
 		};
@@ -25,6 +40,10 @@ namespace WuDu {
 	 * @brief 析构函数，用于销毁 Vulkan 描述符集布局对象
 	 */
 	AdVKDescriptorSetLayout::~AdVKDescriptorSetLayout() {
+		// 布局句柄销毁后可能被新布局复用，先清掉分配器中以该句柄登记的空闲描述符集
+		if (AdVKDescriptorAllocator* descAllocator = mDevice->GetDescriptorAllocator()) {
+			descAllocator->ReleaseLayout(mHandle);
+		}
 		// 使用宏 VK_D 销毁描述符集布局对象
 		VK_D(DescriptorSetLayout, mDevice->GetHandle(), mHandle);
 	}
@@ -34,13 +53,14 @@ namespace WuDu {
 	 * @param device 指向 Vulkan 设备对象的指针，用于获取逻辑设备句柄
 	 * @param maxSets 描述符池可以分配的最大描述符集数量
 	 * @param poolSizes 描述符池中每种类型描述符的数量配置
+	 * @param flags 额外的描述符池创建标志（如 UPDATE_AFTER_BIND）
 	 */
-	AdVKDescriptorPool::AdVKDescriptorPool(AdVKDevice* device, uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes) : mDevice(device) {
+	AdVKDescriptorPool::AdVKDescriptorPool(AdVKDevice* device, uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorPoolCreateFlags flags) : mDevice(device) {
 		// 填充描述符池创建信息结构体
 		VkDescriptorPoolCreateInfo descriptorPoolInfo = {
 			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO,
 			.pNext = nullptr,
-			.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT,
+			.flags = VK_DESCRIPTOR_POOL_CREATE_FREE_DESCRIPTOR_SET_BIT | flags,
 			.maxSets = maxSets,
 			.poolSizeCount = static_cast<uint32_t>(poolSizes.size()),
 			.pPoolSizes = poolSizes.data()
@@ -88,4 +108,153 @@ namespace WuDu {
 		}
 		return descriptorSets;
 	}
+
+	/**
+	 * @brief 构造可增长的描述符集分配器，立即创建第一个描述符池
+	 * @param device 指向 Vulkan 设备对象的指针
+	 * @param ratios 每个描述符集平均需要的各类描述符数量
+	 * @param initSetCount 第一个描述符池可分配的描述符集数量
+	 */
+	AdVKDescriptorAllocator::AdVKDescriptorAllocator(AdVKDevice* device, const std::vector<PoolSizeRatio>& ratios, uint32_t initSetCount)
+		: mDevice(device), mRatios(ratios), mNextSetCount(initSetCount) {
+		CreatePool();
+	}
+
+	/**
+	 * @brief 析构函数，销毁所有描述符池，从中分配的描述符集随之释放
+	 */
+	AdVKDescriptorAllocator::~AdVKDescriptorAllocator() {
+		mFreeSets.clear();
+		mSetPools.clear();
+		mPools.clear();
+	}
+
+	/**
+	 * @brief 分配一个描述符集：优先复用同布局的空闲描述符集，当前池耗尽时链接一个新池
+	 * @param setLayout 描述符集布局对象指针
+	 * @return 分配的描述符集句柄，失败时返回 VK_NULL_HANDLE
+	 */
+	VkDescriptorSet AdVKDescriptorAllocator::Allocate(AdVKDescriptorSetLayout* setLayout) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		VkDescriptorSetLayout layoutHandle = setLayout->GetHandle();
+
+		auto freeIt = mFreeSets.find(layoutHandle);
+		if (freeIt != mFreeSets.end() && !freeIt->second.empty()) {
+			VkDescriptorSet descSet = freeIt->second.back();
+			freeIt->second.pop_back();
+			return descSet;
+		}
+
+		VkDescriptorSet descSet = VK_NULL_HANDLE;
+		VkResult ret = AllocateFromPool(mPools.back()->GetHandle(), layoutHandle, &descSet);
+		if (ret == VK_ERROR_OUT_OF_POOL_MEMORY || ret == VK_ERROR_FRAGMENTED_POOL) {
+			CreatePool();
+			ret = AllocateFromPool(mPools.back()->GetHandle(), layoutHandle, &descSet);
+		}
+		if (ret != VK_SUCCESS) {
+			LOG_E("{0}: failed to allocate descriptor set, result: {1}", __FUNCTION__, vk_result_string(ret));
+			return VK_NULL_HANDLE;
+		}
+		mSetPools[descSet] = mPools.back()->GetHandle();
+		mAllocatedSetCount++;
+		return descSet;
+	}
+
+	/**
+	 * @brief 分配多个相同布局的描述符集
+	 * @param setLayout 描述符集布局对象指针
+	 * @param count 要分配的描述符集数量
+	 * @return 成功时返回包含 count 个描述符集的向量，失败时返回空向量
+	 */
+	std::vector<VkDescriptorSet> AdVKDescriptorAllocator::Allocate(AdVKDescriptorSetLayout* setLayout, uint32_t count) {
+		std::vector<VkDescriptorSet> descSets;
+		descSets.reserve(count);
+		for (uint32_t i = 0; i < count; i++) {
+			VkDescriptorSet descSet = Allocate(setLayout);
+			if (descSet == VK_NULL_HANDLE) {
+				Free(setLayout, descSets);
+				return {};
+			}
+			descSets.push_back(descSet);
+		}
+		return descSets;
+	}
+
+	/**
+	 * @brief 将描述符集放回对应布局的空闲列表，供之后的分配复用
+	 * @param setLayout 描述符集布局对象指针
+	 * @param descSets 要回收的描述符集
+	 */
+	void AdVKDescriptorAllocator::Free(AdVKDescriptorSetLayout* setLayout, const std::vector<VkDescriptorSet>& descSets) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		std::vector<VkDescriptorSet>& freeSets = mFreeSets[setLayout->GetHandle()];
+		for (VkDescriptorSet descSet : descSets) {
+			if (descSet != VK_NULL_HANDLE) {
+				freeSets.push_back(descSet);
+			}
+		}
+	}
+
+	/**
+	 * @brief 将布局的空闲描述符集归还给各自的池并移除该布局的空闲列表
+	 *
+	 * 布局销毁后句柄值可能被新布局复用，若保留空闲列表，之后的分配会拿到按旧布局创建的描述符集。
+	 * 池均带有 FREE_DESCRIPTOR_SET 标志，可以单独释放描述符集。
+	 * @param setLayout 即将销毁的描述符集布局句柄
+	 */
+	void AdVKDescriptorAllocator::ReleaseLayout(VkDescriptorSetLayout setLayout) {
+		std::lock_guard<std::mutex> lock(mMutex);
+		auto freeIt = mFreeSets.find(setLayout);
+		if (freeIt == mFreeSets.end()) {
+			return;
+		}
+		std::unordered_map<VkDescriptorPool, std::vector<VkDescriptorSet>> poolSets;
+		for (VkDescriptorSet descSet : freeIt->second) {
+			auto poolIt = mSetPools.find(descSet);
+			if (poolIt != mSetPools.end()) {
+				poolSets[poolIt->second].push_back(descSet);
+				mSetPools.erase(poolIt);
+			}
+		}
+		mFreeSets.erase(freeIt);
+		for (const auto& [pool, descSets] : poolSets) {
+			CALL_VK(vkFreeDescriptorSets(mDevice->GetHandle(), pool, static_cast<uint32_t>(descSets.size()), descSets.data()));
+			mAllocatedSetCount -= descSets.size();
+		}
+	}
+
+	uint32_t AdVKDescriptorAllocator::GetPoolCount() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return static_cast<uint32_t>(mPools.size());
+	}
+
+	/**
+	 * @brief 按比例创建一个新的描述符池并追加到池链末尾，下一个池的容量倍增
+	 */
+	void AdVKDescriptorAllocator::CreatePool() {
+		uint32_t setCount = mNextSetCount;
+		std::vector<VkDescriptorPoolSize> poolSizes;
+		poolSizes.reserve(mRatios.size());
+		for (const auto& ratio : mRatios) {
+			poolSizes.push_back({
+				.type = ratio.type,
+				.descriptorCount = std::max(1u, static_cast<uint32_t>(ratio.ratio * setCount))
+			});
+		}
+		mPools.push_back(std::make_shared<AdVKDescriptorPool>(mDevice, setCount, poolSizes));
+		mNextSetCount = std::min(setCount * 2, static_cast<uint32_t>(AD_VK_DESCRIPTOR_POOL_MAX_SETS));
+		LOG_D("{0}: pool {1}, {2} sets", __FUNCTION__, mPools.size(), setCount);
+	}
+
+	// 池耗尽属于正常情况，这里不使用 CALL_VK，由调用者决定是否链接新池
+	VkResult AdVKDescriptorAllocator::AllocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout setLayout, VkDescriptorSet* outSet) {
+		VkDescriptorSetAllocateInfo allocateInfo = {
+			.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.descriptorPool = pool,
+			.descriptorSetCount = 1,
+			.pSetLayouts = &setLayout
+		};
+		return vkAllocateDescriptorSets(mDevice->GetHandle(), &allocateInfo, outSet);
+	}
 }
\ No newline at end of file
@@ -1,7 +1,15 @@
 #include "Graphic/AdVKDevice.h"
+#include "AdFileUtil.h"
 #include "Graphic/AdVKGraphicContext.h"
 #include "Graphic/AdVKQueue.h"
 #include "Graphic/AdVKCommandBuffer.h"
+#include "Graphic/AdVKMemoryAllocator.h"
+#include "Graphic/AdVKUploadContext.h"
+#include "Graphic/AdVKPipeline.h"
+#include "Graphic/AdVKDescriptorSet.h"
+#include "Graphic/AdVKBindlessTable.h"
+
+#define AD_VK_PIPELINE_CACHE_FILE       AD_RES_CONFIG_DIR"PipelineCache.bin"
 
 namespace WuDu {
 	const DeviceFeature requestedExtensions[] = {
@@ -56,7 +64,7 @@ namespace WuDu {
 		}
 
 		// 准备队列创建信息
-		VkDeviceQueueCreateInfo queueInfos[2] = {
+		VkDeviceQueueCreateInfo queueInfos[3] = {
 		    {
 			//VkStructureType             sType;
 			// const void* pNext;
@@ -85,6 +93,23 @@ namespace WuDu {
 			};
 		}
 
+		// 如果存在独立的传输队列族，额外创建一个传输队列用于异步上传
+		uint32_t queueInfoCount = bSameQueueFamilyIndex ? 1 : 2;
+		QueueFamilyInfo transferQueueFamilyInfo = context->GetTransferQueueFamilyInfo();
+		bool bUseTransferQueue = context->HasDedicatedTransferQueueFamily()
+			&& transferQueueFamilyInfo.queueFamilyIndex != presentQueueFamilyInfo.queueFamilyIndex;
+		float transferQueuePriority = 0.f;
+		if (bUseTransferQueue) {
+			queueInfos[queueInfoCount++] = {
+			    VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO,
+			    nullptr,
+			    0,
+			    static_cast<uint32_t>(transferQueueFamilyInfo.queueFamilyIndex),
+			    1,
+			    &transferQueuePriority
+			};
+		}
+
 		// 枚举设备扩展属性
 		uint32_t availableExtensionCount;
 		CALL_VK(vkEnumerateDeviceExtensionProperties(context->GetPhyDevice(), "", &availableExtensionCount, nullptr));
@@ -107,12 +132,61 @@ namespace WuDu {
 		dynamicRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES;
 		dynamicRenderingFeatures.dynamicRendering = VK_TRUE; // 关键：启用特性
 
-		// 准备设备创建信息
+		// 查询设备特性：Vulkan 1.2 特性只在设备支持 1.2 时才能挂入查询链
+		VkPhysicalDeviceProperties phyDeviceProps;
+		vkGetPhysicalDeviceProperties(context->GetPhyDevice(), &phyDeviceProps);
+		bool bVulkan12 = phyDeviceProps.apiVersion >= VK_API_VERSION_1_2;
+		VkPhysicalDeviceVulkan12Features supported12Features = {};
+		supported12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		VkPhysicalDeviceFeatures2 supportedFeatures = {};
+		supportedFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		supportedFeatures.pNext = bVulkan12 ? &supported12Features : nullptr;
+		vkGetPhysicalDeviceFeatures2(context->GetPhyDevice(), &supportedFeatures);
+
+		// 无绑定资源表依赖 descriptor indexing（Vulkan 1.2 核心），全部支持时才启用
+		// 片段着色器以材质SSBO中读出的索引访问 textures[]/samplers[]，需要数组的动态索引与非一致索引
+		bool bBindlessSupported = bVulkan12
+			&& supportedFeatures.features.shaderSampledImageArrayDynamicIndexing
+			&& supported12Features.shaderSampledImageArrayNonUniformIndexing
+			&& supported12Features.runtimeDescriptorArray
+			&& supported12Features.descriptorBindingPartiallyBound
+			&& supported12Features.descriptorBindingSampledImageUpdateAfterBind
+			&& supported12Features.descriptorBindingUpdateUnusedWhilePending;
+		// GPU 驱动的间接绘制：一次调用提交多条命令并以 firstInstance 索引实例数据；drawIndirectCount 可选
+		bMultiDrawIndirect = supportedFeatures.features.multiDrawIndirect && supportedFeatures.features.drawIndirectFirstInstance;
+		bDrawIndirectCount = bMultiDrawIndirect && bVulkan12 && supported12Features.drawIndirectCount;
+
+		VkPhysicalDeviceVulkan12Features enabled12Features = {};
+		enabled12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+		// 无绑定表中只有采样图像与采样器使用 update-after-bind，存储缓冲不在其中，无需 descriptorBindingStorageBufferUpdateAfterBind
+		if (bBindlessSupported) {
+			enabled12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+			enabled12Features.runtimeDescriptorArray = VK_TRUE;
+			enabled12Features.descriptorBindingPartiallyBound = VK_TRUE;
+			enabled12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+			enabled12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+		}
+		enabled12Features.drawIndirectCount = bDrawIndirectCount ? VK_TRUE : VK_FALSE;
+		if (bVulkan12) {
+			dynamicRenderingFeatures.pNext = &enabled12Features;
+		}
+
+		VkPhysicalDeviceFeatures2 enabledFeatures = {};
+		enabledFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+		enabledFeatures.pNext = &dynamicRenderingFeatures;
+		enabledFeatures.features.multiDrawIndirect = bMultiDrawIndirect ? VK_TRUE : VK_FALSE;
+		enabledFeatures.features.drawIndirectFirstInstance = bMultiDrawIndirect ? VK_TRUE : VK_FALSE;
+		enabledFeatures.features.shaderSampledImageArrayDynamicIndexing = bBindlessSupported ? VK_TRUE : VK_FALSE;
+		LOG_D("Bindless (descriptor indexing): {0}", bBindlessSupported ? "enabled" : "not supported");
+		LOG_D("Multi draw indirect: {0}, draw indirect count: {1}", bMultiDrawIndirect ? "enabled" : "not supported",
+			bDrawIndirectCount ? "enabled" : "not supported");
+
+		// 准备设备创建信息（核心特性通过 pNext 链中的 VkPhysicalDeviceFeatures2 启用）
 		VkDeviceCreateInfo deviceInfo = {
 		    deviceInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-		    deviceInfo.pNext = &dynamicRenderingFeatures,
+		    deviceInfo.pNext = &enabledFeatures,
 		    deviceInfo.flags = 0,
-		    deviceInfo.queueCreateInfoCount = static_cast<uint32_t>(bSameQueueFamilyIndex ? 1 : 2),
+		    deviceInfo.queueCreateInfoCount = queueInfoCount,
 		    deviceInfo.pQueueCreateInfos = queueInfos,
 		    deviceInfo.enabledLayerCount = 0,
 		    deviceInfo.ppEnabledLayerNames = nullptr,
@@ -132,42 +206,162 @@ namespace WuDu {
 			mGraphicQueues.push_back(std::make_shared<AdVKQueue>(graphicQueueFamilyInfo.queueFamilyIndex, i, queue, false));
 		}
 
-		// 获取并保存显示队列
+		// 获取并保存显示队列；与图形队列是同一个 VkQueue 时共用同一对象，保证只有一把提交锁
 		for (int i = 0; i < presentQueueCount; i++) {
+			if (presentQueueFamilyInfo.queueFamilyIndex == graphicQueueFamilyInfo.queueFamilyIndex && i < graphicQueueCount) {
+				mPresentQueues.push_back(mGraphicQueues[i]);
+				continue;
+			}
 			VkQueue queue;
 			vkGetDeviceQueue(mHandle, presentQueueFamilyInfo.queueFamilyIndex, i, &queue);
 			mPresentQueues.push_back(std::make_shared<AdVKQueue>(presentQueueFamilyInfo.queueFamilyIndex, i, queue, true));
 		}
 
+		// 获取并保存传输队列
+		mUploadQueueFamilyIndices = { static_cast<uint32_t>(graphicQueueFamilyInfo.queueFamilyIndex) };
+		if (bUseTransferQueue) {
+			VkQueue queue;
+			vkGetDeviceQueue(mHandle, transferQueueFamilyInfo.queueFamilyIndex, 0, &queue);
+			mTransferQueue = std::make_shared<AdVKQueue>(transferQueueFamilyInfo.queueFamilyIndex, 0, queue, false);
+			mUploadQueueFamilyIndices.push_back(transferQueueFamilyInfo.queueFamilyIndex);
+		}
+
+		// 创建内存分配器，所有缓冲区和图像从大块内存中子分配
+		mMemoryAllocator = std::make_shared<AdVKMemoryAllocator>(this);
+
 		// 创建管道缓存
 		CreatePipelineCache();
+		mPipelineRegistry = std::make_shared<AdVKPipelineRegistry>(this);
 
 		// 创建默认命令池
 		CreateDefaultCmdPool();
+
+		// 创建批量上传上下文
+		mUploadContext = std::make_shared<AdVKUploadContext>(this, GetTransferQueue(), GetTransferQueueFamilyIndex());
+
+		// 创建共享的描述符集分配器，比例按材质系统的典型布局估算（每个材质集最多5张纹理）
+		mDescriptorAllocator = std::make_shared<AdVKDescriptorAllocator>(this, std::vector<AdVKDescriptorAllocator::PoolSizeRatio>{
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, 1.f },
+			{ VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, 1.f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, 1.f },
+			{ VK_DESCRIPTOR_TYPE_STORAGE_BUFFER_DYNAMIC, 0.5f },
+			{ VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER, 4.f }
+		});
+
+		if (bBindlessSupported) {
+			mBindlessTable = std::make_shared<AdVKBindlessTable>(this, mSettings.framesInFlight);
+		}
 	}
 
 	// AdVKDevice类的析构函数
 	AdVKDevice::~AdVKDevice() {
 		// 等待设备空闲，确保所有命令完成执行
-		vkDeviceWaitIdle(mHandle);
+		WaitIdle();
+		// 释放描述符集分配器（从中分配的描述符集随池一起释放）
+		mDescriptorAllocator = nullptr;
+		mBindlessTable = nullptr;
+		// 释放上传上下文（其暂存缓冲区来自内存分配器，需先于分配器释放）
+		mUploadContext = nullptr;
 		// 释放默认命令池
 		mDefaultCmdPool = nullptr;
-		// 销毁管道缓存
+		// 释放内存分配器持有的内存块
+		mMemoryAllocator = nullptr;
+		// 释放管线注册表（此时所有管线应已由使用者释放）
+		mPipelineRegistry = nullptr;
+		// 保存并销毁管道缓存
+		SavePipelineCache();
+		LOG_D("Pipeline cache ({0}): {1} pipelines created in {2} ms", bPipelineCacheWarm ? "warm" : "cold", GetPipelineCreateCount(), GetPipelineCreateTimeMs());
 		VK_D(PipelineCache, mHandle, mPipelineCache);
 		// 销毁设备
 		vkDestroyDevice(mHandle, nullptr);
 	}
 
-	// 创建管道缓存
+	// 创建管道缓存：优先从磁盘加载上一次运行保存的数据，头部与当前设备不匹配时退回到空缓存
 	void AdVKDevice::CreatePipelineCache() {
+		std::vector<char> cacheData;
+		std::ifstream file(AD_VK_PIPELINE_CACHE_FILE, std::ios::ate | std::ios::binary);
+		if (file.is_open()) {
+			cacheData.resize(static_cast<size_t>(file.tellg()));
+			file.seekg(0);
+			file.read(cacheData.data(), cacheData.size());
+			file.close();
+		}
+
+		// 校验缓存头：版本、厂商ID、设备ID以及驱动的 pipelineCacheUUID
+		bool bValid = false;
+		if (cacheData.size() >= sizeof(VkPipelineCacheHeaderVersionOne)) {
+			VkPipelineCacheHeaderVersionOne header;
+			memcpy(&header, cacheData.data(), sizeof(header));
+
+			VkPhysicalDeviceProperties props;
+			vkGetPhysicalDeviceProperties(mContext->GetPhyDevice(), &props);
+			bValid = header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne)
+				&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+				&& header.vendorID == props.vendorID
+				&& header.deviceID == props.deviceID
+				&& memcmp(header.pipelineCacheUUID, props.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+			if (!bValid) {
+				LOG_W("Pipeline cache {0} was created by another device or driver, ignore it.", AD_VK_PIPELINE_CACHE_FILE);
+			}
+		}
+
 		// 初始化管道缓存创建信息
 		VkPipelineCacheCreateInfo pipelineCacheInfo = {
 			pipelineCacheInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
 			pipelineCacheInfo.pNext = nullptr,
-			pipelineCacheInfo.flags = 0
+			pipelineCacheInfo.flags = 0,
+			pipelineCacheInfo.initialDataSize = bValid ? cacheData.size() : 0,
+			pipelineCacheInfo.pInitialData = bValid ? cacheData.data() : nullptr
 		};
-		// 调用vkCreatePipelineCache创建管道缓存
-		CALL_VK(vkCreatePipelineCache(mHandle, &pipelineCacheInfo, nullptr, &mPipelineCache));
+		// 调用vkCreatePipelineCache创建管道缓存，驱动仍拒绝数据时使用空缓存
+		VkResult ret = vkCreatePipelineCache(mHandle, &pipelineCacheInfo, nullptr, &mPipelineCache);
+		if (ret != VK_SUCCESS && bValid) {
+			LOG_W("Driver rejected pipeline cache {0}: {1}", AD_VK_PIPELINE_CACHE_FILE, vk_result_string(ret));
+			bValid = false;
+			pipelineCacheInfo.initialDataSize = 0;
+			pipelineCacheInfo.pInitialData = nullptr;
+			ret = vkCreatePipelineCache(mHandle, &pipelineCacheInfo, nullptr, &mPipelineCache);
+		}
+		CALL_VK(ret);
+
+		bPipelineCacheWarm = bValid;
+		LOG_D("Pipeline cache: {0} start, loaded {1} bytes", bPipelineCacheWarm ? "warm" : "cold", pipelineCacheInfo.initialDataSize);
+	}
+
+	// 将管道缓存写回磁盘，先写临时文件再替换，避免中途退出留下损坏的缓存
+	void AdVKDevice::SavePipelineCache() const {
+		if (mPipelineCache == VK_NULL_HANDLE) {
+			return;
+		}
+
+		size_t dataSize = 0;
+		CALL_VK(vkGetPipelineCacheData(mHandle, mPipelineCache, &dataSize, nullptr));
+		if (dataSize == 0) {
+			return;
+		}
+		std::vector<char> cacheData(dataSize);
+		CALL_VK(vkGetPipelineCacheData(mHandle, mPipelineCache, &dataSize, cacheData.data()));
+
+		std::error_code ec;
+		std::filesystem::path path(AD_VK_PIPELINE_CACHE_FILE);
+		std::filesystem::create_directories(path.parent_path(), ec);
+		std::filesystem::path tmpPath = path;
+		tmpPath += ".tmp";
+
+		std::ofstream file(tmpPath, std::ios::binary | std::ios::trunc);
+		if (!file.is_open()) {
+			LOG_W("Can not write pipeline cache: {0}", tmpPath.string());
+			return;
+		}
+		file.write(cacheData.data(), dataSize);
+		file.close();
+
+		std::filesystem::rename(tmpPath, path, ec);
+		if (ec) {
+			LOG_W("Can not replace pipeline cache {0}: {1}", path.string(), ec.message());
+			return;
+		}
+		LOG_D("Save pipeline cache: {0} bytes", dataSize);
 	}
 
 	// 创建默认命令池
@@ -176,6 +370,10 @@ namespace WuDu {
 		mDefaultCmdPool = std::make_shared<WuDu::AdVKCommandPool>(this, mContext->GetGraphicQueueFamilyInfo().queueFamilyIndex);
 	}
 
+	uint32_t AdVKDevice::GetTransferQueueFamilyIndex() const {
+		return mUploadQueueFamilyIndices.back();
+	}
+
 	// 获取内存类型索引
 	int32_t AdVKDevice::GetMemoryIndex(VkMemoryPropertyFlags memProps, uint32_t memoryTypeBits) const {
 		// 获取物理设备内存属性
@@ -248,4 +446,33 @@ namespace WuDu {
 		// 调用Vulkan的vkCreateSampler函数，根据配置信息创建采样器对象。
 		return vkCreateSampler(mHandle, &samplerInfo, nullptr, outSampler);
 	}
+
+	/**
+	 * 等待设备空闲。
+	 *
+	 * 全设备同步会打断CPU/GPU并行，正常帧循环中不应出现；这里统一收口并计数，
+	 * 以便渲染器统计每帧发生的设备空闲等待次数。
+	 */
+	void AdVKDevice::WaitIdle() {
+		mWaitIdleCount++;
+		// vkDeviceWaitIdle 要求该设备所有队列都已外部同步，按固定顺序持有各队列的提交锁
+		std::vector<AdVKQueue*> queues;
+		for (const auto& queue : mGraphicQueues) {
+			queues.push_back(queue.get());
+		}
+		for (const auto& queue : mPresentQueues) {
+			if (std::find(queues.begin(), queues.end(), queue.get()) == queues.end()) {
+				queues.push_back(queue.get());
+			}
+		}
+		if (mTransferQueue) {
+			queues.push_back(mTransferQueue.get());
+		}
+		std::vector<std::unique_lock<std::mutex>> locks;
+		locks.reserve(queues.size());
+		for (AdVKQueue* queue : queues) {
+			locks.emplace_back(queue->GetSubmitMutex());
+		}
+		CALL_VK(vkDeviceWaitIdle(mHandle));
+	}
 }
\ No newline at end of file
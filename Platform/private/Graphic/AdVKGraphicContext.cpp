@@ -282,6 +282,7 @@ namespace WuDu {
 					// 只有在设备满足条件时才更新类成员变量
 					mGraphicQueueFamily = graphicQueue;
 					mPresentQueueFamily = presentQueue;
+					mTransferQueueFamily = FindTransferQueueFamily(queueFamilys);
 					mPhyDevice = device;
 					vkGetPhysicalDeviceMemoryProperties(device, &mPhyDeviceMemProperties);
 				}
@@ -328,6 +329,7 @@ namespace WuDu {
 			// 即使是默认设备，也必须赋值队列族信息
 			mGraphicQueueFamily = graphicQueue;
 			mPresentQueueFamily = presentQueue;
+			mTransferQueueFamily = FindTransferQueueFamily(queueFamilys);
 			mPhyDevice = device;
 			vkGetPhysicalDeviceMemoryProperties(device, &mPhyDeviceMemProperties);
 		}
@@ -337,6 +339,26 @@ namespace WuDu {
 			__FUNCTION__, maxScorePhyDeviceIndex, maxScore,
 			mGraphicQueueFamily.queueFamilyIndex, mGraphicQueueFamily.queueCount,
 			mPresentQueueFamily.queueFamilyIndex, mPresentQueueFamily.queueCount);
+		LOG_T("{0} : transfer queue: {1} : {2}", __FUNCTION__, mTransferQueueFamily.queueFamilyIndex, mTransferQueueFamily.queueCount);
+	}
+
+	// 查找独立的传输队列族：优先选择只支持传输的队列族（通常对应 DMA 引擎），
+	// 其次选择不含图形能力的计算队列族；找不到时返回 -1，上传退回到图形队列
+	QueueFamilyInfo AdVKGraphicContext::FindTransferQueueFamily(const std::vector<VkQueueFamilyProperties>& queueFamilys) {
+		QueueFamilyInfo transferQueue = { -1, 0 };
+		for (int j = 0; j < queueFamilys.size(); j++) {
+			VkQueueFlags flags = queueFamilys[j].queueFlags;
+			if (queueFamilys[j].queueCount == 0 || !(flags & VK_QUEUE_TRANSFER_BIT) || (flags & VK_QUEUE_GRAPHICS_BIT)) {
+				continue;
+			}
+			if (!(flags & VK_QUEUE_COMPUTE_BIT)) {
+				return { j, queueFamilys[j].queueCount };
+			}
+			if (transferQueue.queueFamilyIndex < 0) {
+				transferQueue = { j, queueFamilys[j].queueCount };
+			}
+		}
+		return transferQueue;
 	}
 
 	// 打印物理设备信息
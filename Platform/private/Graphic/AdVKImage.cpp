@@ -26,6 +26,10 @@ namespace WuDu {
 			tiling = VK_IMAGE_TILING_OPTIMAL;
 		}
 
+		// 作为上传目标的图像需要在图形队列与传输队列之间共享
+		const std::vector<uint32_t>& queueFamilyIndices = mDevice->GetUploadQueueFamilyIndices();
+		bool bConcurrent = (usage & VK_IMAGE_USAGE_TRANSFER_DST_BIT) && queueFamilyIndices.size() > 1;
+
 		// 填充图像创建信息结构体
 		VkImageCreateInfo imageInfo = {
 			.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
@@ -39,9 +43,9 @@ namespace WuDu {
 			.samples = sampleCount,
 			.tiling = tiling,
 			.usage = usage,
-			.sharingMode = VK_SHARING_MODE_EXCLUSIVE,
-			.queueFamilyIndexCount = 0,
-			.pQueueFamilyIndices = nullptr,
+			.sharingMode = bConcurrent ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE,
+			.queueFamilyIndexCount = bConcurrent ? static_cast<uint32_t>(queueFamilyIndices.size()) : 0,
+			.pQueueFamilyIndices = bConcurrent ? queueFamilyIndices.data() : nullptr,
 			.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED
 		};
 
@@ -52,17 +56,15 @@ namespace WuDu {
 		VkMemoryRequirements memReqs;
 		vkGetImageMemoryRequirements(mDevice->GetHandle(), mHandle, &memReqs);
 
-		// 填充内存分配信息结构体
-		VkMemoryAllocateInfo allocateInfo = {
-			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
-			.pNext = nullptr,
-			.allocationSize = memReqs.size,
-			.memoryTypeIndex = static_cast<uint32_t>(mDevice->GetMemoryIndex(VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, memReqs.memoryTypeBits))
-		};
-
-		// 分配设备内存并绑定到图像对象
-		CALL_VK(vkAllocateMemory(mDevice->GetHandle(), &allocateInfo, nullptr, &mMemory));
-		CALL_VK(vkBindImageMemory(mDevice->GetHandle(), mHandle, mMemory, 0));
+		// 从引擎内存分配器中子分配设备内存并绑定到图像对象
+		// 线性与最优布局的图像分属不同内存块，满足 bufferImageGranularity
+		AdVKMemoryAllocator* allocator = mDevice->GetMemoryAllocator();
+		AdVKAllocationKind kind = tiling == VK_IMAGE_TILING_OPTIMAL ? AD_VK_ALLOCATION_OPTIMAL : AD_VK_ALLOCATION_LINEAR;
+		if (!allocator->Allocate(memReqs, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, kind, &mAllocation)) {
+			LOG_E("Failed to allocate {0} bytes for image", memReqs.size);
+			return;
+		}
+		CALL_VK(allocator->BindImage(mHandle, mAllocation));
 	}
 
 	AdVKImage::AdVKImage(AdVKDevice* device, VkImage image, VkExtent3D extent, VkFormat format, VkImageUsageFlags usage, VkSampleCountFlagBits sampleCount)
@@ -73,7 +75,7 @@ namespace WuDu {
 	AdVKImage::~AdVKImage() {
 		if (bCreateImage) {
 			VK_D(Image, mDevice->GetHandle(), mHandle);
-			VK_F(mDevice->GetHandle(), mMemory);
+			mDevice->GetMemoryAllocator()->Free(mAllocation);
 		}
 	}
 
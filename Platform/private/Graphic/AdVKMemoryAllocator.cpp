@@ -0,0 +1,342 @@
+#include "Graphic/AdVKMemoryAllocator.h"
+#include "Graphic/AdVKDevice.h"
+#include "Graphic/AdVKGraphicContext.h"
+
+namespace WuDu {
+	static VkDeviceSize AlignUp(VkDeviceSize value, VkDeviceSize alignment) {
+		return alignment > 1 ? (value + alignment - 1) / alignment * alignment : value;
+	}
+
+	/**
+	 * @brief 构造内存分配器，读取物理设备的内存类型与 bufferImageGranularity
+	 *
+	 * @param device 逻辑设备
+	 */
+	AdVKMemoryAllocator::AdVKMemoryAllocator(AdVKDevice* device) : mDevice(device) {
+		AdVKGraphicContext* context = device->GetContext();
+		mMemProperties = context->GetPhyDeviceMemProperties();
+
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(context->GetPhyDevice(), &props);
+		mBufferImageGranularity = props.limits.bufferImageGranularity;
+
+		mPools.resize(mMemProperties.memoryTypeCount * AD_VK_ALLOCATION_KIND_COUNT);
+		mHeapStats.resize(mMemProperties.memoryHeapCount);
+		LOG_T("Memory allocator: {0} memory types, {1} heaps, bufferImageGranularity: {2}",
+			mMemProperties.memoryTypeCount, mMemProperties.memoryHeapCount, mBufferImageGranularity);
+	}
+
+	AdVKMemoryAllocator::~AdVKMemoryAllocator() {
+		LogStats();
+		for (uint32_t poolIndex = 0; poolIndex < mPools.size(); poolIndex++) {
+			uint32_t memoryTypeIndex = poolIndex / AD_VK_ALLOCATION_KIND_COUNT;
+			for (auto& block : mPools[poolIndex]) {
+				if (block->allocationCount > 0) {
+					LOG_W("Memory block {0} still has {1} allocations when allocator destroyed", (void*)block->memory, block->allocationCount);
+				}
+				DestroyBlock(block.get(), memoryTypeIndex);
+			}
+			mPools[poolIndex].clear();
+		}
+	}
+
+	/**
+	 * @brief 为资源分配内存
+	 *
+	 * 先在同类型、同布局类别的已有内存块中做最佳适配，失败时创建新块；
+	 * 超过半个块大小的资源单独分配，避免大块内存被一个资源独占后产生浪费。
+	 *
+	 * @param memReqs 资源的内存需求（大小、对齐、可用内存类型）
+	 * @param memProps 需要的内存属性
+	 * @param kind 资源的布局类别（线性/最优），用于满足 bufferImageGranularity
+	 * @param outAllocation 输出的分配结果
+	 * @return 是否分配成功
+	 */
+	bool AdVKMemoryAllocator::Allocate(const VkMemoryRequirements& memReqs, VkMemoryPropertyFlags memProps, AdVKAllocationKind kind, AdVKAllocation* outAllocation) {
+		int32_t memoryTypeIndex = mDevice->GetMemoryIndex(memProps, memReqs.memoryTypeBits);
+		if (memoryTypeIndex < 0) {
+			return false;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+
+		VkDeviceSize blockSize = GetBlockSize(memoryTypeIndex);
+		if (memReqs.size > blockSize / 2) {
+			return AllocateDedicated(memReqs.size, memoryTypeIndex, outAllocation);
+		}
+
+		uint32_t poolIndex = GetPoolIndex(memoryTypeIndex, kind);
+		std::vector<std::unique_ptr<MemoryBlock>>& pool = mPools[poolIndex];
+
+		MemoryBlock* targetBlock = nullptr;
+		VkDeviceSize offset = 0;
+		for (auto& block : pool) {
+			if (AllocateFromBlock(block.get(), memReqs.size, memReqs.alignment, &offset)) {
+				targetBlock = block.get();
+				break;
+			}
+		}
+
+		if (!targetBlock) {
+			targetBlock = CreateBlock(memoryTypeIndex, blockSize);
+			if (!targetBlock) {
+				return false;
+			}
+			pool.emplace_back(targetBlock);
+			if (!AllocateFromBlock(targetBlock, memReqs.size, memReqs.alignment, &offset)) {
+				LOG_E("Failed to allocate {0} bytes from a new memory block of {1} bytes", memReqs.size, blockSize);
+				return false;
+			}
+		}
+
+		targetBlock->allocationCount++;
+
+		AdVKHeapStats& stats = mHeapStats[mMemProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		stats.allocationCount++;
+		stats.usedBytes += memReqs.size;
+
+		*outAllocation = {
+			.memory = targetBlock->memory,
+			.offset = offset,
+			.size = memReqs.size,
+			.mappedData = targetBlock->mappedData ? static_cast<uint8_t*>(targetBlock->mappedData) + offset : nullptr,
+			.memoryTypeIndex = static_cast<uint32_t>(memoryTypeIndex),
+			.kind = kind,
+			.bDedicated = false,
+			.pBlock = targetBlock
+		};
+		return true;
+	}
+
+	/**
+	 * @brief 释放分配，归还的区间会与相邻空闲区间合并；空块（保留每个池的第一个）会被归还给驱动
+	 *
+	 * @param allocation 需要释放的分配，释放后被重置
+	 */
+	void AdVKMemoryAllocator::Free(AdVKAllocation& allocation) {
+		if (!allocation.IsValid()) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		AdVKHeapStats& stats = mHeapStats[mMemProperties.memoryTypes[allocation.memoryTypeIndex].heapIndex];
+
+		if (allocation.bDedicated) {
+			if (allocation.mappedData) {
+				vkUnmapMemory(mDevice->GetHandle(), allocation.memory);
+			}
+			VK_F(mDevice->GetHandle(), allocation.memory);
+			stats.blockCount--;
+			stats.blockBytes -= allocation.size;
+			stats.allocationCount--;
+			stats.usedBytes -= allocation.size;
+			allocation = {};
+			return;
+		}
+
+		MemoryBlock* block = static_cast<MemoryBlock*>(allocation.pBlock);
+		InsertFreeRange(block, allocation.offset, allocation.size);
+		block->allocationCount--;
+		stats.allocationCount--;
+		stats.usedBytes -= allocation.size;
+
+		if (block->allocationCount == 0) {
+			std::vector<std::unique_ptr<MemoryBlock>>& pool = mPools[GetPoolIndex(allocation.memoryTypeIndex, allocation.kind)];
+			if (pool.size() > 1) {
+				auto it = std::find_if(pool.begin(), pool.end(), [block](const std::unique_ptr<MemoryBlock>& item) { return item.get() == block; });
+				if (it != pool.end()) {
+					DestroyBlock(block, allocation.memoryTypeIndex);
+					pool.erase(it);
+				}
+			}
+		}
+		allocation = {};
+	}
+
+	VkResult AdVKMemoryAllocator::BindBuffer(VkBuffer buffer, const AdVKAllocation& allocation) const {
+		return vkBindBufferMemory(mDevice->GetHandle(), buffer, allocation.memory, allocation.offset);
+	}
+
+	VkResult AdVKMemoryAllocator::BindImage(VkImage image, const AdVKAllocation& allocation) const {
+		return vkBindImageMemory(mDevice->GetHandle(), image, allocation.memory, allocation.offset);
+	}
+
+	/**
+	 * @brief 获取指定内存堆的统计信息
+	 */
+	AdVKHeapStats AdVKMemoryAllocator::GetHeapStats(uint32_t heapIndex) const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (heapIndex >= mHeapStats.size()) {
+			return {};
+		}
+		return mHeapStats[heapIndex];
+	}
+
+	void AdVKMemoryAllocator::LogStats() const {
+		std::lock_guard<std::mutex> lock(mMutex);
+		for (uint32_t i = 0; i < mHeapStats.size(); i++) {
+			const AdVKHeapStats& stats = mHeapStats[i];
+			LOG_D("Memory heap {0}: {1} blocks, {2} allocations, used {3} / {4} bytes",
+				i, stats.blockCount, stats.allocationCount, stats.usedBytes, stats.blockBytes);
+		}
+	}
+
+	bool AdVKMemoryAllocator::AllocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex, AdVKAllocation* outAllocation) {
+		VkMemoryAllocateInfo allocateInfo = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.allocationSize = size,
+			.memoryTypeIndex = memoryTypeIndex
+		};
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkResult ret = vkAllocateMemory(mDevice->GetHandle(), &allocateInfo, nullptr, &memory);
+		if (ret != VK_SUCCESS) {
+			LOG_E("Dedicated allocation of {0} bytes failed: {1}", size, vk_result_string(ret));
+			return false;
+		}
+
+		void* mapping = nullptr;
+		if (mMemProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+			CALL_VK(vkMapMemory(mDevice->GetHandle(), memory, 0, VK_WHOLE_SIZE, 0, &mapping));
+		}
+
+		AdVKHeapStats& stats = mHeapStats[mMemProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		stats.blockCount++;
+		stats.blockBytes += size;
+		stats.allocationCount++;
+		stats.usedBytes += size;
+
+		*outAllocation = {
+			.memory = memory,
+			.offset = 0,
+			.size = size,
+			.mappedData = mapping,
+			.memoryTypeIndex = memoryTypeIndex,
+			.kind = AD_VK_ALLOCATION_LINEAR,
+			.bDedicated = true,
+			.pBlock = nullptr
+		};
+		return true;
+	}
+
+	AdVKMemoryAllocator::MemoryBlock* AdVKMemoryAllocator::CreateBlock(uint32_t memoryTypeIndex, VkDeviceSize size) {
+		VkMemoryAllocateInfo allocateInfo = {
+			.sType = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+			.pNext = nullptr,
+			.allocationSize = size,
+			.memoryTypeIndex = memoryTypeIndex
+		};
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkResult ret = vkAllocateMemory(mDevice->GetHandle(), &allocateInfo, nullptr, &memory);
+		if (ret != VK_SUCCESS) {
+			LOG_E("Allocate memory block of {0} bytes failed: {1}", size, vk_result_string(ret));
+			return nullptr;
+		}
+
+		MemoryBlock* block = new MemoryBlock();
+		block->memory = memory;
+		block->size = size;
+		InsertFreeRange(block, 0, size);
+
+		// 主机可见内存整体映射一次，生命周期内保持映射
+		if (mMemProperties.memoryTypes[memoryTypeIndex].propertyFlags & VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT) {
+			CALL_VK(vkMapMemory(mDevice->GetHandle(), memory, 0, VK_WHOLE_SIZE, 0, &block->mappedData));
+		}
+
+		AdVKHeapStats& stats = mHeapStats[mMemProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		stats.blockCount++;
+		stats.blockBytes += size;
+		LOG_T("Memory block created: type {0}, size {1}, memory {2}", memoryTypeIndex, size, (void*)memory);
+		return block;
+	}
+
+	void AdVKMemoryAllocator::DestroyBlock(MemoryBlock* block, uint32_t memoryTypeIndex) {
+		if (block->mappedData) {
+			vkUnmapMemory(mDevice->GetHandle(), block->memory);
+			block->mappedData = nullptr;
+		}
+		VK_F(mDevice->GetHandle(), block->memory);
+
+		AdVKHeapStats& stats = mHeapStats[mMemProperties.memoryTypes[memoryTypeIndex].heapIndex];
+		stats.blockCount--;
+		stats.blockBytes -= block->size;
+	}
+
+	/**
+	 * @brief 在内存块中按最佳适配查找满足大小和对齐的空闲区间
+	 */
+	bool AdVKMemoryAllocator::AllocateFromBlock(MemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize* outOffset) {
+		for (auto it = block->freeRangesBySize.lower_bound(size); it != block->freeRangesBySize.end(); ++it) {
+			VkDeviceSize rangeOffset = it->second;
+			VkDeviceSize rangeSize = it->first;
+			VkDeviceSize alignedOffset = AlignUp(rangeOffset, alignment);
+			if (alignedOffset + size > rangeOffset + rangeSize) {
+				continue;
+			}
+
+			RemoveFreeRange(block, block->freeRanges.find(rangeOffset));
+
+			// 对齐产生的前部空隙和尾部剩余空间重新放回空闲链表
+			if (alignedOffset > rangeOffset) {
+				InsertFreeRange(block, rangeOffset, alignedOffset - rangeOffset);
+			}
+			VkDeviceSize tailOffset = alignedOffset + size;
+			if (tailOffset < rangeOffset + rangeSize) {
+				InsertFreeRange(block, tailOffset, rangeOffset + rangeSize - tailOffset);
+			}
+
+			*outOffset = alignedOffset;
+			return true;
+		}
+		return false;
+	}
+
+	/**
+	 * @brief 插入空闲区间并与前后相邻的空闲区间合并
+	 */
+	void AdVKMemoryAllocator::InsertFreeRange(MemoryBlock* block, VkDeviceSize offset, VkDeviceSize size) {
+		auto next = block->freeRanges.lower_bound(offset);
+		if (next != block->freeRanges.begin()) {
+			auto prev = std::prev(next);
+			if (prev->first + prev->second == offset) {
+				offset = prev->first;
+				size += prev->second;
+				RemoveFreeRange(block, prev);
+			}
+		}
+		next = block->freeRanges.lower_bound(offset);
+		if (next != block->freeRanges.end() && offset + size == next->first) {
+			size += next->second;
+			RemoveFreeRange(block, next);
+		}
+
+		block->freeRanges.emplace(offset, size);
+		block->freeRangesBySize.emplace(size, offset);
+	}
+
+	void AdVKMemoryAllocator::RemoveFreeRange(MemoryBlock* block, std::map<VkDeviceSize, VkDeviceSize>::iterator it) {
+		auto range = block->freeRangesBySize.equal_range(it->second);
+		for (auto sizeIt = range.first; sizeIt != range.second; ++sizeIt) {
+			if (sizeIt->second == it->first) {
+				block->freeRangesBySize.erase(sizeIt);
+				break;
+			}
+		}
+		block->freeRanges.erase(it);
+	}
+
+	VkDeviceSize AdVKMemoryAllocator::GetBlockSize(uint32_t memoryTypeIndex) const {
+		VkDeviceSize heapSize = mMemProperties.memoryHeaps[mMemProperties.memoryTypes[memoryTypeIndex].heapIndex].size;
+		return heapSize <= AD_VK_MEMORY_SMALL_HEAP_SIZE ? AlignUp(heapSize / 8, 32) : AD_VK_MEMORY_BLOCK_SIZE;
+	}
+
+	/**
+	 * @brief 计算内存池索引；bufferImageGranularity 为 1 时线性与最优资源可以共享内存块
+	 */
+	uint32_t AdVKMemoryAllocator::GetPoolIndex(uint32_t memoryTypeIndex, AdVKAllocationKind kind) const {
+		if (mBufferImageGranularity <= 1) {
+			kind = AD_VK_ALLOCATION_LINEAR;
+		}
+		return memoryTypeIndex * AD_VK_ALLOCATION_KIND_COUNT + kind;
+	}
+}
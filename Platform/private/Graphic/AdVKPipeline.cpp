@@ -2,6 +2,7 @@
 #include "AdFileUtil.h"
 #include "Graphic/AdVKDevice.h"
 #include "Graphic/AdVKRenderPass.h"
+#include "AdThreadPool.h"
 
 namespace WuDu {
 	/**
@@ -17,8 +18,9 @@ namespace WuDu {
 	*/
 	AdVKPipelineLayout::AdVKPipelineLayout(AdVKDevice* device, const std::string& vertexShaderFile, const std::string& fragShaderFile, const ShaderLayout& shaderLayout) : mDevice(device) {
 		// 编译着色器模块
-		CALL_VK(CreateShaderModule(vertexShaderFile + ".spv", &mVertexShaderModule));
-		CALL_VK(CreateShaderModule(fragShaderFile + ".spv", &mFragShaderModule));
+		mShaderHash = HashBytes(nullptr, 0);
+		CALL_VK(CreateShaderModule(vertexShaderFile + ".spv", &mVertexShaderModule, &mShaderHash));
+		CALL_VK(CreateShaderModule(fragShaderFile + ".spv", &mFragShaderModule, &mShaderHash));
 
 		// 创建管线布局
 		VkPipelineLayoutCreateInfo pipelineLayoutInfo = {
@@ -52,11 +54,13 @@ namespace WuDu {
 	 *
 	 * @param filePath 着色器代码文件的路径
 	 * @param outShaderModule 指向用于存储创建的着色器模块句柄的指针
+	 * @param inOutHash 累加着色器代码哈希
 	 * @return VkResult 返回 Vulkan API 的结果代码，VK_SUCCESS 表示成功
 	 */
-	VkResult AdVKPipelineLayout::CreateShaderModule(const std::string& filePath, VkShaderModule* outShaderModule) {
+	VkResult AdVKPipelineLayout::CreateShaderModule(const std::string& filePath, VkShaderModule* outShaderModule, uint64_t* inOutHash) {
 		// 从文件中读取着色器代码内容
 		std::vector<char> content = ReadCharArrayFromFile(filePath);
+		*inOutHash = HashVector(content, *inOutHash);
 
 		// 配置着色器模块创建信息结构体
 		VkShaderModuleCreateInfo shaderModuleInfo = {
@@ -71,6 +75,76 @@ namespace WuDu {
 		return vkCreateShaderModule(mDevice->GetHandle(), &shaderModuleInfo, nullptr, outShaderModule);
 	}
 
+	////// Pipeline Registry
+
+	AdVKPipelineEntry::~AdVKPipelineEntry() {
+		// 编译任务可能仍在工作线程上运行，必须等待其结束后才能销毁
+		Wait();
+		VK_D(Pipeline, device->GetHandle(), handle.load());
+	}
+
+	void AdVKPipelineEntry::Wait() const {
+		if (compileTask.valid()) {
+			compileTask.wait();
+		}
+	}
+
+	AdVKPipelineRegistry::AdVKPipelineRegistry(AdVKDevice* device) : mDevice(device) {
+
+	}
+
+	AdVKPipelineRegistry::~AdVKPipelineRegistry() {
+		LOG_D("Pipeline registry: {0} hits, {1} compiled", GetHitCount(), GetMissCount());
+	}
+
+	std::shared_ptr<AdVKPipelineEntry> AdVKPipelineRegistry::Acquire(const AdVKPipelineKey& key, std::function<VkPipeline()> compileFunc, bool bAsync) {
+		std::shared_ptr<AdVKPipelineEntry> entry;
+		std::packaged_task<void()> syncTask;
+		{
+			std::lock_guard<std::mutex> lock(mMutex);
+			auto it = mEntries.find(key);
+			if (it != mEntries.end()) {
+				entry = it->second.lock();
+			}
+
+			if (entry) {
+				mHitCount++;
+			}
+			else {
+				mMissCount++;
+				mPendingCount++;
+				entry = std::make_shared<AdVKPipelineEntry>();
+				entry->device = mDevice;
+				entry->sortId = mSortIds.try_emplace(key, static_cast<uint32_t>(mSortIds.size())).first->second;
+				mEntries[key] = entry;
+
+				// 任务只持有裸指针：记录析构时会等待任务结束，避免在工作线程上析构自身
+				AdVKPipelineEntry* pEntry = entry.get();
+				auto compile = [this, pEntry, compileFunc = std::move(compileFunc)]() {
+					pEntry->handle = compileFunc();
+					pEntry->bReady = true;
+					mPendingCount--;
+				};
+				if (bAsync) {
+					entry->compileTask = AdThreadPool::GetInstance()->Submit(std::move(compile)).share();
+				}
+				else {
+					syncTask = std::packaged_task<void()>(std::move(compile));
+					entry->compileTask = syncTask.get_future().share();
+				}
+			}
+		}
+
+		// 同步编译在锁外执行，其它线程请求同一管线时等待同一个任务
+		if (syncTask.valid()) {
+			syncTask();
+		}
+		if (!bAsync) {
+			entry->Wait();
+		}
+		return entry;
+	}
+
 	////// Pipeline
 
 	AdVKPipeline::AdVKPipeline(AdVKDevice* device, AdVKRenderPass* renderPass, AdVKPipelineLayout* pipelineLayout) : mDevice(device), mRenderPass(renderPass), mPipelineLayout(pipelineLayout) {
@@ -78,18 +152,80 @@ namespace WuDu {
 	}
 
 	AdVKPipeline::~AdVKPipeline() {
-		VK_D(Pipeline, mDevice->GetHandle(), mHandle);
+		mEntry.reset();
+	}
+
+	void AdVKPipeline::Create() {
+		Acquire(false);
+	}
+
+	void AdVKPipeline::CreateAsync() {
+		Acquire(true);
+	}
+
+	template<typename T>
+	static void AppendKeyValue(std::vector<uint8_t>& state, const T& value) {
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(&value);
+		state.insert(state.end(), bytes, bytes + sizeof(T));
+	}
+
+	// 先写元素个数，不同长度的数组拼接后不会得到相同的字节序列
+	template<typename T>
+	static void AppendKeyVector(std::vector<uint8_t>& state, const std::vector<T>& values) {
+		AppendKeyValue(state, values.size());
+		const uint8_t* bytes = reinterpret_cast<const uint8_t*>(values.data());
+		state.insert(state.end(), bytes, bytes + values.size() * sizeof(T));
 	}
 
 	/**
-	* @brief 创建 Vulkan 图形管线
+	 * @brief 生成管线状态键
+	 *
+	 * 管线配置中的各状态结构体均由 4 字节字段组成，没有填充字节，可以直接按字节比较。
+	 * 管线布局以句柄参与（注册表为弱引用，记录存活时布局及其着色器模块一定有效），渲染通道只取兼容性哈希。
+	 */
+	AdVKPipelineKey AdVKPipeline::GetKey() const {
+		AdVKPipelineKey key;
+		AppendKeyVector(key.state, mPipelineConfig.vertexInputState.vertexBindings);
+		AppendKeyVector(key.state, mPipelineConfig.vertexInputState.vertexAttributes);
+		AppendKeyValue(key.state, mPipelineConfig.inputAssemblyState);
+		AppendKeyValue(key.state, mPipelineConfig.rasterizationState);
+		AppendKeyValue(key.state, mPipelineConfig.multisampleState);
+		AppendKeyValue(key.state, mPipelineConfig.depthStencilState);
+		AppendKeyValue(key.state, mPipelineConfig.colorBlendAttachmentState);
+		AppendKeyVector(key.state, mPipelineConfig.dynamicState.dynamicStates);
+		AppendKeyValue(key.state, mPipelineLayout->GetShaderHash());
+		AppendKeyValue(key.state, mPipelineLayout->GetHandle());
+		AppendKeyValue(key.state, mRenderPass->GetCompatibilityHash());
+		AppendKeyValue(key.state, mSubPassIndex);
+		key.hash = HashBytes(key.state.data(), key.state.size());
+		return key;
+	}
+
+	void AdVKPipeline::Acquire(bool bAsync) {
+		// 编译函数按值捕获配置，工作线程上不访问 AdVKPipeline 本身
+		AdVKDevice* device = mDevice;
+		PipelineConfig config = mPipelineConfig;
+		VkShaderModule vertexShaderModule = mPipelineLayout->GetVertexShaderModule();
+		VkShaderModule fragShaderModule = mPipelineLayout->GetFragShaderModule();
+		VkPipelineLayout pipelineLayout = mPipelineLayout->GetHandle();
+		VkRenderPass renderPass = mRenderPass->GetHandle();
+		uint32_t subPassIndex = mSubPassIndex;
+
+		mEntry = mDevice->GetPipelineRegistry()->Acquire(GetKey(), [=]() {
+			return Compile(device, config, vertexShaderModule, fragShaderModule, pipelineLayout, renderPass, subPassIndex);
+		}, bAsync);
+	}
+
+	/**
+	* @brief 编译 Vulkan 图形管线
 	*
 	* 该函数负责创建 Vulkan 图形渲染管线，包括配置顶点着色器和片段着色器阶段。
-	* 管线创建需要预先设置好的着色器模块和管线布局。
+	* 只使用传入的参数，可以在工作线程上调用；管道缓存由驱动保证线程安全。
 	*
-	* @note 该函数不返回任何值，但会更新对象内部的管线状态
+	* @return 创建的管线句柄
 	*/
-	void AdVKPipeline::Create() {
+	VkPipeline AdVKPipeline::Compile(AdVKDevice* device, const PipelineConfig& config, VkShaderModule vertexShaderModule, VkShaderModule fragShaderModule,
+		VkPipelineLayout pipelineLayout, VkRenderPass renderPass, uint32_t subPassIndex) {
 		// 配置图形管线的着色器阶段信息
 		// 包括顶点着色器阶段和片段着色器阶段的创建信息
 		VkPipelineShaderStageCreateInfo shaderStageInfo[] = {
@@ -98,7 +234,7 @@ namespace WuDu {
 				.pNext = nullptr,
 				.flags = 0,
 				.stage = VK_SHADER_STAGE_VERTEX_BIT,
-				.module = mPipelineLayout->GetVertexShaderModule(),
+				.module = vertexShaderModule,
 				.pName = "main",
 				.pSpecializationInfo = nullptr
 			},
@@ -107,7 +243,7 @@ namespace WuDu {
 				.pNext = nullptr,
 				.flags = 0,
 				.stage = VK_SHADER_STAGE_FRAGMENT_BIT,
-				.module = mPipelineLayout->GetFragShaderModule(),
+				.module = fragShaderModule,
 				.pName = "main",
 				.pSpecializationInfo = nullptr
 			}
@@ -117,18 +253,18 @@ namespace WuDu {
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.vertexBindingDescriptionCount = static_cast<uint32_t>(mPipelineConfig.vertexInputState.vertexBindings.size()),
-			.pVertexBindingDescriptions = mPipelineConfig.vertexInputState.vertexBindings.data(),
-			.vertexAttributeDescriptionCount = static_cast<uint32_t>(mPipelineConfig.vertexInputState.vertexAttributes.size()),
-			.pVertexAttributeDescriptions = mPipelineConfig.vertexInputState.vertexAttributes.data()
+			.vertexBindingDescriptionCount = static_cast<uint32_t>(config.vertexInputState.vertexBindings.size()),
+			.pVertexBindingDescriptions = config.vertexInputState.vertexBindings.data(),
+			.vertexAttributeDescriptionCount = static_cast<uint32_t>(config.vertexInputState.vertexAttributes.size()),
+			.pVertexAttributeDescriptions = config.vertexInputState.vertexAttributes.data()
 		};
 
 		VkPipelineInputAssemblyStateCreateInfo inputAssemblyStateInfo = {
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.topology = mPipelineConfig.inputAssemblyState.topology,
-			.primitiveRestartEnable = mPipelineConfig.inputAssemblyState.primitiveRestartEnable
+			.topology = config.inputAssemblyState.topology,
+			.primitiveRestartEnable = config.inputAssemblyState.primitiveRestartEnable
 		};
 
 		VkViewport defaultViewport = {
@@ -157,25 +293,25 @@ namespace WuDu {
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.depthClampEnable = mPipelineConfig.rasterizationState.depthClampEnable,
-			.rasterizerDiscardEnable = mPipelineConfig.rasterizationState.rasterizerDiscardEnable,
-			.polygonMode = mPipelineConfig.rasterizationState.polygonMode,
-			.cullMode = mPipelineConfig.rasterizationState.cullMode,
-			.frontFace = mPipelineConfig.rasterizationState.frontFace,
-			.depthBiasEnable = mPipelineConfig.rasterizationState.depthBiasEnable,
-			.depthBiasConstantFactor = mPipelineConfig.rasterizationState.depthBiasConstantFactor,
-			.depthBiasClamp = mPipelineConfig.rasterizationState.depthBiasClamp,
-			.depthBiasSlopeFactor = mPipelineConfig.rasterizationState.depthBiasSlopeFactor,
-			.lineWidth = mPipelineConfig.rasterizationState.lineWidth
+			.depthClampEnable = config.rasterizationState.depthClampEnable,
+			.rasterizerDiscardEnable = config.rasterizationState.rasterizerDiscardEnable,
+			.polygonMode = config.rasterizationState.polygonMode,
+			.cullMode = config.rasterizationState.cullMode,
+			.frontFace = config.rasterizationState.frontFace,
+			.depthBiasEnable = config.rasterizationState.depthBiasEnable,
+			.depthBiasConstantFactor = config.rasterizationState.depthBiasConstantFactor,
+			.depthBiasClamp = config.rasterizationState.depthBiasClamp,
+			.depthBiasSlopeFactor = config.rasterizationState.depthBiasSlopeFactor,
+			.lineWidth = config.rasterizationState.lineWidth
 		};
 
 		VkPipelineMultisampleStateCreateInfo multisampleStateInfo = {
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_MULTISAMPLE_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.rasterizationSamples = mPipelineConfig.multisampleState.rasterizationSamples,
-			.sampleShadingEnable = mPipelineConfig.multisampleState.sampleShadingEnable,
-			.minSampleShading = mPipelineConfig.multisampleState.minSampleShading,
+			.rasterizationSamples = config.multisampleState.rasterizationSamples,
+			.sampleShadingEnable = config.multisampleState.sampleShadingEnable,
+			.minSampleShading = config.multisampleState.minSampleShading,
 			.pSampleMask = nullptr,
 			.alphaToCoverageEnable = VK_FALSE,
 			.alphaToOneEnable = VK_FALSE
@@ -185,11 +321,11 @@ namespace WuDu {
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.depthTestEnable = mPipelineConfig.depthStencilState.depthTestEnable,
-			.depthWriteEnable = mPipelineConfig.depthStencilState.depthWriteEnable,
-			.depthCompareOp = mPipelineConfig.depthStencilState.depthCompareOp,
-			.depthBoundsTestEnable = mPipelineConfig.depthStencilState.depthBoundsTestEnable,
-			.stencilTestEnable = mPipelineConfig.depthStencilState.stencilTestEnable,
+			.depthTestEnable = config.depthStencilState.depthTestEnable,
+			.depthWriteEnable = config.depthStencilState.depthWriteEnable,
+			.depthCompareOp = config.depthStencilState.depthCompareOp,
+			.depthBoundsTestEnable = config.depthStencilState.depthBoundsTestEnable,
+			.stencilTestEnable = config.depthStencilState.stencilTestEnable,
 			.front = {},
 			.back = {},
 			.minDepthBounds = 0.0f,
@@ -203,7 +339,7 @@ namespace WuDu {
 			.logicOpEnable = VK_FALSE,
 			.logicOp = VK_LOGIC_OP_CLEAR,
 			.attachmentCount = 1,
-			.pAttachments = &mPipelineConfig.colorBlendAttachmentState,
+			.pAttachments = &config.colorBlendAttachmentState,
 		};
 		colorBlendStateInfo.blendConstants[0] = colorBlendStateInfo.blendConstants[1] = colorBlendStateInfo.blendConstants[2] = colorBlendStateInfo.blendConstants[3] = 0;
 
@@ -211,8 +347,8 @@ namespace WuDu {
 			.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO,
 			.pNext = nullptr,
 			.flags = 0,
-			.dynamicStateCount = static_cast<uint32_t>(mPipelineConfig.dynamicState.dynamicStates.size()),
-			.pDynamicStates = mPipelineConfig.dynamicState.dynamicStates.data()
+			.dynamicStateCount = static_cast<uint32_t>(config.dynamicState.dynamicStates.size()),
+			.pDynamicStates = config.dynamicState.dynamicStates.data()
 		};
 		VkGraphicsPipelineCreateInfo pipelineInfo = {
 			.sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
@@ -229,14 +365,19 @@ namespace WuDu {
 			.pDepthStencilState = &depthStencilStateInfo,
 			.pColorBlendState = &colorBlendStateInfo,
 			.pDynamicState = &dynamicStateInfo,
-			.layout = mPipelineLayout->GetHandle(),
-			.renderPass = mRenderPass->GetHandle(),
-			.subpass = mSubPassIndex,
+			.layout = pipelineLayout,
+			.renderPass = renderPass,
+			.subpass = subPassIndex,
 			.basePipelineHandle = VK_NULL_HANDLE,
 			.basePipelineIndex = 0
 		};
-		CALL_VK(vkCreateGraphicsPipelines(mDevice->GetHandle(), mDevice->GetPipelineCache(), 1, &pipelineInfo, nullptr, &mHandle));
-		LOG_T("Create pipeline : {0}", (void*)mHandle);
+		VkPipeline pipeline = VK_NULL_HANDLE;
+		auto startTime = std::chrono::steady_clock::now();
+		CALL_VK(vkCreateGraphicsPipelines(device->GetHandle(), device->GetPipelineCache(), 1, &pipelineInfo, nullptr, &pipeline));
+		uint64_t createTimeUs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTime).count();
+		device->AddPipelineCreateTime(createTimeUs);
+		LOG_T("Create pipeline : {0}, {1} ms", (void*)pipeline, createTimeUs / 1000.f);
+		return pipeline;
 	}
 
 	AdVKPipeline* AdVKPipeline::SetVertexInputState(const std::vector<VkVertexInputBindingDescription>& vertexBindings,
@@ -325,7 +466,11 @@ namespace WuDu {
 		mSubPassIndex = index;
 	}
 
-	void AdVKPipeline::Bind(VkCommandBuffer cmdBuffer) {
-		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, mHandle);
+	bool AdVKPipeline::Bind(VkCommandBuffer cmdBuffer) {
+		if (!IsReady()) {
+			return false;
+		}
+		vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GetHandle());
+		return true;
 	}
 }
\ No newline at end of file
@@ -7,6 +7,7 @@ namespace WuDu {
 	}
 
 	void AdVKQueue::WaitIdle() const {
+		std::lock_guard<std::mutex> lock(mSubmitMutex);
 		CALL_VK(vkQueueWaitIdle(mHandle));
 	}
 
@@ -39,6 +40,12 @@ namespace WuDu {
 		};
 
 		// 调用VK函数提交命令缓冲区到队列
+		std::lock_guard<std::mutex> lock(mSubmitMutex);
 		CALL_VK(vkQueueSubmit(mHandle, 1, &submitInfo, frameFence));
 	}
+
+	VkResult AdVKQueue::Present(const VkPresentInfoKHR& presentInfo) {
+		std::lock_guard<std::mutex> lock(mSubmitMutex);
+		return vkQueuePresentKHR(mHandle, &presentInfo);
+	}
 }
\ No newline at end of file
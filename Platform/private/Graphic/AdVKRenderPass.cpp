@@ -163,6 +163,20 @@ namespace WuDu {
 		};
 		// 创建渲染通道
 		CALL_VK(vkCreateRenderPass(mDevice->GetHandle(), &renderPassInfo, nullptr, &mHandle));
+
+		// 计算兼容性哈希，load/store 操作与布局不影响兼容性
+		uint64_t hash = HashValue(mAttachments.size(), HashBytes(nullptr, 0));
+		for (const auto& attachment : mAttachments) {
+			hash = HashValue(attachment.format, hash);
+			hash = HashValue(attachment.samples, hash);
+		}
+		for (const auto& subPass : mSubPasses) {
+			hash = HashVector(subPass.inputAttachments, hash);
+			hash = HashVector(subPass.colorAttachments, hash);
+			hash = HashVector(subPass.depthStencilAttachments, hash);
+			hash = HashValue(subPass.sampleCount, hash);
+		}
+		mCompatibilityHash = hash;
 		// 日志输出渲染通道创建信息
 		LOG_T("RenderPass {0} : {1}, attachment count: {2}, subpass count: {3}", __FUNCTION__, (void*)mHandle, mAttachments.size(), mSubPasses.size());
 	}
@@ -0,0 +1,104 @@
+#include "Graphic/AdVKRingBuffer.h"
+#include "Graphic/AdVKDevice.h"
+#include "Graphic/AdVKBuffer.h"
+#include "Graphic/AdVKGraphicContext.h"
+
+namespace WuDu {
+	/**
+	 * @brief 构造环形缓冲区
+	 *
+	 * @param device 逻辑设备
+	 * @param usage 缓冲区用途（UNIFORM_BUFFER 或 STORAGE_BUFFER），决定切片的对齐要求
+	 * @param sizePerFrame 每个帧槽位的初始容量
+	 * @param frameCount 帧槽位数量
+	 */
+	AdVKRingBuffer::AdVKRingBuffer(AdVKDevice* device, VkBufferUsageFlags usage, VkDeviceSize sizePerFrame, uint32_t frameCount)
+		: mDevice(device), mUsage(usage) {
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(device->GetContext()->GetPhyDevice(), &props);
+		if (usage & VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT) {
+			mAlignment = std::max(mAlignment, props.limits.minUniformBufferOffsetAlignment);
+		}
+		if (usage & VK_BUFFER_USAGE_STORAGE_BUFFER_BIT) {
+			mAlignment = std::max(mAlignment, props.limits.minStorageBufferOffsetAlignment);
+		}
+
+		mFrameBuffers.resize(frameCount);
+		mFrameHighWater.resize(frameCount, 0);
+		for (uint32_t i = 0; i < frameCount; i++) {
+			CreateFrameBuffer(i, GetAlignedSize(sizePerFrame));
+		}
+	}
+
+	AdVKRingBuffer::~AdVKRingBuffer() {
+		mFrameBuffers.clear();
+	}
+
+	/**
+	 * @brief 开始新的一帧，重置当前槽位的写指针
+	 *
+	 * 若该槽位的容量小于 requiredSize 或上次使用时发生过溢出，则按需扩容。
+	 * 扩容只替换当前槽位的缓冲区，此时该槽位的帧围栏已被等待，旧缓冲区不再被 GPU 使用。
+	 *
+	 * @param frameIndex 当前帧槽位索引
+	 * @param requiredSize 本帧预计需要的总字节数（已按对齐计算），为0时仅参考历史用量
+	 * @return 当前槽位的缓冲区是否被重建（使用者需要重写引用该缓冲区的描述符集）
+	 */
+	bool AdVKRingBuffer::BeginFrame(uint32_t frameIndex, VkDeviceSize requiredSize) {
+		mCurrentFrame = frameIndex % static_cast<uint32_t>(mFrameBuffers.size());
+		mHead = 0;
+
+		VkDeviceSize targetSize = std::max(requiredSize, mFrameHighWater[mCurrentFrame]);
+		mFrameHighWater[mCurrentFrame] = 0;
+		if (targetSize <= GetFrameSize()) {
+			return false;
+		}
+
+		VkDeviceSize newSize = GetFrameSize();
+		while (newSize < targetSize) {
+			newSize *= 2;
+		}
+		LOG_D("{0}: frame {1} {2} -> {3} bytes", __FUNCTION__, mCurrentFrame, GetFrameSize(), newSize);
+		CreateFrameBuffer(mCurrentFrame, newSize);
+		return true;
+	}
+
+	/**
+	 * @brief 从当前帧槽位中分配一段对齐的切片
+	 *
+	 * @param size 切片大小
+	 * @param outOffset 切片在缓冲区中的偏移，用作动态偏移
+	 * @param outData 切片的映射地址，可直接写入
+	 * @return 是否分配成功；容量不足时返回false，并在该槽位下一次 BeginFrame 时扩容
+	 */
+	bool AdVKRingBuffer::Allocate(VkDeviceSize size, uint32_t* outOffset, void** outData) {
+		VkDeviceSize alignedSize = GetAlignedSize(size);
+		mFrameHighWater[mCurrentFrame] = std::max(mFrameHighWater[mCurrentFrame], mHead + alignedSize);
+		if (mHead + alignedSize > GetFrameSize()) {
+			LOG_E("Ring buffer overflow: frame {0}, request {1} bytes, used {2} / {3}", mCurrentFrame, size, mHead, GetFrameSize());
+			return false;
+		}
+
+		AdVKBuffer* buffer = mFrameBuffers[mCurrentFrame].get();
+		*outOffset = static_cast<uint32_t>(mHead);
+		*outData = static_cast<uint8_t*>(buffer->GetMappedData()) + mHead;
+		mHead += alignedSize;
+		return true;
+	}
+
+	VkBuffer AdVKRingBuffer::GetHandle() const {
+		return mFrameBuffers[mCurrentFrame]->GetHandle();
+	}
+
+	VkBuffer AdVKRingBuffer::GetHandle(uint32_t frameIndex) const {
+		return mFrameBuffers[frameIndex]->GetHandle();
+	}
+
+	VkDeviceSize AdVKRingBuffer::GetFrameSize() const {
+		return mFrameBuffers[mCurrentFrame]->GetSize();
+	}
+
+	void AdVKRingBuffer::CreateFrameBuffer(uint32_t frameIndex, VkDeviceSize size) {
+		mFrameBuffers[frameIndex] = std::make_shared<AdVKBuffer>(mDevice, mUsage, size, nullptr, true);
+	}
+}
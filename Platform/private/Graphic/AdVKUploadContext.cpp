@@ -0,0 +1,301 @@
+#include "Graphic/AdVKUploadContext.h"
+#include "Graphic/AdVKDevice.h"
+#include "Graphic/AdVKGraphicContext.h"
+#include "Graphic/AdVKQueue.h"
+#include "Graphic/AdVKBuffer.h"
+#include "Graphic/AdVKImage.h"
+#include "Graphic/AdVKCommandBuffer.h"
+
+namespace WuDu {
+	/**
+	 * @brief 构造上传上下文
+	 *
+	 * @param device 逻辑设备
+	 * @param queue 提交上传批次的队列（独立传输队列，或退回到图形队列）
+	 * @param queueFamilyIndex 队列所属的队列族，命令池在该队列族上创建
+	 */
+	AdVKUploadContext::AdVKUploadContext(AdVKDevice* device, AdVKQueue* queue, uint32_t queueFamilyIndex) : mDevice(device), mQueue(queue) {
+		mCmdPool = std::make_shared<AdVKCommandPool>(device, queueFamilyIndex);
+
+		// 缓冲区到图像的复制偏移需满足纹素大小与 optimalBufferCopyOffsetAlignment
+		VkPhysicalDeviceProperties props;
+		vkGetPhysicalDeviceProperties(device->GetContext()->GetPhyDevice(), &props);
+		mImageCopyAlignment = std::max<VkDeviceSize>(mImageCopyAlignment, props.limits.optimalBufferCopyOffsetAlignment);
+
+		LOG_T("Create upload context, queue family: {0}, dedicated transfer queue: {1}", queueFamilyIndex, device->GetContext()->HasDedicatedTransferQueueFamily());
+	}
+
+	AdVKUploadContext::~AdVKUploadContext() {
+		WaitIdle();
+
+		if (mRecordingBatch) {
+			RecycleBatch(std::move(mRecordingBatch));
+		}
+		for (const auto& batch : mFreeBatches) {
+			VK_D(Fence, mDevice->GetHandle(), batch->fence);
+		}
+		mFreeBatches.clear();
+		mFreeChunks.clear();
+		mCmdPool.reset();
+	}
+
+	/**
+	 * @brief 将数据上传到设备本地缓冲区
+	 *
+	 * @param dstBuffer 目标缓冲区，需要带有 TRANSFER_DST 用途
+	 * @param data 源数据，函数返回后即可释放
+	 * @param size 数据大小(字节)
+	 * @param dstOffset 目标缓冲区中的偏移
+	 * @return uint64_t 批次票据，IsComplete(ticket) 为 true 后目标缓冲区可用
+	 */
+	uint64_t AdVKUploadContext::UploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset) {
+		if (dstBuffer == VK_NULL_HANDLE || !data || size == 0) {
+			return 0;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		Batch* batch = GetRecordingBatch();
+
+		VkBuffer stageBuffer;
+		VkDeviceSize stageOffset;
+		void* stageData;
+		if (!AllocateStaging(batch, size, 16, &stageBuffer, &stageOffset, &stageData)) {
+			return 0;
+		}
+		memcpy(stageData, data, size);
+
+		VkBufferCopy bufferCopy = {
+			.srcOffset = stageOffset,
+			.dstOffset = dstOffset,
+			.size = size
+		};
+		vkCmdCopyBuffer(batch->cmdBuffer, stageBuffer, dstBuffer, 1, &bufferCopy);
+		batch->copyCount++;
+		mCopyCount++;
+		return batch->id;
+	}
+
+	/**
+	 * @brief 将像素数据上传到图像，并转换为着色器只读布局
+	 *
+	 * @param dstImage 目标图像，需要带有 TRANSFER_DST 用途，当前布局视为 UNDEFINED
+	 * @param data 紧密排列的像素数据
+	 * @param size 数据大小(字节)
+	 * @return uint64_t 批次票据
+	 */
+	uint64_t AdVKUploadContext::UploadImage(AdVKImage* dstImage, const void* data, VkDeviceSize size) {
+		if (!dstImage || dstImage->GetHandle() == VK_NULL_HANDLE || !data || size == 0) {
+			return 0;
+		}
+
+		std::lock_guard<std::mutex> lock(mMutex);
+		Batch* batch = GetRecordingBatch();
+
+		VkBuffer stageBuffer;
+		VkDeviceSize stageOffset;
+		void* stageData;
+		if (!AllocateStaging(batch, size, mImageCopyAlignment, &stageBuffer, &stageOffset, &stageData)) {
+			return 0;
+		}
+		memcpy(stageData, data, size);
+
+		// 传输队列只能使用传输相关的阶段与访问掩码，这里不复用 AdVKImage::TransitionLayout
+		VkImageMemoryBarrier barrier = {
+			.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			.pNext = nullptr,
+			.srcAccessMask = 0,
+			.dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+			.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED,
+			.newLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+			.image = dstImage->GetHandle(),
+			.subresourceRange = {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.baseMipLevel = 0,
+				.levelCount = 1,
+				.baseArrayLayer = 0,
+				.layerCount = 1
+			}
+		};
+		vkCmdPipelineBarrier(batch->cmdBuffer, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		VkExtent3D extent = dstImage->GetExtent();
+		VkBufferImageCopy region = {
+			.bufferOffset = stageOffset,
+			.bufferRowLength = extent.width,
+			.bufferImageHeight = extent.height,
+			.imageSubresource = {
+				.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT,
+				.mipLevel = 0,
+				.baseArrayLayer = 0,
+				.layerCount = 1
+			},
+			.imageOffset = { 0, 0, 0 },
+			.imageExtent = { extent.width, extent.height, 1 }
+		};
+		vkCmdCopyBufferToImage(batch->cmdBuffer, stageBuffer, dstImage->GetHandle(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+		// 布局转换在上传批次内完成；图形队列在围栏触发（资源就绪）之后才会采样该图像
+		barrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		barrier.dstAccessMask = 0;
+		barrier.oldLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+		barrier.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		vkCmdPipelineBarrier(batch->cmdBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			0, 0, nullptr, 0, nullptr, 1, &barrier);
+
+		batch->copyCount++;
+		mCopyCount++;
+		return batch->id;
+	}
+
+	uint64_t AdVKUploadContext::Flush() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		return FlushLocked();
+	}
+
+	void AdVKUploadContext::Update() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		RetireBatches(false, 0);
+	}
+
+	void AdVKUploadContext::Wait(uint64_t ticket) {
+		if (IsComplete(ticket)) {
+			return;
+		}
+		std::lock_guard<std::mutex> lock(mMutex);
+		if (mRecordingBatch && ticket >= mRecordingBatch->id) {
+			FlushLocked();
+		}
+		RetireBatches(true, ticket);
+	}
+
+	void AdVKUploadContext::WaitIdle() {
+		std::lock_guard<std::mutex> lock(mMutex);
+		uint64_t ticket = FlushLocked();
+		RetireBatches(true, ticket);
+	}
+
+	/**
+	 * @brief 获取当前录制中的批次，没有时从空闲列表复用或新建，并开始录制命令缓冲
+	 */
+	AdVKUploadContext::Batch* AdVKUploadContext::GetRecordingBatch() {
+		if (mRecordingBatch) {
+			return mRecordingBatch.get();
+		}
+
+		if (!mFreeBatches.empty()) {
+			mRecordingBatch = std::move(mFreeBatches.back());
+			mFreeBatches.pop_back();
+		}
+		else {
+			mRecordingBatch = std::make_unique<Batch>();
+			mRecordingBatch->cmdBuffer = mCmdPool->AllocateOneCommandBuffer();
+			VkFenceCreateInfo fenceInfo = {
+				.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO,
+				.pNext = nullptr,
+				.flags = 0
+			};
+			CALL_VK(vkCreateFence(mDevice->GetHandle(), &fenceInfo, nullptr, &mRecordingBatch->fence));
+		}
+
+		mRecordingBatch->id = mNextBatchId++;
+		AdVKCommandPool::BeginCommandBuffer(mRecordingBatch->cmdBuffer);
+		return mRecordingBatch.get();
+	}
+
+	/**
+	 * @brief 在批次的暂存区块中线性分配空间，当前区块不足时启用新的区块
+	 */
+	bool AdVKUploadContext::AllocateStaging(Batch* batch, VkDeviceSize size, VkDeviceSize alignment, VkBuffer* outBuffer, VkDeviceSize* outOffset, void** outData) {
+		if (!batch->chunks.empty()) {
+			StagingChunk& chunk = batch->chunks.back();
+			VkDeviceSize offset = (chunk.usedSize + alignment - 1) / alignment * alignment;
+			if (offset + size <= chunk.buffer->GetSize()) {
+				chunk.usedSize = offset + size;
+				*outBuffer = chunk.buffer->GetHandle();
+				*outOffset = offset;
+				*outData = static_cast<uint8_t*>(chunk.buffer->GetMappedData()) + offset;
+				return true;
+			}
+		}
+
+		std::shared_ptr<AdVKBuffer> buffer;
+		if (size <= AD_VK_UPLOAD_STAGING_CHUNK_SIZE && !mFreeChunks.empty()) {
+			buffer = mFreeChunks.back();
+			mFreeChunks.pop_back();
+		}
+		else {
+			VkDeviceSize chunkSize = std::max<VkDeviceSize>(size, AD_VK_UPLOAD_STAGING_CHUNK_SIZE);
+			buffer = std::make_shared<AdVKBuffer>(mDevice, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, chunkSize, nullptr, true);
+		}
+		if (!buffer->GetMappedData()) {
+			LOG_E("Failed to allocate {0} bytes of upload staging memory", size);
+			return false;
+		}
+
+		batch->chunks.push_back({ buffer, size });
+		*outBuffer = buffer->GetHandle();
+		*outOffset = 0;
+		*outData = buffer->GetMappedData();
+		return true;
+	}
+
+	/**
+	 * @brief 结束并提交录制中的批次，整批只触发一次队列提交
+	 */
+	uint64_t AdVKUploadContext::FlushLocked() {
+		if (!mRecordingBatch) {
+			return mSubmittedBatchId;
+		}
+
+		std::unique_ptr<Batch> batch = std::move(mRecordingBatch);
+		AdVKCommandPool::EndCommandBuffer(batch->cmdBuffer);
+		mQueue->Submit({ batch->cmdBuffer }, {}, {}, batch->fence);
+
+		mSubmittedBatchId = batch->id;
+		mSubmitCount++;
+		mInFlightBatches.push_back(std::move(batch));
+		return mSubmittedBatchId;
+	}
+
+	/**
+	 * @brief 按提交顺序回收已完成的批次，并推进已完成票据
+	 *
+	 * @param bWait 为 true 时阻塞等待，直到票据 ticket 及之前的批次全部完成
+	 */
+	void AdVKUploadContext::RetireBatches(bool bWait, uint64_t ticket) {
+		while (!mInFlightBatches.empty()) {
+			Batch* batch = mInFlightBatches.front().get();
+			if (bWait && batch->id <= ticket) {
+				CALL_VK(vkWaitForFences(mDevice->GetHandle(), 1, &batch->fence, VK_TRUE, UINT64_MAX));
+			}
+			else if (vkGetFenceStatus(mDevice->GetHandle(), batch->fence) != VK_SUCCESS) {
+				break;
+			}
+
+			mCompletedBatchId = batch->id;
+			std::unique_ptr<Batch> finished = std::move(mInFlightBatches.front());
+			mInFlightBatches.pop_front();
+			RecycleBatch(std::move(finished));
+		}
+	}
+
+	/**
+	 * @brief 重置批次的命令缓冲与围栏，回收常规大小的暂存区块
+	 */
+	void AdVKUploadContext::RecycleBatch(std::unique_ptr<Batch> batch) {
+		for (auto& chunk : batch->chunks) {
+			if (chunk.buffer->GetSize() == AD_VK_UPLOAD_STAGING_CHUNK_SIZE && mFreeChunks.size() < AD_VK_UPLOAD_MAX_FREE_CHUNKS) {
+				mFreeChunks.push_back(chunk.buffer);
+			}
+		}
+		batch->chunks.clear();
+		batch->copyCount = 0;
+
+		CALL_VK(vkResetCommandBuffer(batch->cmdBuffer, 0));
+		CALL_VK(vkResetFences(mDevice->GetHandle(), 1, &batch->fence));
+		mFreeBatches.push_back(std::move(batch));
+	}
+}
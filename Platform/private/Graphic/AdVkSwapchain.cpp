@@ -240,10 +240,8 @@ namespace WuDu {
 		};
 
 		// 提交呈现请求到队列
-		VkResult ret = vkQueuePresentKHR(mDevice->GetFirstPresentQueue()->GetHandle(), &presentInfo);
-
-		// 等待呈现队列空闲，确保呈现操作完成
-		mDevice->GetFirstPresentQueue()->WaitIdle();
+		// 不再等待呈现队列空闲，帧间同步交由渲染器的帧围栏完成
+		VkResult ret = mDevice->GetFirstPresentQueue()->Present(presentInfo);
 
 		return ret;
 	}
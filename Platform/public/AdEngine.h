@@ -16,6 +16,7 @@
 #include<queue>
 #include<deque>
 #include<set>
+#include<map>
 #include<unordered_map>
 #include<unordered_set>
 #include <limits>
@@ -23,6 +24,9 @@
 #include <string_view>
 #include <random>
 #include<mutex>
+#include<thread>
+#include<future>
+#include<condition_variable>
 #include<optional>
 
 
@@ -14,6 +14,27 @@ namespace WuDu {
                 glm::vec3 Bitangent;
         };
 
+        // 网格的顶点布局，材质系统按布局选择顶点输入与管线；AdVertex 与 ModelVertex 同为 56 字节但成员顺序不同
+        enum class AdVertexFormat {
+                Float,          // AdVertex 浮点布局
+                Model,          // ModelVertex 浮点布局(模型导入)
+                Packed,         // AdPackedVertex 量化布局
+        };
+#define AD_VERTEX_FORMAT_COUNT          3
+
+        /**
+         * 量化顶点，20 字节(ModelVertex 为 56 字节)
+         * Position: SNORM16，xyz 为相对网格包围盒的归一化坐标，需乘以网格的解量化变换；w 为副切线符号(+1/-1)
+         * Normal / Tangent: 八面体编码的单位向量，SNORM16
+         * TexCoord: 半精度浮点
+         */
+        struct AdPackedVertex {
+                int16_t Position[4];
+                int16_t Normal[2];
+                int16_t Tangent[2];
+                uint16_t TexCoord[2];
+        };
+
         class AdGeometryUtil {
         public:
                 /**
@@ -33,6 +54,52 @@ namespace WuDu {
                         std::vector<AdVertex>& vertices, std::vector<uint32_t>& indices, const bool bUseTextcoords = true,
                         const bool bUseNormals = true, const glm::mat4& relativeMat = glm::mat4(1.0f));
 
+                /**
+                 * Compute bounds of vertex positions, Position must be the first member of the vertex
+                 * @param vertices      vertex data
+                 * @param vertexStride  size of one vertex in bytes
+                 * @param vertexCount   vertex count
+                 * @param outMin        out aabb min
+                 * @param outMax        out aabb max
+                 * @param outSphere     out bounding sphere, xyz --> center (aabb center), w --> radius
+                 */
+                static void ComputeBounds(const void* vertices, uint32_t vertexStride, uint32_t vertexCount,
+                        glm::vec3& outMin, glm::vec3& outMax, glm::vec4& outSphere);
+
+                /**
+                 * Quantize vertices to AdPackedVertex, vertex type needs Position/Normal/TexCoord/Tangent/Bitangent members
+                 * @param vertices      source vertices
+                 * @param outVertices   out packed vertices
+                 * @return dequantize parameters, xyz --> center, w --> uniform scale, position = packed.xyz * w + xyz
+                 */
+                template<typename T>
+                static glm::vec4 PackVertices(const std::vector<T>& vertices, std::vector<AdPackedVertex>& outVertices) {
+                        outVertices.resize(vertices.size());
+                        if (vertices.empty()) {
+                                return glm::vec4(0.f, 0.f, 0.f, 1.f);
+                        }
+                        glm::vec3 boundsMin;
+                        glm::vec3 boundsMax;
+                        glm::vec4 sphere;
+                        ComputeBounds(vertices.data(), sizeof(T), static_cast<uint32_t>(vertices.size()), boundsMin, boundsMax, sphere);
+                        // 统一缩放：解量化变换保持各向同性，法线无需额外的逆转置修正
+                        glm::vec3 halfExtent = (boundsMax - boundsMin) * 0.5f;
+                        float scale = std::max(halfExtent.x, std::max(halfExtent.y, halfExtent.z));
+                        glm::vec4 dequantize(glm::vec3(sphere), scale > 0.f ? scale : 1.f);
+                        for (size_t i = 0; i < vertices.size(); i++) {
+                                const T& v = vertices[i];
+                                PackVertex(v.Position, v.Normal, v.TexCoord, v.Tangent, v.Bitangent, dequantize, outVertices[i]);
+                        }
+                        return dequantize;
+                }
+
+                static void PackVertex(const glm::vec3& position, const glm::vec3& normal, const glm::vec2& texCoord,
+                        const glm::vec3& tangent, const glm::vec3& bitangent, const glm::vec4& dequantize, AdPackedVertex& outVertex);
+
+                // 单位向量八面体编码/解码，结果在 [-1, 1]
+                static glm::vec2 OctEncode(const glm::vec3& n);
+                static glm::vec3 OctDecode(const glm::vec2& e);
+
         };
 }
 #endif
\ No newline at end of file
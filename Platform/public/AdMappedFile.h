@@ -0,0 +1,37 @@
+#ifndef AD_MAPPEDFILE_H
+#define AD_MAPPEDFILE_H
+
+#include "AdEngine.h"
+
+namespace WuDu {
+	/**
+	 * @brief 只读内存映射文件
+	 *
+	 * 文件内容直接映射到进程地址空间，由操作系统按页读入，读取方不需要分配缓冲区或逐段 read。
+	 * 映射在对象析构或 Close 时解除，期间 GetData 返回的指针一直有效。
+	 */
+	class AdMappedFile {
+	public:
+		AdMappedFile() = default;
+		~AdMappedFile();
+
+		AdMappedFile(const AdMappedFile&) = delete;
+		AdMappedFile& operator=(const AdMappedFile&) = delete;
+
+		bool Open(const std::string& filePath);
+		void Close();
+
+		bool IsOpen() const { return mData != nullptr; }
+		const uint8_t* GetData() const { return mData; }
+		size_t GetSize() const { return mSize; }
+	private:
+		const uint8_t* mData = nullptr;
+		size_t mSize = 0;
+#ifdef AD_ENGINE_PLATFORM_WIN32
+		void* mFileHandle = nullptr;
+		void* mMappingHandle = nullptr;
+#endif
+	};
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef AD_THREADPOOL_H
+#define AD_THREADPOOL_H
+
+#include "AdEngine.h"
+
+namespace WuDu {
+	/**
+	 * @brief 引擎全局工作线程池
+	 *
+	 * 固定数量的工作线程消费一个先进先出的任务队列，用于管线编译、资源加载等
+	 * 不依赖渲染线程的耗时任务。提交的任务返回 std::future，可用于等待结果。
+	 */
+	class AdThreadPool {
+	public:
+		AdThreadPool(const AdThreadPool&) = delete;
+		AdThreadPool& operator=(const AdThreadPool&) = delete;
+
+		static AdThreadPool* GetInstance();
+
+		~AdThreadPool();
+
+		template<typename F>
+		auto Submit(F&& func) -> std::future<decltype(func())> {
+			using ResultType = decltype(func());
+			auto task = std::make_shared<std::packaged_task<ResultType()>>(std::forward<F>(func));
+			std::future<ResultType> future = task->get_future();
+			Enqueue([task]() { (*task)(); });
+			return future;
+		}
+
+		/**
+		 * @brief 并行执行 func(0) ... func(count - 1)，返回时全部执行完毕
+		 *
+		 * 调用线程与工作线程一起从共享计数器领取下标。调用线程领完后只等待已被领取的下标，
+		 * 不等待仍在队列中的辅助任务，因此可以在工作线程内调用(例如异步资源加载中)而不会死锁。
+		 */
+		template<typename F>
+		void ParallelFor(uint32_t count, F&& func) {
+			if (count == 0) {
+				return;
+			}
+			struct ParallelState {
+				std::function<void(uint32_t)> func;
+				uint32_t count;
+				std::atomic<uint32_t> next{ 0 };
+				uint32_t done = 0;
+				std::mutex mutex;
+				std::condition_variable condition;
+
+				void Run() {
+					uint32_t finished = 0;
+					for (uint32_t index = next.fetch_add(1); index < count; index = next.fetch_add(1)) {
+						func(index);
+						finished++;
+					}
+					if (finished > 0) {
+						std::lock_guard<std::mutex> lock(mutex);
+						done += finished;
+						if (done == count) {
+							condition.notify_all();
+						}
+					}
+				}
+			};
+			auto state = std::make_shared<ParallelState>();
+			state->func = std::forward<F>(func);
+			state->count = count;
+
+			uint32_t helperCount = std::min(GetWorkerCount(), count - 1);
+			for (uint32_t i = 0; i < helperCount; i++) {
+				Enqueue([state]() { state->Run(); });
+			}
+			state->Run();
+
+			std::unique_lock<std::mutex> lock(state->mutex);
+			state->condition.wait(lock, [&state]() { return state->done == state->count; });
+		}
+
+		uint32_t GetWorkerCount() const { return static_cast<uint32_t>(mWorkers.size()); }
+	private:
+		explicit AdThreadPool(uint32_t workerCount);
+
+		void Enqueue(std::function<void()> job);
+		void WorkerLoop();
+
+		std::vector<std::thread> mWorkers;
+		std::queue<std::function<void()>> mJobs;
+		std::mutex mMutex;
+		std::condition_variable mCondition;
+		bool bStop = false;
+	};
+}
+
+#endif
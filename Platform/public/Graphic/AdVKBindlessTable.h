@@ -0,0 +1,71 @@
+#ifndef AD_VKBINDLESSTABLE_H
+#define AD_VKBINDLESSTABLE_H
+
+#include "AdVKCommon.h"
+
+namespace WuDu {
+	class AdVKDevice;
+	class AdVKDescriptorSetLayout;
+	class AdVKDescriptorPool;
+
+#define AD_VK_BINDLESS_MAX_TEXTURES         4096        // 纹理数组容量，受设备 update-after-bind 限制进一步裁剪
+#define AD_VK_BINDLESS_MAX_SAMPLERS         64          // 采样器数组容量
+#define AD_VK_BINDLESS_INVALID_INDEX        UINT32_MAX
+
+	/**
+	 * @brief 全局无绑定(bindless)资源表
+	 *
+	 * 基于 descriptor indexing：一个 update-after-bind 描述符集，binding 0 为所有纹理的采样图像数组，
+	 * binding 1 为所有采样器数组。纹理与采样器创建时注册得到一个索引，着色器通过材质数据中的索引访问，
+	 * 因此每条管线每帧只需绑定一次该描述符集。
+	 *
+	 * 释放的索引要在所有在途帧都结束后才能复用，每帧开始时调用 Update 推进回收。
+	 * 所有公开接口线程安全。
+	 */
+	class AdVKBindlessTable {
+	public:
+		AdVKBindlessTable(AdVKDevice* device, uint32_t framesInFlight);
+		~AdVKBindlessTable();
+
+		uint32_t RegisterTexture(VkImageView imageView);
+		void ReleaseTexture(uint32_t index);
+		uint32_t RegisterSampler(VkSampler sampler);
+		void ReleaseSampler(uint32_t index);
+
+		// 每帧开始时调用，回收已不再被在途帧引用的索引
+		void Update();
+
+		AdVKDescriptorSetLayout* GetDescriptorSetLayout() const { return mDescSetLayout.get(); }
+		VkDescriptorSet GetDescriptorSet() const { return mDescSet; }
+		uint32_t GetTextureCount() const;
+		uint32_t GetSamplerCount() const;
+	private:
+		struct SlotList {
+			uint32_t capacity = 0;
+			uint32_t nextIndex = 0;
+			std::vector<uint32_t> freeIndices;
+			std::deque<std::pair<uint32_t, uint64_t>> pendingIndices;     // 索引与释放时的帧号
+
+			uint32_t Acquire();
+			void Release(uint32_t index, uint64_t frame);
+			void Retire(uint64_t completedFrame);
+			uint32_t GetUsedCount() const { return nextIndex - static_cast<uint32_t>(freeIndices.size() + pendingIndices.size()); }
+		};
+
+		void WriteDescriptor(uint32_t binding, uint32_t index, VkDescriptorType type, const VkDescriptorImageInfo& imageInfo);
+
+		AdVKDevice* mDevice;
+		uint32_t mFramesInFlight;
+		uint64_t mFrameCounter = 0;
+
+		std::shared_ptr<AdVKDescriptorSetLayout> mDescSetLayout;
+		std::shared_ptr<AdVKDescriptorPool> mDescPool;
+		VkDescriptorSet mDescSet = VK_NULL_HANDLE;
+
+		SlotList mTextureSlots;
+		SlotList mSamplerSlots;
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
@@ -2,6 +2,7 @@
 #define AD_VKBUFFER_H
 
 #include "AdVKCommon.h"
+#include "AdVKMemoryAllocator.h"
 
 namespace WuDu {
         class AdVKDevice;
@@ -11,23 +12,30 @@ namespace WuDu {
                 AdVKBuffer(AdVKDevice* device, VkBufferUsageFlags usage, size_t size, void* data = nullptr, bool bHostVisible = false);
                 ~AdVKBuffer();
 
-                static void CreateBufferInternal(AdVKDevice* device, VkMemoryPropertyFlags memProps, VkBufferUsageFlags usage, size_t size, VkBuffer* outBuffer, VkDeviceMemory* outMemory);
+                static void CreateBufferInternal(AdVKDevice* device, VkMemoryPropertyFlags memProps, VkBufferUsageFlags usage, size_t size, VkBuffer* outBuffer, AdVKAllocation* outAllocation);
                 static void CopyToBuffer(AdVKDevice* device, VkBuffer srcBuffer, VkBuffer dstBuffer, size_t size);
 
                 VkResult WriteData(void* data);
 
                 VkBuffer GetHandle() const { return mHandle; }
                 size_t GetSize() const { return mSize; }
-                VkDeviceMemory GetMemory() const { return mMemory; }
+                VkDeviceMemory GetMemory() const { return mAllocation.memory; }
+                VkDeviceSize GetMemoryOffset() const { return mAllocation.offset; }
+                void* GetMappedData() const { return mAllocation.mappedData; }
+
+                // 设备本地缓冲区的初始数据通过上传上下文异步写入，上传批次完成后才可被 GPU 读取
+                bool IsReady() const;
+                void WaitReady() const;
         private:
                 void CreateBuffer(VkBufferUsageFlags usage, void* data);
 
                 VkBuffer mHandle = VK_NULL_HANDLE;
-                VkDeviceMemory mMemory = VK_NULL_HANDLE;
+                AdVKAllocation mAllocation;
 
                 AdVKDevice* mDevice;
                 size_t mSize;
                 bool bHostVisible;
+                uint64_t mUploadTicket = 0;
         };
 }
 #endif
\ No newline at end of file
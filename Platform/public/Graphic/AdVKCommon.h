@@ -489,6 +489,27 @@ static void check_vk_result(VkResult result, const char* fileName, uint32_t line
 	}
 }
 
+// FNV-1a 哈希，用于管线状态、渲染通道兼容性等 POD 数据生成缓存键
+static uint64_t HashBytes(const void* data, size_t size, uint64_t seed = 14695981039346656037ull) {
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; i++) {
+		seed ^= bytes[i];
+		seed *= 1099511628211ull;
+	}
+	return seed;
+}
+
+template<typename T>
+static uint64_t HashValue(const T& value, uint64_t seed) {
+	return HashBytes(&value, sizeof(T), seed);
+}
+
+template<typename T>
+static uint64_t HashVector(const std::vector<T>& values, uint64_t seed) {
+	seed = HashValue(values.size(), seed);
+	return values.empty() ? seed : HashBytes(values.data(), values.size() * sizeof(T), seed);
+}
+
 static bool IsDepthOnlyFormat(VkFormat format) {
 	return format == VK_FORMAT_D16_UNORM || format == VK_FORMAT_D32_SFLOAT;
 }
@@ -0,0 +1,39 @@
+#ifndef AD_VKCOMPUTEPIPELINE_H
+#define AD_VKCOMPUTEPIPELINE_H
+
+#include "AdVKPipeline.h"
+
+namespace WuDu {
+	/**
+	 * @brief Vulkan计算管线，持有计算着色器模块、管线布局与管线对象
+	 *
+	 * 计算管线只有一个着色器阶段且没有固定功能状态，构造时直接在调用线程上编译（经过设备的管道缓存）。
+	 */
+	class AdVKComputePipeline {
+	public:
+		/**
+		 * @brief 构造函数，创建计算着色器模块、管线布局与计算管线
+		 * @param device 指向Vulkan设备对象的指针
+		 * @param computeShaderFile 计算着色器文件路径（不包含.spv扩展名）
+		 * @param shaderLayout 着色器布局信息（描述符集布局和推送常量范围）
+		 */
+		AdVKComputePipeline(AdVKDevice* device, const std::string& computeShaderFile, const ShaderLayout& shaderLayout = {});
+		~AdVKComputePipeline();
+
+		VkPipeline GetHandle() const { return mHandle; }
+		VkPipelineLayout GetLayout() const { return mLayout; }
+
+		/**
+		 * @brief 绑定计算管线到命令缓冲区
+		 * @param cmdBuffer 命令缓冲区句柄
+		 */
+		void Bind(VkCommandBuffer cmdBuffer) const;
+	private:
+		VkPipeline mHandle = VK_NULL_HANDLE;
+		VkPipelineLayout mLayout = VK_NULL_HANDLE;
+		VkShaderModule mShaderModule = VK_NULL_HANDLE;
+		AdVKDevice* mDevice;
+	};
+}
+
+#endif
@@ -9,7 +9,7 @@ namespace WuDu {
 
 	class AdVKDescriptorSetLayout {
 	public:
-		AdVKDescriptorSetLayout(AdVKDevice* device, const std::vector<VkDescriptorSetLayoutBinding>& bindings);
+		AdVKDescriptorSetLayout(AdVKDevice* device, const std::vector<VkDescriptorSetLayoutBinding>& bindings, const std::vector<VkDescriptorBindingFlags>& bindingFlags = {});
 		~AdVKDescriptorSetLayout();
 
 		VkDescriptorSetLayout GetHandle() const { return mHandle; }
@@ -21,7 +21,7 @@ namespace WuDu {
 
 	class AdVKDescriptorPool {
 	public:
-		AdVKDescriptorPool(AdVKDevice* device, uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes);
+		AdVKDescriptorPool(AdVKDevice* device, uint32_t maxSets, const std::vector<VkDescriptorPoolSize>& poolSizes, VkDescriptorPoolCreateFlags flags = 0);
 		VkDescriptorPool GetHandle() const { return mHandle; }
 		~AdVKDescriptorPool();
 
@@ -32,6 +32,55 @@ namespace WuDu {
 		AdVKDevice* mDevice;
 	};
 
+#define AD_VK_DESCRIPTOR_POOL_INIT_SETS     64          // 第一个描述符池可分配的描述符集数量
+#define AD_VK_DESCRIPTOR_POOL_MAX_SETS      4096        // 单个描述符池容量的上限，达到后新池不再倍增
+
+	/**
+	 * @brief 可增长的描述符集分配器
+	 *
+	 * 维护一条描述符池链：当前池耗尽时创建一个新池（容量倍增直到上限）继续分配，
+	 * 已分配的描述符集始终保持有效，不需要重建或重写。
+	 * 释放的描述符集按布局放回空闲列表，之后相同布局的分配优先复用，内容需由使用者重写。
+	 * 布局销毁后其描述符集不能再更新，且驱动可能把同一句柄值分给新的布局，
+	 * 因此布局析构时通过 ReleaseLayout 把该布局的空闲描述符集归还给各自的池。
+	 * 池中各类描述符的数量按“每个描述符集平均需要的数量(ratio) x 描述符集数量”计算。
+	 *
+	 * 所有公开接口线程安全。
+	 */
+	class AdVKDescriptorAllocator {
+	public:
+		struct PoolSizeRatio {
+			VkDescriptorType type;
+			float ratio;
+		};
+
+		AdVKDescriptorAllocator(AdVKDevice* device, const std::vector<PoolSizeRatio>& ratios, uint32_t initSetCount = AD_VK_DESCRIPTOR_POOL_INIT_SETS);
+		~AdVKDescriptorAllocator();
+
+		VkDescriptorSet Allocate(AdVKDescriptorSetLayout* setLayout);
+		std::vector<VkDescriptorSet> Allocate(AdVKDescriptorSetLayout* setLayout, uint32_t count);
+		// 调用者需保证描述符集已不再被在途帧引用
+		void Free(AdVKDescriptorSetLayout* setLayout, const std::vector<VkDescriptorSet>& descSets);
+		// 由 AdVKDescriptorSetLayout 析构时调用，将该布局的空闲描述符集归还给各自的池
+		void ReleaseLayout(VkDescriptorSetLayout setLayout);
+
+		uint32_t GetPoolCount() const;
+		uint64_t GetAllocatedSetCount() const { return mAllocatedSetCount; }
+	private:
+		void CreatePool();
+		VkResult AllocateFromPool(VkDescriptorPool pool, VkDescriptorSetLayout setLayout, VkDescriptorSet* outSet);
+
+		AdVKDevice* mDevice;
+		std::vector<PoolSizeRatio> mRatios;
+		uint32_t mNextSetCount;
+
+		std::vector<std::shared_ptr<AdVKDescriptorPool>> mPools;       // 最后一个为当前分配的池
+		std::unordered_map<VkDescriptorSetLayout, std::vector<VkDescriptorSet>> mFreeSets;
+		std::unordered_map<VkDescriptorSet, VkDescriptorPool> mSetPools;                // 描述符集所属的池，归还时使用
+		std::atomic<uint64_t> mAllocatedSetCount = 0;
+		mutable std::mutex mMutex;
+	};
+
 	class DescriptorSetWriter {
 	public:
 		static VkDescriptorBufferInfo BuildBufferInfo(VkBuffer buffer, VkDeviceSize offset, VkDeviceSize range) {
@@ -80,7 +129,13 @@ namespace WuDu {
 		}
 		static void UpdateDescriptorSets(VkDevice device, const std::vector<VkWriteDescriptorSet>& writes) {
 			vkUpdateDescriptorSets(device, writes.size(), writes.data(), 0, nullptr);
+			sWriteCount += writes.size();
 		}
+
+		// 累计写入的描述符数量，用于统计每帧的描述符更新开销
+		static uint64_t GetWriteCount() { return sWriteCount; }
+	private:
+		inline static std::atomic<uint64_t> sWriteCount = 0;
 	};
 }
 
@@ -8,6 +8,11 @@ namespace WuDu {
 	class AdVKGraphicContext;
 	class AdVKQueue;
 	class AdVKCommandPool;
+	class AdVKMemoryAllocator;
+	class AdVKUploadContext;
+	class AdVKPipelineRegistry;
+	class AdVKDescriptorAllocator;
+	class AdVKBindlessTable;
 
 	/**
 	* AdVkSettings结构体用于存储Vulkan渲染设备的配置参数。
@@ -25,6 +30,9 @@ namespace WuDu {
 
 		// swapchainImageCount表示交换链图像的数量，默认值为3，通常使用triple buffering来平衡响应性和性能。
 		uint32_t swapchainImageCount = 3;
+
+		// framesInFlight表示CPU可以领先GPU录制的最大帧数(延迟深度)，每一帧拥有独立的命令缓冲、Uniform缓冲和描述符集，仅由帧围栏同步。
+		uint32_t framesInFlight = 2;
 	};
 	class AdVKDevice {
 	public:
@@ -32,21 +40,49 @@ namespace WuDu {
 		~AdVKDevice();
 
 		VkDevice GetHandle() const { return mHandle; }
+		AdVKGraphicContext* GetContext() const { return mContext; }
 
 		const AdVkSettings& GetSettings() const { return mSettings; }
 		VkPipelineCache GetPipelineCache() const { return mPipelineCache; }
+		// 管道缓存是否从磁盘加载成功（热启动）
+		bool IsPipelineCacheWarm() const { return bPipelineCacheWarm; }
+		void SavePipelineCache() const;
+		// 管道创建耗时统计，用于对比冷/热启动
+		void AddPipelineCreateTime(uint64_t microseconds) { mPipelineCreateCount++; mPipelineCreateTimeUs += microseconds; }
+		uint32_t GetPipelineCreateCount() const { return mPipelineCreateCount; }
+		float GetPipelineCreateTimeMs() const { return mPipelineCreateTimeUs / 1000.f; }
 
 		AdVKQueue* GetGraphicQueue(uint32_t index) const { return mGraphicQueues.size() < index + 1 ? nullptr : mGraphicQueues[index].get(); };
 		AdVKQueue* GetFirstGraphicQueue() const { return mGraphicQueues.empty() ? nullptr : mGraphicQueues[0].get(); };
 		AdVKQueue* GetPresentQueue(uint32_t index) const { return mPresentQueues.size() < index + 1 ? nullptr : mPresentQueues[index].get(); };
 		AdVKQueue* GetFirstPresentQueue() const { return mPresentQueues.empty() ? nullptr : mPresentQueues[0].get(); };
+		// 没有独立传输队列族时退回到第一个图形队列
+		AdVKQueue* GetTransferQueue() const { return mTransferQueue ? mTransferQueue.get() : GetFirstGraphicQueue(); }
+		uint32_t GetTransferQueueFamilyIndex() const;
+		// 上传目标资源需要在这些队列族间共享（CONCURRENT），只有一个元素时使用 EXCLUSIVE
+		const std::vector<uint32_t>& GetUploadQueueFamilyIndices() const { return mUploadQueueFamilyIndices; }
 		AdVKCommandPool* GetDefaultCmdPool() const { return mDefaultCmdPool.get(); }
+		AdVKMemoryAllocator* GetMemoryAllocator() const { return mMemoryAllocator.get(); }
+		AdVKUploadContext* GetUploadContext() const { return mUploadContext.get(); }
+		AdVKPipelineRegistry* GetPipelineRegistry() const { return mPipelineRegistry.get(); }
+		// 各渲染系统共享的可增长描述符集分配器
+		AdVKDescriptorAllocator* GetDescriptorAllocator() const { return mDescriptorAllocator.get(); }
+		// 设备支持 descriptor indexing 时可用的无绑定资源表，不支持时为空
+		bool IsBindlessSupported() const { return mBindlessTable != nullptr; }
+		AdVKBindlessTable* GetBindlessTable() const { return mBindlessTable.get(); }
+		// 间接绘制能力：多条间接命令与 firstInstance（GPU 驱动渲染的前提），以及 GPU 写入的绘制数量
+		bool IsMultiDrawIndirectSupported() const { return bMultiDrawIndirect; }
+		bool IsDrawIndirectCountSupported() const { return bDrawIndirectCount; }
 
 		int32_t GetMemoryIndex(VkMemoryPropertyFlags memProps, uint32_t memoryTypeBits) const;
 		VkCommandBuffer CreateAndBeginOneCmdBuffer();
 		void SubmitOneCmdBuffer(VkCommandBuffer cmdBuffer);
 
 		VkResult CreateSimpleSampler(VkFilter filter, VkSamplerAddressMode addressMode, VkSampler* outSampler);
+
+		// 等待设备空闲（全设备同步），并累计调用次数用于统计每帧的停顿情况
+		void WaitIdle();
+		uint64_t GetWaitIdleCount() const { return mWaitIdleCount; }
 	private:
 		void CreatePipelineCache();
 		void CreateDefaultCmdPool();
@@ -56,11 +92,25 @@ namespace WuDu {
 
 		std::vector<std::shared_ptr<AdVKQueue>> mGraphicQueues;
 		std::vector<std::shared_ptr<AdVKQueue>> mPresentQueues;
+		std::shared_ptr<AdVKQueue> mTransferQueue;
+		std::vector<uint32_t> mUploadQueueFamilyIndices;
 		std::shared_ptr<AdVKCommandPool> mDefaultCmdPool;
+		std::shared_ptr<AdVKMemoryAllocator> mMemoryAllocator;
+		std::shared_ptr<AdVKUploadContext> mUploadContext;
+		std::shared_ptr<AdVKPipelineRegistry> mPipelineRegistry;
+		std::shared_ptr<AdVKDescriptorAllocator> mDescriptorAllocator;
+		std::shared_ptr<AdVKBindlessTable> mBindlessTable;
 
 		AdVkSettings mSettings;
 
 		VkPipelineCache mPipelineCache = VK_NULL_HANDLE;
+		bool bPipelineCacheWarm = false;
+		bool bMultiDrawIndirect = false;
+		bool bDrawIndirectCount = false;
+		std::atomic<uint32_t> mPipelineCreateCount = 0;
+		std::atomic<uint64_t> mPipelineCreateTimeUs = 0;
+
+		std::atomic<uint64_t> mWaitIdleCount = 0;
 	};
 }
 
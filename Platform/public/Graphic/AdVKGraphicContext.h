@@ -20,11 +20,15 @@ namespace WuDu {
 		VkPhysicalDevice GetPhyDevice() const { return mPhyDevice; }
 		const QueueFamilyInfo& GetGraphicQueueFamilyInfo() const { return mGraphicQueueFamily; }
 		const QueueFamilyInfo& GetPresentQueueFamilyInfo() const { return mPresentQueueFamily; }
+		const QueueFamilyInfo& GetTransferQueueFamilyInfo() const { return mTransferQueueFamily; }
 		VkPhysicalDeviceMemoryProperties GetPhyDeviceMemProperties() const { return mPhyDeviceMemProperties; }
 		bool IsSameGraphicPresentQueueFamily() const { return mGraphicQueueFamily.queueFamilyIndex == mPresentQueueFamily.queueFamilyIndex; }
+		// 是否存在独立于图形队列族的传输队列族（用于异步上传）
+		bool HasDedicatedTransferQueueFamily() const { return mTransferQueueFamily.queueFamilyIndex >= 0; }
 	private:
 		static void PrintPhyDeviceInfo(VkPhysicalDeviceProperties& props);
 		static uint32_t GetPhyDeviceScore(VkPhysicalDeviceProperties& props);
+		static QueueFamilyInfo FindTransferQueueFamily(const std::vector<VkQueueFamilyProperties>& queueFamilys);
 
 		void CreateInstance();
 		void CreateSurface(AdWindow* window);
@@ -38,6 +42,7 @@ namespace WuDu {
 		VkPhysicalDevice mPhyDevice;
 		QueueFamilyInfo mGraphicQueueFamily;
 		QueueFamilyInfo mPresentQueueFamily;
+		QueueFamilyInfo mTransferQueueFamily = { -1, 0 };
 		VkPhysicalDeviceMemoryProperties mPhyDeviceMemProperties;
 	};
 }
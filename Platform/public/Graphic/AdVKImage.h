@@ -2,6 +2,7 @@
 #define ADVKIMAGE_H
 
 #include "AdVKCommon.h"
+#include "AdVKMemoryAllocator.h"
 
 namespace WuDu {
 	class AdVKDevice;
@@ -18,10 +19,11 @@ namespace WuDu {
 		void CopyFromBuffer(VkCommandBuffer cmdBuffer, AdVKBuffer* buffer);
 
 		VkFormat GetFormat() const { return mFormat; }
+		VkExtent3D GetExtent() const { return mExtent; }
 		VkImage GetHandle() const { return mHandle; }
 	private:
 		VkImage mHandle = VK_NULL_HANDLE;
-		VkDeviceMemory mMemory = VK_NULL_HANDLE;
+		AdVKAllocation mAllocation;
 
 		bool bCreateImage = true;
 
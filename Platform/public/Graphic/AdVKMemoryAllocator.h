@@ -0,0 +1,101 @@
+#ifndef AD_VKMEMORYALLOCATOR_H
+#define AD_VKMEMORYALLOCATOR_H
+
+#include "AdVKCommon.h"
+
+namespace WuDu {
+	class AdVKDevice;
+
+#define AD_VK_MEMORY_BLOCK_SIZE             (64ull * 1024 * 1024)     // 默认内存块大小
+#define AD_VK_MEMORY_SMALL_HEAP_SIZE        (1024ull * 1024 * 1024)   // 小于该值的堆按 heapSize / 8 切块
+
+	/**
+	 * @brief 资源的内存布局类别，用于满足 bufferImageGranularity 的要求
+	 *
+	 * 线性资源（缓冲区、线性图像）与最优布局图像相邻放置时需要按 bufferImageGranularity 对齐，
+	 * 这里直接把两类资源分配到不同的内存块中，从根源上避免冲突。
+	 */
+	enum AdVKAllocationKind {
+		AD_VK_ALLOCATION_LINEAR = 0,
+		AD_VK_ALLOCATION_OPTIMAL,
+		AD_VK_ALLOCATION_KIND_COUNT
+	};
+
+	/**
+	 * @brief 一次子分配的结果，资源通过 memory + offset 绑定
+	 */
+	struct AdVKAllocation {
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+		VkDeviceSize offset = 0;
+		VkDeviceSize size = 0;
+		void* mappedData = nullptr;                 // 主机可见内存的持久映射地址（已加上 offset）
+		uint32_t memoryTypeIndex = 0;
+		AdVKAllocationKind kind = AD_VK_ALLOCATION_LINEAR;
+		bool bDedicated = false;                    // 超大资源单独分配，不参与子分配
+		void* pBlock = nullptr;                     // 所属内存块，仅供分配器内部使用
+
+		bool IsValid() const { return memory != VK_NULL_HANDLE; }
+	};
+
+	/**
+	 * @brief 每个内存堆的统计信息
+	 */
+	struct AdVKHeapStats {
+		uint32_t blockCount = 0;                    // vkAllocateMemory 次数（含独立分配）
+		uint32_t allocationCount = 0;               // 子分配数量
+		VkDeviceSize blockBytes = 0;                // 向驱动申请的总字节数
+		VkDeviceSize usedBytes = 0;                 // 已被资源占用的字节数
+	};
+
+	/**
+	 * @brief 引擎内存分配器
+	 *
+	 * 按内存类型维护大块 VkDeviceMemory，在块内使用带合并的最佳适配空闲链表进行子分配，
+	 * 以避免每个资源单独调用 vkAllocateMemory 触发驱动的分配数量上限以及内存碎片。
+	 * 主机可见的内存块在创建时整体映射一次，子分配直接返回映射地址。
+	 */
+	class AdVKMemoryAllocator {
+	public:
+		AdVKMemoryAllocator(AdVKDevice* device);
+		~AdVKMemoryAllocator();
+
+		bool Allocate(const VkMemoryRequirements& memReqs, VkMemoryPropertyFlags memProps, AdVKAllocationKind kind, AdVKAllocation* outAllocation);
+		void Free(AdVKAllocation& allocation);
+
+		VkResult BindBuffer(VkBuffer buffer, const AdVKAllocation& allocation) const;
+		VkResult BindImage(VkImage image, const AdVKAllocation& allocation) const;
+
+		AdVKHeapStats GetHeapStats(uint32_t heapIndex) const;
+		uint32_t GetHeapCount() const { return mMemProperties.memoryHeapCount; }
+		void LogStats() const;
+	private:
+		struct MemoryBlock {
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+			VkDeviceSize size = 0;
+			void* mappedData = nullptr;
+			uint32_t allocationCount = 0;
+			std::map<VkDeviceSize, VkDeviceSize> freeRanges;                // offset -> size，按地址排序用于合并
+			std::multimap<VkDeviceSize, VkDeviceSize> freeRangesBySize;     // size -> offset，用于最佳适配查找
+		};
+
+		bool AllocateDedicated(VkDeviceSize size, uint32_t memoryTypeIndex, AdVKAllocation* outAllocation);
+		MemoryBlock* CreateBlock(uint32_t memoryTypeIndex, VkDeviceSize size);
+		void DestroyBlock(MemoryBlock* block, uint32_t memoryTypeIndex);
+		bool AllocateFromBlock(MemoryBlock* block, VkDeviceSize size, VkDeviceSize alignment, VkDeviceSize* outOffset);
+		void InsertFreeRange(MemoryBlock* block, VkDeviceSize offset, VkDeviceSize size);
+		void RemoveFreeRange(MemoryBlock* block, std::map<VkDeviceSize, VkDeviceSize>::iterator it);
+		VkDeviceSize GetBlockSize(uint32_t memoryTypeIndex) const;
+		uint32_t GetPoolIndex(uint32_t memoryTypeIndex, AdVKAllocationKind kind) const;
+
+		AdVKDevice* mDevice;
+		VkPhysicalDeviceMemoryProperties mMemProperties{};
+		VkDeviceSize mBufferImageGranularity = 1;
+
+		// [memoryTypeIndex * AD_VK_ALLOCATION_KIND_COUNT + kind] -> 内存块列表
+		std::vector<std::vector<std::unique_ptr<MemoryBlock>>> mPools;
+		std::vector<AdVKHeapStats> mHeapStats;
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
@@ -136,6 +136,12 @@ namespace WuDu {
 		 */
 		VkShaderModule GetFragShaderModule() const { return mFragShaderModule; }
 
+		/**
+		 * @brief 获取着色器代码（SPIR-V）的哈希，参与管线缓存键的计算
+		 * @return 顶点与片段着色器代码的组合哈希
+		 */
+		uint64_t GetShaderHash() const { return mShaderHash; }
+
 	private:
 		/**
 		 * @brief 创建着色器模块
@@ -143,14 +149,84 @@ namespace WuDu {
 		 * @param outShaderModule 输出参数，指向创建的着色器模块句柄
 		 * @return Vulkan结果代码
 		 */
-		VkResult CreateShaderModule(const std::string& filePath, VkShaderModule* outShaderModule);
+		VkResult CreateShaderModule(const std::string& filePath, VkShaderModule* outShaderModule, uint64_t* inOutHash);
 
 		VkPipelineLayout mHandle = VK_NULL_HANDLE;           ///< 管线布局句柄
 		VkShaderModule mVertexShaderModule = VK_NULL_HANDLE; ///< 顶点着色器模块句柄
 		VkShaderModule mFragShaderModule = VK_NULL_HANDLE;   ///< 片段着色器模块句柄
+		uint64_t mShaderHash = 0;                            ///< 着色器代码哈希
 		AdVKDevice* mDevice;                                 ///< 指向Vulkan设备对象的指针
 	};
 
+	/**
+	 * @brief 管线注册表的键：参与去重的全部管线状态按字节展开，哈希只用于分桶
+	 *
+	 * 命中时比较完整的状态字节，哈希碰撞的不同配置不会拿到对方的管线。
+	 */
+	struct AdVKPipelineKey {
+		std::vector<uint8_t> state;
+		uint64_t hash = 0;
+
+		bool operator==(const AdVKPipelineKey& other) const { return hash == other.hash && state == other.state; }
+	};
+
+	struct AdVKPipelineKeyHasher {
+		size_t operator()(const AdVKPipelineKey& key) const { return static_cast<size_t>(key.hash); }
+	};
+
+	/**
+	 * @brief 管线注册表中的一条记录，配置相同的 AdVKPipeline 共享同一条 VkPipeline
+	 */
+	struct AdVKPipelineEntry {
+		AdVKDevice* device = nullptr;
+		std::atomic<VkPipeline> handle = VK_NULL_HANDLE;   ///< 编译完成前为空
+		std::atomic<bool> bReady = false;                  ///< 编译是否完成
+		uint32_t sortId = 0;                                ///< 注册表按首次出现顺序分配的小编号，用于渲染排序键
+		std::shared_future<void> compileTask;               ///< 编译任务（工作线程或调用线程）
+
+		~AdVKPipelineEntry();
+
+		/**
+		 * @brief 阻塞等待编译完成
+		 */
+		void Wait() const;
+	};
+
+	/**
+	 * @brief 管线注册表，以完整的管线状态为键对图形管线去重，并负责在工作线程上异步编译新的管线变体
+	 *
+	 * 注册表只持有弱引用，最后一个使用者释放后管线随之销毁，因此键中引用的管线布局与着色器
+	 * 在记录存活期间始终有效。
+	 */
+	class AdVKPipelineRegistry {
+	public:
+		AdVKPipelineRegistry(AdVKDevice* device);
+		~AdVKPipelineRegistry();
+
+		/**
+		 * @brief 获取键对应的管线，不存在时创建并编译
+		 * @param key 管线状态
+		 * @param compileFunc 实际执行编译的函数，可能在工作线程上调用
+		 * @param bAsync 为 true 时在工作线程上编译并立即返回；为 false 时阻塞直到编译完成
+		 * @return 共享的管线记录
+		 */
+		std::shared_ptr<AdVKPipelineEntry> Acquire(const AdVKPipelineKey& key, std::function<VkPipeline()> compileFunc, bool bAsync);
+
+		uint32_t GetHitCount() const { return mHitCount; }
+		uint32_t GetMissCount() const { return mMissCount; }
+		// 已提交但尚未编译完成的管线数量
+		uint32_t GetPendingCount() const { return mPendingCount; }
+	private:
+		AdVKDevice* mDevice;
+		std::unordered_map<AdVKPipelineKey, std::weak_ptr<AdVKPipelineEntry>, AdVKPipelineKeyHasher> mEntries;
+		// 排序编号在记录释放后仍保留，同一管线状态重新创建时编号不变
+		std::unordered_map<AdVKPipelineKey, uint32_t, AdVKPipelineKeyHasher> mSortIds;
+		std::mutex mMutex;
+		std::atomic<uint32_t> mHitCount = 0;
+		std::atomic<uint32_t> mMissCount = 0;
+		std::atomic<uint32_t> mPendingCount = 0;
+	};
+
 	/**
 	 * @brief Vulkan图形管线类，用于构建和管理图形管线对象
 	 */
@@ -170,17 +246,40 @@ namespace WuDu {
 		~AdVKPipeline();
 
 		/**
-		 * @brief 创建图形管线对象
+		 * @brief 创建图形管线对象，注册表中已有相同配置的管线时直接复用，否则在调用线程上编译
 		 */
 		void Create();
 
+		/**
+		 * @brief 异步创建图形管线对象，新的管线变体在工作线程上编译，完成前 Bind 返回 false
+		 */
+		void CreateAsync();
+
+		/**
+		 * @brief 管线是否已编译完成，可以绑定
+		 */
+		bool IsReady() const { return mEntry && mEntry->bReady; }
+
+		/**
+		 * @brief 管线状态键：管线配置、着色器代码哈希、管线布局与渲染通道兼容性
+		 */
+		AdVKPipelineKey GetKey() const;
+
+		/**
+		 * @brief 管线的排序编号：从0递增的小整数，不同管线状态互不相同，在 Create/CreateAsync 之后有效
+		 *
+		 * 用于渲染队列排序键的管线字段，避免截断哈希带来的冲突。
+		 */
+		uint32_t GetSortId() const { return mEntry ? mEntry->sortId : 0; }
+
 		void SetSubPassIndex(uint32_t index);
 
 		/**
 		 * @brief 绑定当前管线到命令缓冲区
 		 * @param cmdBuffer 命令缓冲区句柄
+		 * @return 管线仍在编译时返回 false，调用者应跳过本帧使用该管线的绘制
 		 */
-		void Bind(VkCommandBuffer cmdBuffer);
+		bool Bind(VkCommandBuffer cmdBuffer);
 
 		/**
 		 * @brief 设置顶点输入状态
@@ -259,14 +358,18 @@ namespace WuDu {
 		 * @brief 获取管线句柄
 		 * @return 返回Vulkan管线句柄
 		 */
-		VkPipeline GetHandle() const { return mHandle; }
+		VkPipeline GetHandle() const { return mEntry ? mEntry->handle.load() : VK_NULL_HANDLE; }
 
 	private:
-		VkPipeline mHandle = VK_NULL_HANDLE;         ///< 管线句柄
+		void Acquire(bool bAsync);
+		static VkPipeline Compile(AdVKDevice* device, const PipelineConfig& config, VkShaderModule vertexShaderModule, VkShaderModule fragShaderModule,
+			VkPipelineLayout pipelineLayout, VkRenderPass renderPass, uint32_t subPassIndex);
+
+		std::shared_ptr<AdVKPipelineEntry> mEntry;   ///< 注册表中共享的管线记录
 		AdVKDevice* mDevice;                         ///< 指向Vulkan设备对象的指针
 		AdVKRenderPass* mRenderPass;                 ///< 指向渲染通道对象的指针
 		AdVKPipelineLayout* mPipelineLayout;         ///< 指向管线布局对象的指针
-		uint32_t mSubPassIndex;
+		uint32_t mSubPassIndex = 0;
 		PipelineConfig mPipelineConfig;              ///< 管线配置信息
 	};
 }
@@ -13,11 +13,15 @@ namespace WuDu {
                 VkQueue GetHandle() const { return mHandle; }
 
                 void Submit(const std::vector<VkCommandBuffer>& cmdBuffers, const std::vector<VkSemaphore>& waitSemaphores = {}, const std::vector<VkSemaphore>& signalSemaphores = {}, VkFence frameFence = VK_NULL_HANDLE);
+                VkResult Present(const VkPresentInfoKHR& presentInfo);
+                // VkQueue 需要外部同步：提交、呈现、等待空闲都持有此锁，上传线程与渲染线程可共用同一队列
+                std::mutex& GetSubmitMutex() const { return mSubmitMutex; }
         private:
                 uint32_t mFamilyIndex;
                 uint32_t mIndex;
                 VkQueue mHandle;
                 bool canPresent;
+                mutable std::mutex mSubmitMutex;
         };
 }
 
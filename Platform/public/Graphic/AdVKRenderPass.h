@@ -53,12 +53,15 @@ namespace WuDu {
 		const std::vector<Attachment>& GetAttachments() const { return mAttachments; }
 		uint32_t GetAttachmentSize() const { return mAttachments.size(); }
 		const std::vector<RenderSubPass>& GetSubPasses() const { return mSubPasses; }
+		// 渲染通道兼容性哈希：只包含附件格式、采样数与子通道结构，兼容的渲染通道可以共用同一条管线
+		uint64_t GetCompatibilityHash() const { return mCompatibilityHash; }
 	private:
 		VkRenderPass mHandle = VK_NULL_HANDLE;
 		AdVKDevice* mDevice;
 
 		std::vector<Attachment> mAttachments;
 		std::vector<RenderSubPass> mSubPasses;
+		uint64_t mCompatibilityHash = 0;
 	};
 }
 
@@ -0,0 +1,56 @@
+#ifndef AD_VKRINGBUFFER_H
+#define AD_VKRINGBUFFER_H
+
+#include "AdVKCommon.h"
+
+namespace WuDu {
+	class AdVKDevice;
+	class AdVKBuffer;
+
+	/**
+	 * @brief 按帧划分的持久映射环形缓冲区
+	 *
+	 * 每个帧槽位(frame in flight)拥有一个主机可见缓冲区，生命周期内保持映射。
+	 * 每帧开始时调用 BeginFrame 重置当前槽位的写指针，之后通过 Allocate/Push 线性地分出对齐的切片，
+	 * 使用者以 UNIFORM_BUFFER_DYNAMIC / STORAGE_BUFFER_DYNAMIC 的动态偏移绑定这些切片。
+	 * 当前槽位的帧围栏已被等待，因此重写该槽位的数据是安全的。
+	 */
+	class AdVKRingBuffer {
+	public:
+		AdVKRingBuffer(AdVKDevice* device, VkBufferUsageFlags usage, VkDeviceSize sizePerFrame, uint32_t frameCount);
+		~AdVKRingBuffer();
+
+		bool BeginFrame(uint32_t frameIndex, VkDeviceSize requiredSize = 0);
+		bool Allocate(VkDeviceSize size, uint32_t* outOffset, void** outData);
+
+		template<typename T>
+		bool Push(const T& data, uint32_t* outOffset) {
+			void* mapping = nullptr;
+			if (!Allocate(sizeof(T), outOffset, &mapping)) {
+				return false;
+			}
+			memcpy(mapping, &data, sizeof(T));
+			return true;
+		}
+
+		VkBuffer GetHandle() const;
+		VkBuffer GetHandle(uint32_t frameIndex) const;
+		VkDeviceSize GetAlignment() const { return mAlignment; }
+		VkDeviceSize GetAlignedSize(VkDeviceSize size) const { return (size + mAlignment - 1) / mAlignment * mAlignment; }
+		VkDeviceSize GetUsedSize() const { return mHead; }
+		VkDeviceSize GetFrameSize() const;
+	private:
+		void CreateFrameBuffer(uint32_t frameIndex, VkDeviceSize size);
+
+		AdVKDevice* mDevice;
+		VkBufferUsageFlags mUsage;
+		VkDeviceSize mAlignment = 1;
+
+		std::vector<std::shared_ptr<AdVKBuffer>> mFrameBuffers;
+		std::vector<VkDeviceSize> mFrameHighWater;          // 每个槽位上次使用时请求的总大小，用于下一次扩容
+		uint32_t mCurrentFrame = 0;
+		VkDeviceSize mHead = 0;
+	};
+}
+
+#endif
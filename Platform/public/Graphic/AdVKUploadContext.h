@@ -0,0 +1,83 @@
+#ifndef AD_VKUPLOADCONTEXT_H
+#define AD_VKUPLOADCONTEXT_H
+
+#include "AdVKCommon.h"
+
+namespace WuDu {
+	class AdVKDevice;
+	class AdVKQueue;
+	class AdVKBuffer;
+	class AdVKImage;
+	class AdVKCommandPool;
+
+#define AD_VK_UPLOAD_STAGING_CHUNK_SIZE     (16ull * 1024 * 1024)     // 暂存区块大小，超过该值的上传单独申请
+#define AD_VK_UPLOAD_MAX_FREE_CHUNKS        4                         // 保留复用的空闲暂存区块数量
+
+	/**
+	 * @brief 批量异步上传上下文
+	 *
+	 * 缓冲区与图像的上传不再各自创建一次性命令缓冲并阻塞等待队列空闲，而是把数据写入暂存区块，
+	 * 将复制命令录制到当前批次中；批次在 Flush 时一次性提交到传输队列（设备有独立传输队列族时），
+	 * 并以围栏标记完成。每次上传返回一个批次票据（ticket），围栏触发后该票据对应的资源变为就绪。
+	 *
+	 * 所有公开接口线程安全。
+	 */
+	class AdVKUploadContext {
+	public:
+		AdVKUploadContext(AdVKDevice* device, AdVKQueue* queue, uint32_t queueFamilyIndex);
+		~AdVKUploadContext();
+
+		uint64_t UploadBuffer(VkBuffer dstBuffer, const void* data, VkDeviceSize size, VkDeviceSize dstOffset = 0);
+		uint64_t UploadImage(AdVKImage* dstImage, const void* data, VkDeviceSize size);
+
+		// 提交当前录制中的批次，返回最近一次提交的批次票据
+		uint64_t Flush();
+		// 非阻塞地回收已完成的批次
+		void Update();
+		// 阻塞直到票据对应的批次完成（必要时先提交）
+		void Wait(uint64_t ticket);
+		void WaitIdle();
+
+		bool IsComplete(uint64_t ticket) const { return ticket <= mCompletedBatchId; }
+		uint64_t GetSubmitCount() const { return mSubmitCount; }
+		uint64_t GetCopyCount() const { return mCopyCount; }
+	private:
+		struct StagingChunk {
+			std::shared_ptr<AdVKBuffer> buffer;
+			VkDeviceSize usedSize = 0;
+		};
+
+		struct Batch {
+			uint64_t id = 0;
+			VkCommandBuffer cmdBuffer = VK_NULL_HANDLE;
+			VkFence fence = VK_NULL_HANDLE;
+			std::vector<StagingChunk> chunks;
+			uint32_t copyCount = 0;
+		};
+
+		Batch* GetRecordingBatch();
+		bool AllocateStaging(Batch* batch, VkDeviceSize size, VkDeviceSize alignment, VkBuffer* outBuffer, VkDeviceSize* outOffset, void** outData);
+		uint64_t FlushLocked();
+		void RetireBatches(bool bWait, uint64_t ticket);
+		void RecycleBatch(std::unique_ptr<Batch> batch);
+
+		AdVKDevice* mDevice;
+		AdVKQueue* mQueue;
+		std::shared_ptr<AdVKCommandPool> mCmdPool;
+		VkDeviceSize mImageCopyAlignment = 16;
+
+		std::unique_ptr<Batch> mRecordingBatch;
+		std::deque<std::unique_ptr<Batch>> mInFlightBatches;
+		std::vector<std::unique_ptr<Batch>> mFreeBatches;
+		std::vector<std::shared_ptr<AdVKBuffer>> mFreeChunks;
+
+		uint64_t mNextBatchId = 1;
+		uint64_t mSubmittedBatchId = 0;
+		std::atomic<uint64_t> mCompletedBatchId = 0;
+		std::atomic<uint64_t> mSubmitCount = 0;
+		std::atomic<uint64_t> mCopyCount = 0;
+		mutable std::mutex mMutex;
+	};
+}
+
+#endif
@@ -5,6 +5,7 @@ layout(location=1)	in vec2 a_Texcoord;
 layout(location=2)	in vec3 a_Normal;
 layout(location=3)	in vec3 a_Tangent;
 layout(location=4)	in vec3 a_Bitangent;
+layout(location=5)	in mat4 a_ModelMat;     // per-instance, locations 5~8
 
 out gl_PerVertex{
     vec4 gl_Position;
@@ -18,14 +19,9 @@ layout(set=0, binding=0, std140) uniform FrameUbo{
     float time;
 } frameUbo;
 
-layout(push_constant) uniform PushConstants{
-    mat4 modelMat;
-    mat3 normalMat;
-} PC;
-
 out layout(location=1) vec2 v_Texcoord;
 
 void main(){
-    gl_Position = frameUbo.projMat * frameUbo.viewMat * PC.modelMat * vec4(a_Pos.x, a_Pos.y, a_Pos.z, 1.f);
+    gl_Position = frameUbo.projMat * frameUbo.viewMat * a_ModelMat * vec4(a_Pos.x, a_Pos.y, a_Pos.z, 1.f);
     v_Texcoord = a_Texcoord;
 }
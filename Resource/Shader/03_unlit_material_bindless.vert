@@ -0,0 +1,27 @@
+#version 450
+
+layout(location=0)	in vec3 a_Pos;
+layout(location=1)	in vec2 a_Texcoord;
+layout(location=2)	in vec3 a_Normal;
+layout(location=3)	in vec3 a_Tangent;
+layout(location=4)	in vec3 a_Bitangent;
+layout(location=5)	in mat4 a_ModelMat;     // per-instance, locations 5~8
+
+out gl_PerVertex{
+    vec4 gl_Position;
+};
+
+layout(set=0, binding=0, std140) uniform FrameUbo{
+    mat4  projMat;
+    mat4  viewMat;
+    ivec2 resolution;
+    uint  frameId;
+    float time;
+} frameUbo;
+
+out layout(location=1) vec2 v_Texcoord;
+
+void main(){
+    gl_Position = frameUbo.projMat * frameUbo.viewMat * a_ModelMat * vec4(a_Pos.x, a_Pos.y, a_Pos.z, 1.f);
+    v_Texcoord = a_Texcoord;
+}
@@ -0,0 +1,28 @@
+#version 450
+
+// AdPackedVertex: positions are SNORM16 relative to the mesh bounds, the dequantize
+// transform (translate + uniform scale) is pre-multiplied into a_ModelMat on the CPU
+layout(location=0)	in vec4 a_Pos;          // xyz: quantized position, w: bitangent sign
+layout(location=1)	in vec2 a_Texcoord;     // half float
+layout(location=2)	in vec2 a_Normal;       // octahedral
+layout(location=3)	in vec2 a_Tangent;      // octahedral
+layout(location=5)	in mat4 a_ModelMat;     // per-instance, locations 5~8
+
+out gl_PerVertex{
+    vec4 gl_Position;
+};
+
+layout(set=0, binding=0, std140) uniform FrameUbo{
+    mat4  projMat;
+    mat4  viewMat;
+    ivec2 resolution;
+    uint  frameId;
+    float time;
+} frameUbo;
+
+out layout(location=1) vec2 v_Texcoord;
+
+void main(){
+    gl_Position = frameUbo.projMat * frameUbo.viewMat * a_ModelMat * vec4(a_Pos.xyz, 1.f);
+    v_Texcoord = a_Texcoord;
+}
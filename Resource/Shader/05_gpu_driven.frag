@@ -0,0 +1,57 @@
+#version 450
+#extension GL_KHR_vulkan_glsl : enable
+#extension GL_EXT_nonuniform_qualifier : enable
+layout(location=1) in vec2 v_Texcoord;
+layout(location=2) flat in uint v_MaterialIndex;
+
+struct TextureParam{
+    bool  enable;
+    float uvRotation;
+    vec4  uvTransform;   // x,y --> scale, z,w --> translation
+};
+
+vec2 getTextureUV(TextureParam param, vec2 inUV){
+    vec2 retUV = inUV * param.uvTransform.xy;           // scale
+    retUV = vec2(                                       // rotation
+        retUV.x * sin(param.uvRotation) + retUV.y * cos(param.uvRotation),
+        retUV.y * sin(param.uvRotation) + retUV.x * cos(param.uvRotation)
+    );
+    inUV = retUV + param.uvTransform.zw;                // translation
+    return inUV;
+}
+
+struct MaterialData{
+    vec3 baseColor0;
+    vec3 baseColor1;
+    float mixValue;
+    TextureParam textureParam0;
+    TextureParam textureParam1;
+    uvec4 textureIndices;   // x,y --> texture0 texture/sampler index, z,w --> texture1
+};
+
+layout(set=0, binding=2, std430) readonly buffer MaterialBuffer{
+    MaterialData materials[];
+};
+
+layout(set=1, binding=0) uniform texture2D textures[];
+layout(set=1, binding=1) uniform sampler samplers[];
+
+layout(location=0) out vec4 fragColor;
+
+void main(){
+    MaterialData material = materials[v_MaterialIndex];
+    vec3 color0 = material.baseColor0;
+    vec3 color1 = material.baseColor1;
+
+    if(material.textureParam0.enable){
+        color0 = texture(sampler2D(textures[material.textureIndices.x], samplers[material.textureIndices.y]),
+            getTextureUV(material.textureParam0, v_Texcoord)).rgb;
+    }
+
+    if(material.textureParam1.enable){
+        color1 = texture(sampler2D(textures[material.textureIndices.z], samplers[material.textureIndices.w]),
+            getTextureUV(material.textureParam1, v_Texcoord)).rgb;
+    }
+
+    fragColor = vec4(mix(color0, color1, material.mixValue), 1.0);
+}
@@ -0,0 +1,42 @@
+#version 450
+
+layout(location=0)	in vec3 a_Pos;
+layout(location=1)	in vec2 a_Texcoord;
+layout(location=2)	in vec3 a_Normal;
+layout(location=3)	in vec3 a_Tangent;
+layout(location=4)	in vec3 a_Bitangent;
+
+out gl_PerVertex{
+    vec4 gl_Position;
+};
+
+layout(set=0, binding=0, std140) uniform FrameUbo{
+    mat4  projMat;
+    mat4  viewMat;
+    ivec2 resolution;
+    uint  frameId;
+    float time;
+} frameUbo;
+
+struct InstanceData{
+    mat4 modelMat;
+    uint meshIndex;
+    uint materialIndex;
+    uint padding0;
+    uint padding1;
+};
+
+layout(set=0, binding=1, std430) readonly buffer InstanceBuffer{
+    InstanceData instances[];
+};
+
+out layout(location=1) vec2 v_Texcoord;
+out layout(location=2) flat uint v_MaterialIndex;
+
+void main(){
+    // gl_InstanceIndex includes firstInstance, which the culling pass set to the instance index
+    InstanceData instance = instances[gl_InstanceIndex];
+    gl_Position = frameUbo.projMat * frameUbo.viewMat * instance.modelMat * vec4(a_Pos.x, a_Pos.y, a_Pos.z, 1.f);
+    v_Texcoord = a_Texcoord;
+    v_MaterialIndex = instance.materialIndex;
+}
@@ -0,0 +1,43 @@
+#version 450
+
+// AdPackedVertex: positions are SNORM16 relative to the mesh bounds, the dequantize
+// transform (translate + uniform scale) is pre-multiplied into instance.modelMat on the CPU
+layout(location=0)	in vec4 a_Pos;          // xyz: quantized position, w: bitangent sign
+layout(location=1)	in vec2 a_Texcoord;     // half float
+layout(location=2)	in vec2 a_Normal;       // octahedral
+layout(location=3)	in vec2 a_Tangent;      // octahedral
+
+out gl_PerVertex{
+    vec4 gl_Position;
+};
+
+layout(set=0, binding=0, std140) uniform FrameUbo{
+    mat4  projMat;
+    mat4  viewMat;
+    ivec2 resolution;
+    uint  frameId;
+    float time;
+} frameUbo;
+
+struct InstanceData{
+    mat4 modelMat;
+    uint meshIndex;
+    uint materialIndex;
+    uint padding0;
+    uint padding1;
+};
+
+layout(set=0, binding=1, std430) readonly buffer InstanceBuffer{
+    InstanceData instances[];
+};
+
+out layout(location=1) vec2 v_Texcoord;
+out layout(location=2) flat uint v_MaterialIndex;
+
+void main(){
+    // gl_InstanceIndex includes firstInstance, which the culling pass set to the instance index
+    InstanceData instance = instances[gl_InstanceIndex];
+    gl_Position = frameUbo.projMat * frameUbo.viewMat * instance.modelMat * vec4(a_Pos.xyz, 1.f);
+    v_Texcoord = a_Texcoord;
+    v_MaterialIndex = instance.materialIndex;
+}
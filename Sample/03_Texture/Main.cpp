@@ -10,6 +10,7 @@
 #include "Graphic/AdVKCommandBuffer.h"
 #include "Graphic/AdVKDescriptorSet.h"
 #include "Graphic/AdVKImageView.h"
+#include "Graphic/AdVKUploadContext.h"
 #include "AdGeometryUtil.h"
 
 struct GlobalUbo {
@@ -194,6 +195,9 @@ protected:
                 std::vector<uint32_t> indices;
                 WuDu::AdGeometryUtil::CreateCube(-0.3f, 0.3f, -0.3f, 0.3f, -0.3f, 0.3f, vertices, indices);
                 mCubeMesh = std::make_shared<WuDu::AdMesh>(vertices, indices);
+
+                // ʾй֡ѭ AdRendererһύȴϴ
+                device->GetUploadContext()->WaitIdle();
         }
 
         void OnUpdate(float deltaTime) override {
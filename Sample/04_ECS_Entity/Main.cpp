@@ -9,6 +9,7 @@
 #include "ECS/AdEntity.h"
 #include "ECS/System/AdBaseMaterialSystem.h"
 #include "ECS/System/AdUnlitMaterialSystem.h"
+#include "ECS/System/AdGpuDrivenMaterialSystem.h"
 #include "ECS/System/AdCameraControllerManager.h"
 #include "ECS/Component/AdLookAtCameraComponent.h"
 #include "ECS/Component/AdFirstPersonCameraComponent.h"
@@ -19,7 +20,14 @@
 #include "AdTimeStep.h"
 #include "AdLog.h"
 #include "Resource/AdModelResource.h"
+#include "Resource/AdResourceManager.h"
 
+// --cull-check 场景：相机位于原点朝 -Z，前方、后方与远裁剪面之外各放一组网格排列的立方体，只有前方一组可见
+#define CULL_CHECK_GRID_SIZE            8
+#define CULL_CHECK_GROUP_COUNT          3
+#define CULL_CHECK_EXPECTED_VISIBLE     (CULL_CHECK_GRID_SIZE * CULL_CHECK_GRID_SIZE)
+// --sync-check：跳过启动阶段的若干帧，之后每帧(交换链重建的帧除外)都不应等待设备空闲
+#define SYNC_CHECK_WARMUP_FRAMES        10
 
 /**
  * @brief SandBoxApp 类继承自 WuDu::AdApplication，用于演示基于 ECS 的实体渲染示例。
@@ -99,37 +107,47 @@ protected:
 		mRenderTarget = std::make_shared<WuDu::AdRenderTarget>(mRenderPass.get());
 		mRenderTarget->SetColorClearValue({ 0.1f, 0.2f, 0.3f, 1.f });
 		mRenderTarget->SetDepthStencilClearValue({ 1, 0 });
-		mRenderTarget->AddMaterialSystem<WuDu::AdUnlitMaterialSystem>();
+		// --gpu-driven 改用GPU剔除与间接绘制，与无光照材质系统二选一；--cull-check 在其上校验GPU剔除后的可见数量
+		bCullCheck = HasArg("--cull-check");
+		bSyncCheck = HasArg("--sync-check");
+		if (bCullCheck || HasArg("--gpu-driven")) {
+			mGpuDrivenSystem = mRenderTarget->AddMaterialSystem<WuDu::AdGpuDrivenMaterialSystem>();
+		}
+		else {
+			mRenderTarget->AddMaterialSystem<WuDu::AdUnlitMaterialSystem>();
+		}
 		mRenderTarget->AddMaterialSystem<WuDu::AdBaseMaterialSystem>();
 
 
 		// 创建渲染器
 		mRenderer = std::make_shared<WuDu::AdRenderer>();
 
-		// 分配命令缓冲区
-		mCmdBuffers = device->GetDefaultCmdPool()->AllocateCommandBuffer(swapchain->GetImages().size());
+		// 分配命令缓冲区，每个帧槽位(frame in flight)一个
+		mCmdBuffers = device->GetDefaultCmdPool()->AllocateCommandBuffer(mRenderer->GetFramesInFlight());
 
 
+		// 模型在工作线程加载，与下面的立方体网格创建并行
+		WuDu::AdResourceHandle<WuDu::AdModelResource> modelHandle = WuDu::AdResourceManager::GetInstance()->LoadAsync<WuDu::AdModelResource>(AD_RES_MODEL_DIR"Phainon.fbx");
+
 		// 创建立方体网格数据
 		std::vector<WuDu::AdVertex> vertices;
 		std::vector<uint32_t> indices;
 		WuDu::AdGeometryUtil::CreateCube(-0.3f, 0.3f, -0.3f, 0.3f, -0.3f, 0.3f, vertices, indices);
 		mCubeMesh = std::make_shared<WuDu::AdMesh>(vertices, indices);
 
-		//加载模型
-		std::shared_ptr<WuDu::AdModelResource> model = std::make_shared<WuDu::AdModelResource>(AD_RES_MODEL_DIR"Phainon.fbx");
+		//等待模型加载完成
+		std::shared_ptr<WuDu::AdModelResource> model = modelHandle.Get();
 		std::vector<WuDu::ModelVertex> Vertices;
 		std::vector<uint32_t> Indices;
-		if (model->Load()) {
+		if (model && model->IsLoaded()) {
 			const std::vector<WuDu::ModelMesh>& meshes = model->GetMeshes();
 
 			//处理每个网格
 			/*for (const auto& mesh : meshes) {
 
 			}*/
-			Vertices = meshes[0].Vertices;
-			Indices = meshes[0].Indices;
-			mModelMeshes.emplace_back(std::make_shared<WuDu::AdMesh>(Vertices, Indices));
+			// 模型网格量化为 20 字节的 AdPackedVertex，由无光照材质系统的量化管线绘制
+			mModelMeshes.emplace_back(std::make_shared<WuDu::AdMesh>(meshes[0], WuDu::AdVertexFormat::Packed));
 		}
 		else {
 			mModelMeshes.emplace_back(std::make_shared<WuDu::AdMesh>(vertices, indices));
@@ -194,15 +212,21 @@ protected:
 		mGuiSystem->AddSceneEditor();
 
 
+		if (bCullCheck) {
+			CreateCullCheckScene(scene, camera);
+			return;
+		}
+
 		// 创建多个实体，并设置其材质和变换属性
 		{
-			mCubes.emplace_back(scene->CreateEntity("MiG-29"));
-			auto& materialComp = mCubes[0]->AddComponent<WuDu::AdUnlitMaterialComponent>();
+			// 批量创建接口：相同名称、变换和材质组件的实体只需一次调用
+			WuDu::AdEntityPrototype prototype;
+			prototype.name = "MiG-29";
+			prototype.scale = { 0.4f, 0.4f, 0.4f };
+			mCubes = scene->CreateEntities(1, prototype);
+			WuDu::AdUnlitMaterialComponent materialComp;
 			materialComp.AddMesh(mModelMeshes[0].get(), mBaseMaterial.get());
-			auto& transComp = mCubes[0]->GetComponent<WuDu::AdTransformComponent>();
-			transComp.scale = { 0.4f, 0.4f, 0.4f };
-			transComp.position = { 0.f, 0.f, 0.0f };
-			transComp.rotation = { 0.f, 0.f, 0.f };
+			scene->AddComponents(std::span<WuDu::AdEntity* const>(mCubes), materialComp);
 		}
 	}
 
@@ -220,7 +244,7 @@ protected:
 		float rotationSpeed = 90.0f; // 每秒旋转90度
 
 		// 更新 Cube 0 - 绕Y轴旋转
-		if (mCubes[0] && mCubes[0]->HasComponent<WuDu::AdTransformComponent>()) {
+		if (!mCubes.empty() && mCubes[0] && mCubes[0]->HasComponent<WuDu::AdTransformComponent>()) {
 			auto& transComp = mCubes[0]->GetComponent<WuDu::AdTransformComponent>();
 			transComp.rotation.y += rotationSpeed * deltaTime;
 			// 保持在0-360度范围内
@@ -257,12 +281,14 @@ protected:
 		WuDu::AdVKSwapchain* swapchain = renderCxt->GetSwapchain();
 
 		int32_t imageIndex;
+		bool bSwapchainRecreated = false;
 		if (mRenderer->Begin(&imageIndex)) {
 			mRenderTarget->SetExtent({ swapchain->GetWidth(), swapchain->GetHeight() });
 			mGuiSystem->RebuildResources();
+			bSwapchainRecreated = true;
 		}
 
-		VkCommandBuffer cmdBuffer = mCmdBuffers[imageIndex];
+		VkCommandBuffer cmdBuffer = mCmdBuffers[mRenderer->GetCurrentFrameIndex()];
 		WuDu::AdVKCommandPool::BeginCommandBuffer(cmdBuffer);
 
 		// 渲染3D场景
@@ -270,27 +296,120 @@ protected:
 		mRenderTarget->RenderMaterialSystems(cmdBuffer);
 		mRenderTarget->End(cmdBuffer);
 
+		// 构建GUI并录制到同一命令缓冲区，与场景共用一次提交和呈现
+		mGuiSystem->BeginGui();      // 开始GUI帧（内部会调用UI构建函数）
+		mGuiSystem->EndGui();        // 结束GUI帧
+		mGuiSystem->OnRender(cmdBuffer);
 
 		WuDu::AdVKCommandPool::EndCommandBuffer(cmdBuffer);
 		if (mRenderer->End(imageIndex, { cmdBuffer })) {
 			mRenderTarget->SetExtent({ swapchain->GetWidth(), swapchain->GetHeight() });
+			mGuiSystem->RebuildResources();
+			bSwapchainRecreated = true;
 		}
-		mGuiSystem->BeginGui();      // 开始GUI帧（内部会调用UI构建函数）
-		// 3. 结束GUI帧
-		mGuiSystem->EndGui();
-		// 4. 渲染GUI
-		mGuiSystem->OnRender();
 
+		if (bCullCheck) {
+			CheckCullResult();
+		}
+		if (bSyncCheck) {
+			CheckFrameSync(bSwapchainRecreated);
+		}
 	}
 
+	/**
+	 * @brief 构建 --cull-check 使用的已知场景。
+	 *
+	 * 相机固定在原点朝 -Z。三组立方体各 CULL_CHECK_GRID_SIZE^2 个：第一组在相机前方 10 个单位处，
+	 * 远离视锥体边界，与宽高比无关地全部可见；第二组在相机后方，第三组在远裁剪面之外，全部被剔除。
+	 */
+	void CreateCullCheckScene(WuDu::AdScene* scene, WuDu::AdEntity* camera) {
+		camera->GetComponent<WuDu::AdTransformComponent>().position = { 0.f, 0.f, 0.f };
+
+		const float groupDepths[CULL_CHECK_GROUP_COUNT] = { -10.f, 10.f, -2000.f };
+		WuDu::AdEntityPrototype prototype;
+		prototype.name = "CullCheck";
+		prototype.scale = { 0.5f, 0.5f, 0.5f };
+		std::vector<WuDu::AdEntity*> entities = scene->CreateEntities(CULL_CHECK_GROUP_COUNT * CULL_CHECK_EXPECTED_VISIBLE, prototype);
+		for (uint32_t i = 0; i < entities.size(); i++) {
+			uint32_t cell = i % CULL_CHECK_EXPECTED_VISIBLE;
+			auto& transComp = entities[i]->GetComponent<WuDu::AdTransformComponent>();
+			transComp.position = {
+				(static_cast<float>(cell % CULL_CHECK_GRID_SIZE) - CULL_CHECK_GRID_SIZE * 0.5f) * 0.5f,
+				(static_cast<float>(cell / CULL_CHECK_GRID_SIZE) - CULL_CHECK_GRID_SIZE * 0.5f) * 0.5f,
+				groupDepths[i / CULL_CHECK_EXPECTED_VISIBLE]
+			};
+		}
+		WuDu::AdUnlitMaterialComponent materialComp;
+		materialComp.AddMesh(mCubeMesh.get(), mBaseMaterial.get());
+		scene->AddComponents(std::span<WuDu::AdEntity* const>(entities), materialComp);
+	}
+
+	/**
+	 * @brief 剔除结果回读到达(总实例数与场景一致)后比较可见数量，不一致时以非零退出码结束。
+	 */
+	void CheckCullResult() {
+		if (bCullChecked) {
+			return;
+		}
+		uint32_t totalCount = mGpuDrivenSystem->GetTotalInstanceCount();
+		if (totalCount != CULL_CHECK_GROUP_COUNT * CULL_CHECK_EXPECTED_VISIBLE) {
+			return;
+		}
+		uint32_t visibleCount = mGpuDrivenSystem->GetVisibleInstanceCount();
+		bCullChecked = true;
+		if (visibleCount == CULL_CHECK_EXPECTED_VISIBLE) {
+			LOG_I("Cull check passed: {0} / {1} instances visible", visibleCount, totalCount);
+		}
+		else {
+			LOG_E("Cull check failed: {0} / {1} instances visible, expected {2}", visibleCount, totalCount, CULL_CHECK_EXPECTED_VISIBLE);
+			SetExitCode(EXIT_FAILURE);
+		}
+	}
+
+
+	/**
+	 * @brief 检查刚结束的一帧是否等待过设备空闲。
+	 *
+	 * 启动阶段(资源创建、管线编译)与交换链重建需要等待设备空闲，不计入；
+	 * 其余帧只应由帧槽位的围栏同步，出现设备空闲等待时以非零退出码结束。
+	 *
+	 * @param bSwapchainRecreated 本帧是否重建了交换链
+	 */
+	void CheckFrameSync(bool bSwapchainRecreated) {
+		if (GetFrameIndex() < SYNC_CHECK_WARMUP_FRAMES || bSwapchainRecreated) {
+			return;
+		}
+		mSyncCheckedFrames++;
+		uint32_t waitIdleCount = mRenderer->GetLastFrameWaitIdleCount();
+		if (waitIdleCount > 0) {
+			LOG_E("Sync check failed: frame {0} waited for device idle {1} times", GetFrameIndex(), waitIdleCount);
+			mSyncFailedFrames++;
+			SetExitCode(EXIT_FAILURE);
+		}
+	}
 
 	/**
 	 * @brief 应用程序销毁阶段，释放所有已创建的资源。
 	 */
 	void OnDestroy() override {
+		if (bCullCheck && !bCullChecked) {
+			LOG_E("Cull check failed: no culling result read back ({0})",
+				mGpuDrivenSystem->IsSupported() ? "run more frames" : "GPU driven material system not supported");
+			SetExitCode(EXIT_FAILURE);
+		}
+		if (bSyncCheck) {
+			if (mSyncCheckedFrames == 0) {
+				LOG_E("Sync check failed: no steady-state frame rendered, run more than {0} frames", SYNC_CHECK_WARMUP_FRAMES);
+				SetExitCode(EXIT_FAILURE);
+			}
+			else if (mSyncFailedFrames == 0) {
+				LOG_I("Sync check passed: {0} steady-state frames without device idle waits", mSyncCheckedFrames);
+			}
+		}
+
 		WuDu::AdRenderContext* renderCxt = WuDu::AdApplication::GetAppContext()->renderCxt;
 		WuDu::AdVKDevice* device = renderCxt->GetDevice();
-		vkDeviceWaitIdle(device->GetHandle());
+		device->WaitIdle();
 
 		// 关键：先清理GUI系统
 
@@ -319,6 +438,13 @@ private:
 
 	std::unique_ptr<WuDu::AdCameraControllerManager> m_CameraController;  ///< 相机控制器管理器
 
+	WuDu::AdGpuDrivenMaterialSystem* mGpuDrivenSystem = nullptr;
+	bool bCullCheck = false;
+	bool bCullChecked = false;
+	bool bSyncCheck = false;
+	uint32_t mSyncCheckedFrames = 0;
+	uint32_t mSyncFailedFrames = 0;
+
 	//材质
 	std::shared_ptr<WuDu::AdTexture> mTexture0;
 	std::shared_ptr<WuDu::AdTexture> mTexture1;
@@ -12,6 +12,7 @@
 #include"Graphic/AdVKImage.h"
 #include"Graphic/AdVKBuffer.h"
 #include"Graphic/AdVKQueue.h"
+#include"Graphic/AdVKUploadContext.h"
 #include"AdGeometryUtil.h"
 #include <glm/gtc/matrix_transform.hpp>
 #include <glm/gtc/constants.hpp>
@@ -206,6 +207,7 @@ int main() {
 		const_cast<void*>(static_cast<const void*>(vertices.data())),
 		false
 	);
+	vkdevice->GetUploadContext()->WaitIdle();
 	WuDu::AdVKQueue* graphicQueue = vkdevice->GetFirstGraphicQueue();
 	const std::vector<VkClearValue> clearValues = {
 		{